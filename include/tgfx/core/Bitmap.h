@@ -184,7 +184,8 @@ class Bitmap {
 
   /**
    * Encodes the pixels in Bitmap into a binary image format.
-   * @param format One of: EncodedFormat::JPEG, EncodedFormat::PNG, EncodedFormat::WEBP
+   * @param format One of: EncodedFormat::JPEG, EncodedFormat::PNG, EncodedFormat::WEBP,
+   * EncodedFormat::KTX2
    * @param quality A platform and format specific metric trading off size and encoding error. When
    * used, quality equaling 100 encodes with the least error. quality may be ignored by the encoder.
    * @return Returns nullptr if encoding fails, or if the format is not supported.
@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace tgfx {
+/**
+ * Defines the filter strategy used by the PNG encoder to prepare each row for compression.
+ */
+enum class PNGFilter {
+  /**
+   * Lets the encoder choose the filter adaptively for every row. Produces the smallest files in
+   * most cases but is the slowest strategy.
+   */
+  Default,
+  /**
+   * Disables filtering. The fastest strategy, well suited for images with few gradients.
+   */
+  None,
+  /**
+   * Uses the difference to the pixel on the left.
+   */
+  Sub,
+  /**
+   * Uses the difference to the pixel above.
+   */
+  Up,
+  /**
+   * Uses the Paeth predictor computed from the left, above, and upper-left pixels.
+   */
+  Paeth
+};
+
+/**
+ * EncodeOptions controls the trade-off between encoding speed and output size when encoding a
+ * Pixmap with ImageCodec::Encode(). Options that do not apply to the requested format are ignored.
+ */
+struct EncodeOptions {
+  /**
+   * The encoding quality in the range [0, 100]. Used by JPEG and WEBP. A WEBP quality of 100
+   * selects lossless encoding.
+   */
+  int quality = 100;
+
+  /**
+   * The libwebp compression method in the range [0, 6]. Lower values encode faster and higher
+   * values produce smaller files. A negative value uses the default method for the quality.
+   */
+  int webpMethod = -1;
+
+  /**
+   * The zlib compression level used by the PNG encoder in the range [0, 9]. Lower values encode
+   * faster and higher values produce smaller files. A negative value uses the zlib default.
+   */
+  int pngCompressionLevel = -1;
+
+  /**
+   * The row filter strategy used by the PNG encoder.
+   */
+  PNGFilter pngFilter = PNGFilter::Default;
+
+  /**
+   * If true, the JPEG encoder uses the fast integer DCT, which is noticeably faster at the cost of
+   * a slight loss of accuracy. The default is false.
+   */
+  bool jpegFastDCT = false;
+};
+}  // namespace tgfx
@@ -21,8 +21,9 @@
 namespace tgfx {
 
 /**
- *  Describes the known formats a Pixmap can be encoded into.
+ *  Describes the known formats a Pixmap can be encoded into. KTX2 stores the pixels as ETC2
+ *  compressed texture blocks, which can be uploaded to the GPU without decoding.
  */
-enum class EncodedFormat { JPEG, PNG, WEBP };
+enum class EncodedFormat { JPEG, PNG, WEBP, KTX2 };
 
 }  // namespace tgfx
@@ -124,14 +124,16 @@ class Image {
 
   /**
    * Creates an Image in the I420 format with the specified YUVData and the YUVColorSpace. Returns
-   * nullptr if the yuvData is invalid.
+   * nullptr if the yuvData is invalid. The planes are uploaded directly from the memory of the
+   * yuvData using its row bytes, and the plane textures of released images with the same size and
+   * format are recycled, so creating an Image for each frame of a video stream is cheap.
    */
   static std::shared_ptr<Image> MakeI420(std::shared_ptr<YUVData> yuvData,
                                          YUVColorSpace colorSpace = YUVColorSpace::BT601_LIMITED);
 
   /**
    * Creates an Image in the NV12 format with the specified YUVData and the YUVColorSpace. Returns
-   * nullptr if the yuvData is invalid.
+   * nullptr if the yuvData is invalid. The plane textures are recycled the same way as MakeI420().
    */
   static std::shared_ptr<Image> MakeNV12(std::shared_ptr<YUVData> yuvData,
                                          YUVColorSpace colorSpace = YUVColorSpace::BT601_LIMITED);
@@ -161,6 +163,21 @@ class Image {
   static std::shared_ptr<Image> MakeAdopted(Context* context, const BackendTexture& backendTexture,
                                             ImageOrigin origin = ImageOrigin::TopLeft);
 
+  /**
+   * Returns the maximum number of bytes of decoded pixels kept in CPU memory for re-uploading
+   * images whose textures have been purged from the GPU cache. The default value is 0, which means
+   * the decoded cache is disabled.
+   */
+  static size_t DecodedCacheLimit();
+
+  /**
+   * Sets the maximum number of bytes of decoded pixels kept in CPU memory. When enabled, the pixels
+   * decoded for an image are retained in a least-recently-used cache shared by all contexts, so
+   * uploading the image again after its texture is purged does not decode the encoded data again.
+   * Setting it to 0 disables the cache and releases all cached pixels.
+   */
+  static void SetDecodedCacheLimit(size_t bytesLimit);
+
   virtual ~Image() = default;
 
   /**
@@ -179,6 +196,14 @@ class Image {
    */
   virtual bool isAlphaOnly() const = 0;
 
+  /**
+   * Returns true if every pixel of the Image is known to be fully opaque. Returns false if the
+   * Image may contain transparent pixels or the opacity is unknown.
+   */
+  virtual bool isOpaque() const {
+    return false;
+  }
+
   /**
    * Returns true if the Image has mipmap levels. The flag was set by the makeMipmapped() method,
    * which may be ignored if the GPU or the associated image source doesn’t support mipmaps.
@@ -106,6 +106,13 @@ class ImageBuffer {
    */
   virtual std::shared_ptr<Texture> onMakeTexture(Context* context, bool mipmapped) const = 0;
 
+  /**
+   * Returns the number of bytes of memory held by the pixels of the ImageBuffer. The default
+   * implementation assumes tightly packed 8-bit alpha or 32-bit color pixels.
+   */
+  virtual size_t onMemoryUsage() const;
+
   friend class Texture;
+  friend class ImageBufferCache;
 };
 }  // namespace tgfx
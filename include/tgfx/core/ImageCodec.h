@@ -18,7 +18,9 @@
 
 #pragma once
 
+#include <vector>
 #include "tgfx/core/Data.h"
+#include "tgfx/core/EncodeOptions.h"
 #include "tgfx/core/EncodedFormat.h"
 #include "tgfx/core/ImageGenerator.h"
 #include "tgfx/core/ImageInfo.h"
@@ -29,6 +31,7 @@
 namespace tgfx {
 
 class ImageBuffer;
+class WriteStream;
 
 /**
  * ImageCodec is an abstract class that defines the interface for decoding images.
@@ -69,6 +72,31 @@ class ImageCodec : public ImageGenerator {
    */
   static std::shared_ptr<Data> Encode(const Pixmap& pixmap, EncodedFormat format, int quality);
 
+  /**
+   * Encodes the specified Pixmap into a binary image format using the given options. Returns
+   * nullptr if encoding fails.
+   */
+  static std::shared_ptr<Data> Encode(const Pixmap& pixmap, EncodedFormat format,
+                                      const EncodeOptions& options);
+
+  /**
+   * Encodes the specified Pixmap into a binary image format using the given options and writes the
+   * encoded bytes to the stream as they are produced, without holding the whole output in memory.
+   * Returns false if encoding fails, in which case the stream may have received partial output.
+   */
+  static bool Encode(const Pixmap& pixmap, EncodedFormat format, const EncodeOptions& options,
+                     WriteStream* stream);
+
+  /**
+   * Encodes a batch of Pixmaps concurrently on background threads, all using the same format and
+   * options. Blocks until every Pixmap is encoded and returns the results in the same order as the
+   * input. Entries that fail to encode are nullptr. The pixels of every Pixmap must remain valid
+   * until this method returns.
+   */
+  static std::vector<std::shared_ptr<Data>> Encode(const std::vector<Pixmap>& pixmaps,
+                                                   EncodedFormat format,
+                                                   const EncodeOptions& options);
+
   /**
    * Returns the orientation of the target image.
    */
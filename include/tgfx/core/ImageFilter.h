@@ -27,6 +27,8 @@
 
 namespace tgfx {
 class TextureProxy;
+class BytesKey;
+class UniqueKey;
 enum class SrcRectConstraint;
 
 /**
@@ -150,6 +152,30 @@ class ImageFilter {
                                                          const Rect& clipBounds,
                                                          const TPArgs& args) const;
 
+  /**
+   * Writes the parameters that determine the output of this filter into the key. Returns false if
+   * the output can't be cached, in which case the filter is applied every time it is drawn.
+   */
+  virtual bool onComputeCacheKey(BytesKey* key) const;
+
+  /**
+   * Returns the key for caching the output of this filter applied to the source image within the
+   * clip bounds. Returns an empty key if the source image has no UniqueKey or the output of this
+   * filter can't be cached.
+   */
+  UniqueKey getCacheKey(const Image* source, const Rect& clipBounds, bool mipmapped) const;
+
+  /**
+   * Returns a texture proxy that applies this filter to the source image, reusing the result kept
+   * in the ResourceCache under the cache key if there is one. The result is only cached once the
+   * same key has been drawn before, so outputs of animated filters that change every frame don't
+   * churn the cache. The cached result stays alive for as long as the source image does, unless it
+   * is purged by the ResourceCache.
+   */
+  std::shared_ptr<TextureProxy> lockCachedTextureProxy(std::shared_ptr<Image> source,
+                                                       const Rect& clipBounds, const TPArgs& args,
+                                                       const UniqueKey& cacheKey) const;
+
   /**
    * Returns a FragmentProcessor that applies this filter to the source image. The returned
    * processor is in the coordinate space of the source image.
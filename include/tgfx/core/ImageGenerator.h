@@ -49,6 +49,13 @@ class ImageGenerator {
    */
   virtual bool isAlphaOnly() const = 0;
 
+  /**
+   * Returns true if the generator is guaranteed to produce fully opaque pixels only.
+   */
+  virtual bool isOpaque() const {
+    return false;
+  }
+
   /**
    * Returns true if the ImageGenerator supports asynchronous decoding. If so, the makeBuffer()
    * method can be called from an arbitrary thread. Otherwise, the makeBuffer() method must be
@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/ImageInfo.h"
+
+namespace tgfx {
+class ReadbackBuffer;
+
+/**
+ * PixelReadback represents a pending asynchronous copy of Surface pixels to the CPU, created by
+ * Surface::readPixelsAsync(). The GPU transfers the pixels in the background while the caller keeps
+ * rendering, and the pixels can be read once isReady() returns true. All methods of PixelReadback
+ * must be called while the associated Context is locked.
+ */
+class PixelReadback {
+ public:
+  /**
+   * Returns the ImageInfo describing the captured pixels. Its color type matches the color type of
+   * the Surface it was created from.
+   */
+  const ImageInfo& info() const {
+    return _info;
+  }
+
+  /**
+   * Returns the width of the captured pixels.
+   */
+  int width() const {
+    return _info.width();
+  }
+
+  /**
+   * Returns the height of the captured pixels.
+   */
+  int height() const {
+    return _info.height();
+  }
+
+  /**
+   * Returns true if the GPU has finished transferring the pixels, in which case readPixels() will
+   * not block. This method never blocks.
+   */
+  bool isReady();
+
+  /**
+   * Copies a rect of the captured pixels to dstPixels with specified ImageInfo. Copy starts at
+   * (srcX, srcY), and does not exceed (width(), height()). Blocks the calling thread until the GPU
+   * finishes the transfer if isReady() returns false. Pixels are copied only if pixel conversion is
+   * possible. Returns true if pixels are copied to dstPixels.
+   */
+  bool readPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX = 0, int srcY = 0);
+
+ private:
+  ImageInfo _info = {};
+  bool flipY = false;
+  std::shared_ptr<ReadbackBuffer> buffer = nullptr;
+  Buffer pixels = {};
+
+  PixelReadback(std::shared_ptr<ReadbackBuffer> buffer, const ImageInfo& info, bool flipY);
+
+  bool isPending() const {
+    return buffer != nullptr;
+  }
+
+  bool resolve();
+
+  friend class Surface;
+};
+}  // namespace tgfx
@@ -23,7 +23,8 @@
 namespace tgfx {
 /**
  * Defines flags that can be passed to the rendering process. The tgfx runtime can interpret these
- * to optimize performance, such as by disabling certain expensive features.
+ * to optimize performance, such as by disabling certain expensive features, or to change how
+ * colors are blended.
  */
 class RenderFlags {
  public:
@@ -37,5 +38,15 @@ class RenderFlags {
    * asynchronously.
    */
   static constexpr uint32_t DisableAsyncTask = 1 << 1;
+
+  /**
+   * Blends in a linear-light working space instead of the sRGB-encoded space. Colors of each draw
+   * are linearized before blending, and the surface content is sRGB-encoded again when it is read
+   * back into a pixel format other than ColorType::RGBA_F16. This flag only takes effect on
+   * surfaces created with ColorType::RGBA_F16, since 8-bit channels don't have enough precision to
+   * store linear values without banding. Such surfaces can't make image snapshots, since images
+   * are expected to hold sRGB-encoded values.
+   */
+  static constexpr uint32_t LinearColorSpace = 1 << 2;
 };
 }  // namespace tgfx
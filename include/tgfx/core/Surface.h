@@ -18,8 +18,10 @@
 
 #pragma once
 
+#include <deque>
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/ImageInfo.h"
+#include "tgfx/core/PixelReadback.h"
 #include "tgfx/core/RenderFlags.h"
 #include "tgfx/gpu/Backend.h"
 #include "tgfx/gpu/ImageOrigin.h"
@@ -151,7 +153,8 @@ class Surface {
    * Returns an Image capturing the Surface contents. Subsequent drawings to the Surface contents
    * are not captured. This method would trigger immediate texture copying if the Surface has no
    * backing texture or the backing texture was allocated externally. For example, the Surface was
-   * created from a BackendRenderTarget, a BackendTexture or a HardwareBuffer.
+   * created from a BackendRenderTarget, a BackendTexture or a HardwareBuffer. Returns nullptr if
+   * the Surface stores linear-light values, see RenderFlags::LinearColorSpace.
    */
   std::shared_ptr<Image> makeImageSnapshot();
 
@@ -172,11 +175,24 @@ class Surface {
    */
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX = 0, int srcY = 0);
 
+  /**
+   * Starts an asynchronous copy of a rect of pixels, clipped to the Surface bounds, and returns
+   * immediately without waiting for the GPU. Unlike readPixels(), the calling thread is not blocked
+   * and can keep rendering new frames while the pixels are being transferred. Use the returned
+   * PixelReadback to check the transfer state and read the pixels later. At most a few readbacks
+   * are kept in flight per Surface, starting a new one when the limit is reached forces the oldest
+   * pending readback to complete first. Returns nullptr if the rect does not intersect the Surface
+   * or the GPU backend does not support asynchronous readbacks, in which case readPixels() should
+   * be used instead.
+   */
+  std::shared_ptr<PixelReadback> readPixelsAsync(int srcX, int srcY, int width, int height);
+
  private:
   uint32_t _uniqueID = 0;
   RenderContext* renderContext = nullptr;
   Canvas* canvas = nullptr;
   std::shared_ptr<Image> cachedImage = nullptr;
+  std::deque<std::weak_ptr<PixelReadback>> pendingReadbacks = {};
 
   static std::shared_ptr<Surface> MakeFrom(std::shared_ptr<RenderTargetProxy> renderTargetProxy,
                                            uint32_t renderFlags = 0, bool clearAll = false);
@@ -34,6 +34,11 @@ class Caps {
 
   virtual bool isFormatRenderable(PixelFormat pixelFormat) const = 0;
 
+  /**
+   * Returns true if textures can be created directly from data in the given compressed format.
+   */
+  virtual bool isCompressedFormatSupported(PixelFormat pixelFormat) const = 0;
+
   virtual int getSampleCount(int requestedCount, PixelFormat pixelFormat) const = 0;
 
   virtual int getMaxMipmapLevel(int width, int height) const = 0;
@@ -51,6 +51,37 @@ enum class PixelFormat {
   /**
    * Pixel with 8 bits for blue, green, red, alpha. Each pixel is stored on 4 bytes.
    */
-  BGRA_8888
+  BGRA_8888,
+
+  /**
+   * ETC2 compressed RGB. Each 4x4 block of pixels is stored on 8 bytes.
+   */
+  ETC2_RGB8,
+
+  /**
+   * ETC2 compressed RGB with EAC compressed alpha. Each 4x4 block of pixels is stored on 16 bytes.
+   */
+  ETC2_RGBA8,
+
+  /**
+   * ASTC compressed RGBA with a 4x4 block footprint. Each block is stored on 16 bytes.
+   */
+  ASTC_4x4,
+
+  /**
+   * BC1 (also known as DXT1) compressed RGBA with 1-bit alpha. Each 4x4 block of pixels is stored
+   * on 8 bytes.
+   */
+  BC1_RGBA,
+
+  /**
+   * BC3 (also known as DXT5) compressed RGBA. Each 4x4 block of pixels is stored on 16 bytes.
+   */
+  BC3_RGBA,
+
+  /**
+   * Pixel with a half float for red, green, blue, alpha. Each pixel is stored on 8 bytes.
+   */
+  RGBA_16F
 };
 }  // namespace tgfx
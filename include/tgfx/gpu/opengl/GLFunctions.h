@@ -56,6 +56,7 @@ using GLBufferData = void GL_FUNCTION_TYPE(unsigned target, GLsizeiptr size, con
 using GLBufferSubData = void GL_FUNCTION_TYPE(unsigned target, GLintptr offset, GLsizeiptr size,
                                               const void* data);
 using GLCheckFramebufferStatus = unsigned GL_FUNCTION_TYPE(unsigned target);
+using GLClientWaitSync = unsigned GL_FUNCTION_TYPE(void* sync, unsigned flags, uint64_t timeout);
 using GLClear = void GL_FUNCTION_TYPE(unsigned mask);
 using GLClearColor = void GL_FUNCTION_TYPE(float red, float green, float blue, float alpha);
 using GLClearDepthf = void GL_FUNCTION_TYPE(float depth);
@@ -144,6 +145,8 @@ using GLGetUniformLocation = int GL_FUNCTION_TYPE(unsigned program, const char*
 using GLIsTexture = unsigned char GL_FUNCTION_TYPE(unsigned texture);
 using GLLineWidth = void GL_FUNCTION_TYPE(float width);
 using GLLinkProgram = void GL_FUNCTION_TYPE(unsigned program);
+using GLMapBufferRange = void* GL_FUNCTION_TYPE(unsigned target, GLintptr offset,
+                                               GLsizeiptr length, unsigned access);
 using GLPixelStorei = void GL_FUNCTION_TYPE(unsigned pname, int param);
 using GLReadPixels = void GL_FUNCTION_TYPE(int x, int y, int width, int height, unsigned format,
                                            unsigned type, void* pixels);
@@ -207,6 +210,7 @@ using GLUniformMatrix3fv = void GL_FUNCTION_TYPE(int location, int count, unsign
                                                  const float* value);
 using GLUniformMatrix4fv = void GL_FUNCTION_TYPE(int location, int count, unsigned char transpose,
                                                  const float* value);
+using GLUnmapBuffer = unsigned char GL_FUNCTION_TYPE(unsigned target);
 using GLUseProgram = void GL_FUNCTION_TYPE(unsigned program);
 using GLVertexAttrib1f = void GL_FUNCTION_TYPE(unsigned indx, float value);
 using GLVertexAttrib2fv = void GL_FUNCTION_TYPE(unsigned indx, const float* values);
@@ -246,6 +250,7 @@ class GLFunctions {
   GLBufferData* bufferData = nullptr;
   GLBufferSubData* bufferSubData = nullptr;
   GLCheckFramebufferStatus* checkFramebufferStatus = nullptr;
+  GLClientWaitSync* clientWaitSync = nullptr;
   GLClear* clear = nullptr;
   GLClearColor* clearColor = nullptr;
   GLClearDepthf* clearDepthf = nullptr;
@@ -309,6 +314,7 @@ class GLFunctions {
   GLIsTexture* isTexture = nullptr;
   GLLineWidth* lineWidth = nullptr;
   GLLinkProgram* linkProgram = nullptr;
+  GLMapBufferRange* mapBufferRange = nullptr;
   GLPixelStorei* pixelStorei = nullptr;
   GLReadPixels* readPixels = nullptr;
   GLRenderbufferStorage* renderbufferStorage = nullptr;
@@ -351,6 +357,7 @@ class GLFunctions {
   GLUniformMatrix2fv* uniformMatrix2fv = nullptr;
   GLUniformMatrix3fv* uniformMatrix3fv = nullptr;
   GLUniformMatrix4fv* uniformMatrix4fv = nullptr;
+  GLUnmapBuffer* unmapBuffer = nullptr;
   GLUseProgram* useProgram = nullptr;
   GLVertexAttrib1f* vertexAttrib1f = nullptr;
   GLVertexAttrib2fv* vertexAttrib2fv = nullptr;
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <deque>
 #include <unordered_map>
 #include "tgfx/core/Surface.h"
@@ -183,6 +184,20 @@ class DisplayList {
    */
   void setMaxTileCount(int count);
 
+  /**
+   * Returns the maximum number of separate dirty regions tracked between two frames in partial and
+   * tiled rendering modes. When more areas change, the two regions whose union adds the least area
+   * are merged. Higher values keep scattered small changes from growing into large repaints, at
+   * the cost of more bookkeeping per change and more draw passes per frame. The default is 3.
+   */
+  int maxDirtyRegions() const;
+
+  /**
+   * Sets the maximum number of separate dirty regions tracked between two frames. The value is
+   * clamped to [1, 64].
+   */
+  void setMaxDirtyRegions(int count);
+
   /**
    * Returns true if zoom blur is allowed in tiled rendering mode. This setting is ignored in other
    * render modes. When enabled, if the zoomScale changes and cached images at other zoom levels are
@@ -221,6 +236,82 @@ class DisplayList {
     _maxTilesRefinedPerFrame = count;
   }
 
+  /**
+   * Returns true if tiles in tiled rendering mode may be recorded in parallel. This setting is
+   * ignored in other render modes. When enabled and more than one tile needs to be redrawn in a
+   * frame, the layer tree is recorded into a separate Picture for each tile on background threads,
+   * and only the playback of those pictures into the tile surfaces happens on the render thread.
+   * This mostly helps when many tiles are refined at once after zooming. Frames that contain
+   * background styles are still drawn sequentially, and rasterized layer caches are bypassed while
+   * recording in parallel, since both need the GPU context. The default is false.
+   */
+  bool allowParallelRecording() const {
+    return _allowParallelRecording;
+  }
+
+  /**
+   * Sets whether tiles in tiled rendering mode may be recorded in parallel.
+   */
+  void setAllowParallelRecording(bool allow) {
+    _allowParallelRecording = allow;
+  }
+
+  /**
+   * Returns true if the contents of dirty layers may be updated in parallel. When enabled and many
+   * visible layers have dirty contents in a frame, their Layer::onUpdateContent() methods are
+   * called on background threads before the frame is drawn. Only enable this if every layer
+   * subclass in the tree updates its contents without modifying other layers or any state shared
+   * between layers. The default is false, which updates all contents on the calling thread.
+   */
+  bool allowParallelContentUpdate() const {
+    return _allowParallelContentUpdate;
+  }
+
+  /**
+   * Sets whether the contents of dirty layers may be updated in parallel.
+   */
+  void setAllowParallelContentUpdate(bool allow) {
+    _allowParallelContentUpdate = allow;
+  }
+
+  /**
+   * Returns the number of tiles beyond the visible area that are rendered ahead of time in tiled
+   * rendering mode. This setting is ignored in other render modes. While the content offset is
+   * changing, tiles are prefetched only on the side the viewport is moving towards. Once it stops,
+   * the remaining tiles around the viewport are filled in over the following frames. Prefetching
+   * is paused while the zoom scale changes, and prefetched tiles share the budget set by
+   * setMaxTileCount(), so raise that limit as well to keep them. The default is 0, which disables
+   * prefetching.
+   */
+  int prefetchMargin() const {
+    return _prefetchMargin;
+  }
+
+  /**
+   * Sets the number of tiles beyond the visible area that are rendered ahead of time in tiled
+   * rendering mode.
+   */
+  void setPrefetchMargin(int margin) {
+    _prefetchMargin = margin;
+  }
+
+  /**
+   * Returns the maximum number of tiles that can be prefetched per frame in tiled rendering mode.
+   * Tiles redrawn for the visible area in the same frame are subtracted from this budget, so
+   * prefetching mostly uses frames that have little else to do. The default is 4.
+   */
+  int maxTilesPrefetchedPerFrame() const {
+    return _maxTilesPrefetchedPerFrame;
+  }
+
+  /**
+   * Sets the maximum number of tiles that can be prefetched per frame in tiled rendering mode.
+   * Negative values are treated as 0, which disables prefetching.
+   */
+  void setMaxTilesPrefetchedPerFrame(int count) {
+    _maxTilesPrefetchedPerFrame = std::max(count, 0);
+  }
+
   /**
    * Sets whether to show dirty regions during rendering. When enabled, the dirty regions will be
    * highlighted in the rendered output. This is useful for debugging to visualize which parts of
@@ -252,9 +343,16 @@ class DisplayList {
   int _maxTileCount = 0;
   bool _allowZoomBlur = false;
   int _maxTilesRefinedPerFrame = 5;
+  bool _allowParallelRecording = false;
+  bool _allowParallelContentUpdate = false;
+  int _prefetchMargin = 0;
+  int _maxTilesPrefetchedPerFrame = 4;
   bool _showDirtyRegions = false;
   bool _hasContentChanged = false;
   bool hasZoomBlurTiles = false;
+  bool hasPrefetchTiles = false;
+  bool isZooming = false;
+  Point contentVelocity = {};
   int64_t lastZoomScaleInt = 1000;
   Point lastContentOffset = {};
   int totalTileCount = 0;
@@ -262,6 +360,8 @@ class DisplayList {
   std::unordered_map<int64_t, TileCache*> tileCaches = {};
   std::vector<std::shared_ptr<Tile>> emptyTiles = {};
   std::deque<std::vector<Rect>> lastDirtyRegions = {};
+  mutable std::vector<Rect> scaledCacheBounds = {};
+  uint32_t renderFrame = 0;
 
   std::vector<Rect> renderDirect(Surface* surface, bool autoClear) const;
 
@@ -281,6 +381,12 @@ class DisplayList {
   std::vector<DrawTask> collectScreenTasks(const Surface* surface,
                                            std::vector<DrawTask>* tileTasks);
 
+  void collectPrefetchTasks(const Surface* surface, std::vector<DrawTask>* tileTasks);
+
+  std::vector<std::shared_ptr<Tile>> getPrefetchTiles(const Surface* surface, size_t tileCount,
+                                                      TileCache* tileCache, int startX, int startY,
+                                                      int endX, int endY);
+
   std::vector<std::pair<float, TileCache*>> getSortedTileCaches() const;
 
   std::vector<DrawTask> getFallbackDrawTasks(
@@ -299,8 +405,14 @@ class DisplayList {
 
   int getMaxTileCountPerAtlas(Context* context) const;
 
+  Matrix getTileMatrix(const DrawTask& task, Rect* clipRect) const;
+
   void drawTileTask(const DrawTask& task) const;
 
+  bool drawTileTasksInParallel(const std::vector<DrawTask>& tileTasks) const;
+
+  std::shared_ptr<Picture> recordTileTask(const DrawTask& task) const;
+
   void drawScreenTasks(std::vector<DrawTask> screenTasks, Surface* surface, bool autoClear) const;
 
   void renderDirtyRegions(Canvas* canvas, std::vector<Rect> dirtyRegions);
@@ -311,5 +423,8 @@ class DisplayList {
 
   void drawRootLayer(Surface* surface, const Rect& drawRect, const Matrix& viewMatrix,
                      bool autoClear) const;
+
+  void drawRootLayer(Canvas* canvas, Context* context, const Rect& drawRect,
+                     const Matrix& viewMatrix) const;
 };
 }  // namespace tgfx
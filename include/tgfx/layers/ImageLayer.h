@@ -67,6 +67,8 @@ class ImageLayer : public Layer {
 
   void onUpdateContent(LayerRecorder* recorder) override;
 
+  Rect getOpaqueBounds() const override;
+
  private:
   SamplingOptions _sampling;
   std::shared_ptr<Image> _image = nullptr;
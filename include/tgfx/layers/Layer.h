@@ -19,6 +19,8 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <unordered_set>
 #include "tgfx/core/BlendMode.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/Matrix.h"
@@ -36,6 +38,7 @@ class DrawArgs;
 class RegionTransformer;
 class RootLayer;
 struct LayerStyleSource;
+struct LayerSourceCache;
 
 /**
  * The base class for all layers that can be placed on the display list. The layer class includes
@@ -512,11 +515,21 @@ class Layer : public std::enable_shared_from_this<Layer> {
   /**
    * Called when the layer’s contents needs to be updated. Subclasses should override this method to
    * update the layer’s contents, typically by drawing on a canvas obtained from the given
-   * LayerRecorder.
+   * LayerRecorder. If DisplayList::setAllowParallelContentUpdate() is enabled, this method may be
+   * called on a background thread, in which case it must not modify other layers or any state
+   * shared between layers.
    * @param recorder The LayerRecorder used to record the layer's contents.
    */
   virtual void onUpdateContent(LayerRecorder* recorder);
 
+  /**
+   * Returns the area of the layer's own content, in the layer's local coordinate space, that is
+   * drawn fully opaque. Layers underneath this area may be skipped during rendering, so the result
+   * must never include any pixel that is translucent or left untouched. The default
+   * implementation returns an empty rectangle.
+   */
+  virtual Rect getOpaqueBounds() const;
+
   /**
    * Attaches a property to this layer.
    */
@@ -551,16 +564,29 @@ class Layer : public std::enable_shared_from_this<Layer> {
 
   bool doContains(const Layer* child) const;
 
-  Matrix getGlobalMatrix() const;
+  const Matrix& getGlobalMatrix() const;
+
+  const Matrix* getGlobalInverseMatrix() const;
+
+  void invalidateGlobalMatrix();
 
   Matrix getMatrixWithScrollRect() const;
 
   LayerContent* getContent();
 
+  void collectDirtyContents(std::vector<Layer*>* layers);
+
   std::shared_ptr<ImageFilter> getImageFilter(float contentScale);
 
   RasterizedContent* getRasterizedCache(const DrawArgs& args, const Matrix& renderMatrix);
 
+  RasterizedContent* getScaledRasterizedCache(const DrawArgs& args, float contentScale);
+
+  std::unique_ptr<RasterizedContent> makeRasterizedContent(const DrawArgs& args,
+                                                           float contentScale);
+
+  void clearCachedContents();
+
   std::shared_ptr<Image> getRasterizedImage(const DrawArgs& args, float contentScale,
                                             Matrix* drawingMatrix);
 
@@ -579,7 +605,7 @@ class Layer : public std::enable_shared_from_this<Layer> {
 
   float drawBackgroundLayers(const DrawArgs& args, Canvas* canvas);
 
-  std::unique_ptr<LayerStyleSource> getLayerStyleSource(const DrawArgs& args, const Matrix& matrix);
+  std::shared_ptr<LayerStyleSource> getLayerStyleSource(const DrawArgs& args, const Matrix& matrix);
 
   std::shared_ptr<Image> getBackgroundImage(const DrawArgs& args, float contentScale,
                                             Point* offset);
@@ -587,7 +613,13 @@ class Layer : public std::enable_shared_from_this<Layer> {
   void drawLayerStyles(const DrawArgs& args, Canvas* canvas, float alpha,
                        const LayerStyleSource* source, LayerStylePosition position);
 
-  bool getLayersUnderPointInternal(float x, float y, std::vector<std::shared_ptr<Layer>>* results);
+  std::optional<std::unordered_set<const Layer*>> getCandidateLayers(float x, float y) const;
+
+  bool getLayersUnderPointInternal(float x, float y, std::vector<std::shared_ptr<Layer>>* results,
+                                   const std::unordered_set<const Layer*>* candidates);
+
+  bool hitTestPointInternal(float x, float y, bool shapeHitTest,
+                            const std::unordered_set<const Layer*>* candidates);
 
   std::shared_ptr<MaskFilter> getMaskFilter(const DrawArgs& args, float scale);
 
@@ -595,6 +627,12 @@ class Layer : public std::enable_shared_from_this<Layer> {
 
   bool hasValidMask() const;
 
+  /**
+   * Computes the global matrices that drawing the masks in this subtree reads, so the subtree can
+   * then be recorded on several threads without writing the cached matrices concurrently.
+   */
+  void prepareMaskMatrices();
+
   void updateRenderBounds(const Matrix& renderMatrix = {},
                           std::shared_ptr<RegionTransformer> transformer = nullptr,
                           bool forceDirty = false);
@@ -633,9 +671,31 @@ class Layer : public std::enable_shared_from_this<Layer> {
   std::vector<std::shared_ptr<LayerStyle>> _layerStyles = {};
   float _rasterizationScale = 0.0f;
   std::unique_ptr<RasterizedContent> rasterizedContent;
+  // Versions rasterized at powers of √2, drawn while the content scale is still changing.
+  std::vector<std::unique_ptr<RasterizedContent>> scaledRasterizedContents;
+  // The rasterized content scale of the current and the previous frame. Only the first draw of a
+  // frame updates them, since a layer may be drawn once per tile or dirty rect.
+  float lastRasterizedScale = 0.0f;
+  float previousRasterizedScale = 0.0f;
+  uint32_t rasterizedFrame = 0;
+  bool scaledCacheBoundsAdded = false;
+  std::unique_ptr<LayerSourceCache> sourceCache;
   std::shared_ptr<LayerContent> layerContent = nullptr;
   Rect renderBounds = {};         // in global coordinates
   Rect* contentBounds = nullptr;  //  in global coordinates
+  int spatialLeafID = -1;         // the leaf of the content bounds in the root's spatial tree
+  // The layer drawn above that fully covers this layer, valid only if occlusionFrame matches the
+  // frame of the root's last occlusion pass. Used for comparison only, never dereferenced.
+  const Layer* occluder = nullptr;
+  uint32_t occlusionFrame = 0;
+
+  // The cached global matrix and its inverse. They are invalidated together with the caches of all
+  // descendants whenever the layer is transformed or moved to another parent.
+  mutable Matrix globalMatrix = {};
+  mutable Matrix globalInverseMatrix = {};
+  mutable bool globalMatrixValid = false;
+  mutable bool globalInverseValid = false;
+  mutable bool globalInvertible = false;
 
   // if > 0, means the layer or any of its descendants has a background style
   float backgroundOutset = 0.f;
@@ -303,6 +303,9 @@ class ShapeLayer : public Layer {
   void onUpdateContent(LayerRecorder* recorder) override;
 
  private:
+  // The stages of the stroke shape, in the order they are applied.
+  enum class StrokeStage { Trim, Dash, Stroke };
+
   std::shared_ptr<Shape> _shape = nullptr;
   std::vector<std::shared_ptr<ShapeStyle>> _fillStyles = {};
   std::vector<std::shared_ptr<ShapeStyle>> _strokeStyles = {};
@@ -316,10 +319,17 @@ class ShapeLayer : public Layer {
     bool lineDashAdaptive : 1;
     uint8_t strokeAlign : 2;
   } shapeBitFields = {};
+  // The intermediate stroke shapes are kept across content updates, so that changing only the
+  // paints or a later stage keeps the unique keys, and therefore the GPU caches, of earlier ones.
+  std::shared_ptr<Shape> trimmedShape = nullptr;
+  std::shared_ptr<Shape> dashedShape = nullptr;
+  std::shared_ptr<Shape> strokedShape = nullptr;
 
   std::vector<Paint> createShapePaints(
       const std::vector<std::shared_ptr<ShapeStyle>>& styles) const;
 
-  std::shared_ptr<Shape> createStrokeShape() const;
+  std::shared_ptr<Shape> getStrokeShape();
+
+  void resetStrokeShapes(StrokeStage stage);
 };
 }  // namespace tgfx
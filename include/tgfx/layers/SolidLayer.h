@@ -102,6 +102,8 @@ class SolidLayer : public Layer {
 
   void onUpdateContent(LayerRecorder* recorder) override;
 
+  Rect getOpaqueBounds() const override;
+
  private:
   Color _color = {};
   float _width = 0;
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <mutex>
 #include "tgfx/core/ImageFilter.h"
 #include "tgfx/layers/LayerProperty.h"
 
@@ -77,6 +78,7 @@ class LayerFilter : public LayerProperty {
   float lastScale = 1.0f;
   std::unique_ptr<Rect> _clipBounds = nullptr;
   std::shared_ptr<ImageFilter> lastFilter;
+  std::mutex locker = {};
 
   friend class Types;
 };
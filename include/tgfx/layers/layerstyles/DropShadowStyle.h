@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <mutex>
 #include "tgfx/layers/layerstyles/LayerStyle.h"
 
 namespace tgfx {
@@ -145,6 +146,7 @@ class DropShadowStyle : public LayerStyle {
 
   float currentScale = 1.0f;
   std::shared_ptr<ImageFilter> shadowFilter = nullptr;
+  std::mutex locker = {};
 
   friend class Layer;
 };
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <mutex>
 #include "tgfx/layers/layerstyles/LayerStyle.h"
 
 namespace tgfx {
@@ -120,6 +121,7 @@ class InnerShadowStyle : public LayerStyle {
   float _blurrinessY = 0.0f;
   Color _color = Color::Black();
   std::shared_ptr<ImageFilter> shadowFilter = nullptr;
+  std::mutex locker = {};
   float currentScale = 0.0f;
 };
 }  // namespace tgfx
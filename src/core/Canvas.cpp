@@ -175,7 +175,19 @@ void Canvas::clipRect(const tgfx::Rect& rect) {
 void Canvas::clipPath(const Path& path) {
   auto clipPath = path;
   clipPath.transform(mcState->matrix);
-  mcState->clip.addPath(clipPath, PathOp::Intersect);
+  auto& clip = mcState->clip;
+  // Keep the new clip as it is when the current one contains it, so shapes like rounded rects stay
+  // recognizable and can be applied analytically instead of through a mask.
+  if (!clipPath.isInverseFillType()) {
+    Rect clipRect = {};
+    auto isWideOpen = clip.isInverseFillType() && clip.isEmpty();
+    if (isWideOpen || (!clip.isInverseFillType() && clip.isRect(&clipRect) &&
+                       clipRect.contains(clipPath.getBounds()))) {
+      clip = clipPath;
+      return;
+    }
+  }
+  clip.addPath(clipPath, PathOp::Intersect);
 }
 
 void Canvas::resetStateStack() {
@@ -50,6 +50,16 @@ class YUVBuffer : public ImageBuffer {
     return YUVTexture::MakeI420(context, data.get(), colorSpace);
   }
 
+  size_t onMemoryUsage() const override {
+    size_t bytes = 0;
+    auto chromaHeight = static_cast<size_t>((data->height() + 1) / 2);
+    for (size_t i = 0; i < data->planeCount(); i++) {
+      auto planeHeight = i == 0 ? static_cast<size_t>(data->height()) : chromaHeight;
+      bytes += data->getRowBytesAt(i) * planeHeight;
+    }
+    return bytes;
+  }
+
  private:
   std::shared_ptr<YUVData> data = nullptr;
   YUVColorSpace colorSpace = YUVColorSpace::BT601_LIMITED;
@@ -71,4 +81,9 @@ std::shared_ptr<ImageBuffer> ImageBuffer::MakeNV12(std::shared_ptr<YUVData> yuvD
   }
   return std::make_shared<YUVBuffer>(std::move(yuvData), YUVFormat::NV12, colorSpace);
 }
+
+size_t ImageBuffer::onMemoryUsage() const {
+  size_t bytesPerPixel = isAlphaOnly() ? 1 : 4;
+  return static_cast<size_t>(width()) * static_cast<size_t>(height()) * bytesPerPixel;
+}
 }  // namespace tgfx
@@ -0,0 +1,159 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ImageBufferCache.h"
+
+namespace tgfx {
+/**
+ * CachedImageSource forwards the decoded ImageBuffer of another DataSource and adds it to the
+ * ImageBufferCache along the way.
+ */
+class CachedImageSource : public DataSource<ImageBuffer> {
+ public:
+  // Holds only the cache key rather than the UniqueKey itself, so the pending upload does not count
+  // as an external reference to the image's GPU resources.
+  CachedImageSource(uint64_t cacheKey, std::shared_ptr<DataSource<ImageBuffer>> source)
+      : cacheKey(cacheKey), source(std::move(source)) {
+  }
+
+  std::shared_ptr<ImageBuffer> getData() const override {
+    auto buffer = source->getData();
+    ImageBufferCache::GetInstance()->addBuffer(cacheKey, buffer);
+    return buffer;
+  }
+
+ private:
+  uint64_t cacheKey = 0;
+  std::shared_ptr<DataSource<ImageBuffer>> source = nullptr;
+};
+
+static uint64_t MakeCacheKey(uint32_t domainID, bool mipmapped) {
+  return static_cast<uint64_t>(domainID) << 1 | (mipmapped ? 1u : 0u);
+}
+
+ImageBufferCache* ImageBufferCache::GetInstance() {
+  static auto& cache = *new ImageBufferCache();
+  return &cache;
+}
+
+size_t ImageBufferCache::cacheLimit() const {
+  return bytesLimit.load(std::memory_order_relaxed);
+}
+
+void ImageBufferCache::setCacheLimit(size_t limit) {
+  std::vector<std::shared_ptr<ImageBuffer>> removedBuffers = {};
+  std::lock_guard<std::mutex> autoLock(locker);
+  bytesLimit.store(limit, std::memory_order_relaxed);
+  purgeUntilMemoryTo(limit, &removedBuffers);
+}
+
+size_t ImageBufferCache::getCacheBytes() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return totalBytes;
+}
+
+std::shared_ptr<ImageBuffer> ImageBufferCache::find(const UniqueKey& uniqueKey, bool mipmapped) {
+  if (uniqueKey.empty()) {
+    return nullptr;
+  }
+  std::vector<std::shared_ptr<ImageBuffer>> removedBuffers = {};
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto result = entryMap.find(MakeCacheKey(uniqueKey.domainID(), mipmapped));
+  if (result == entryMap.end()) {
+    return nullptr;
+  }
+  auto position = result->second;
+  if (position->buffer->expired()) {
+    removeEntry(position, &removedBuffers);
+    return nullptr;
+  }
+  entries.splice(entries.begin(), entries, position);
+  return position->buffer;
+}
+
+void ImageBufferCache::add(const UniqueKey& uniqueKey, bool mipmapped,
+                           std::shared_ptr<ImageBuffer> buffer) {
+  if (uniqueKey.empty()) {
+    return;
+  }
+  addBuffer(MakeCacheKey(uniqueKey.domainID(), mipmapped), std::move(buffer));
+}
+
+void ImageBufferCache::addBuffer(uint64_t key, std::shared_ptr<ImageBuffer> buffer) {
+  if (buffer == nullptr || buffer->expired()) {
+    return;
+  }
+  auto bytes = buffer->onMemoryUsage();
+  std::vector<std::shared_ptr<ImageBuffer>> removedBuffers = {};
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto limit = bytesLimit.load(std::memory_order_relaxed);
+  if (bytes > limit) {
+    return;
+  }
+  auto result = entryMap.find(key);
+  if (result != entryMap.end()) {
+    if (result->second->buffer == buffer) {
+      entries.splice(entries.begin(), entries, result->second);
+      return;
+    }
+    removeEntry(result->second, &removedBuffers);
+  }
+  purgeUntilMemoryTo(limit - bytes, &removedBuffers);
+  entries.push_front({key, bytes, std::move(buffer)});
+  entryMap[key] = entries.begin();
+  totalBytes += bytes;
+}
+
+std::shared_ptr<DataSource<ImageBuffer>> ImageBufferCache::wrap(
+    const UniqueKey& uniqueKey, bool mipmapped, std::shared_ptr<DataSource<ImageBuffer>> source) {
+  if (source == nullptr || uniqueKey.empty() || cacheLimit() == 0) {
+    return source;
+  }
+  return std::make_shared<CachedImageSource>(MakeCacheKey(uniqueKey.domainID(), mipmapped),
+                                             std::move(source));
+}
+
+void ImageBufferCache::remove(uint32_t domainID) {
+  std::vector<std::shared_ptr<ImageBuffer>> removedBuffers = {};
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (entries.empty()) {
+    return;
+  }
+  for (auto mipmapped : {false, true}) {
+    auto result = entryMap.find(MakeCacheKey(domainID, mipmapped));
+    if (result != entryMap.end()) {
+      removeEntry(result->second, &removedBuffers);
+    }
+  }
+}
+
+void ImageBufferCache::removeEntry(std::list<Entry>::iterator position,
+                                   std::vector<std::shared_ptr<ImageBuffer>>* removedBuffers) {
+  totalBytes -= position->bytes;
+  removedBuffers->push_back(std::move(position->buffer));
+  entryMap.erase(position->key);
+  entries.erase(position);
+}
+
+void ImageBufferCache::purgeUntilMemoryTo(
+    size_t limit, std::vector<std::shared_ptr<ImageBuffer>>* removedBuffers) {
+  while (totalBytes > limit && !entries.empty()) {
+    removeEntry(std::prev(entries.end()), removedBuffers);
+  }
+}
+}  // namespace tgfx
@@ -0,0 +1,109 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include "core/DataSource.h"
+#include "gpu/ResourceKey.h"
+#include "tgfx/core/ImageBuffer.h"
+
+namespace tgfx {
+/**
+ * ImageBufferCache keeps recently decoded ImageBuffers in CPU memory so that images whose textures
+ * were purged from the GPU ResourceCache can be uploaded again without decoding the encoded data
+ * a second time. Entries are keyed by the domain of the image's UniqueKey, removed once the domain
+ * is released, and evicted in LRU order once the total bytes exceed the cache limit. The cache is
+ * shared by all contexts and is disabled by default. All methods are thread-safe.
+ */
+class ImageBufferCache {
+ public:
+  static ImageBufferCache* GetInstance();
+
+  /**
+   * Returns the maximum number of bytes of decoded pixels the cache can hold. Zero means the cache
+   * is disabled. This method is lock-free.
+   */
+  size_t cacheLimit() const;
+
+  /**
+   * Sets the maximum number of bytes of decoded pixels the cache can hold. Entries are evicted
+   * immediately if the current usage exceeds the new limit.
+   */
+  void setCacheLimit(size_t bytesLimit);
+
+  /**
+   * Returns the number of bytes currently held by the cache.
+   */
+  size_t getCacheBytes() const;
+
+  /**
+   * Returns the cached ImageBuffer for the specified image key and marks it as recently used.
+   * Returns nullptr if there is no such buffer or the cache is disabled.
+   */
+  std::shared_ptr<ImageBuffer> find(const UniqueKey& uniqueKey, bool mipmapped);
+
+  /**
+   * Adds the ImageBuffer decoded for the specified image key to the cache, replacing any existing
+   * entry. Does nothing if the cache is disabled or the buffer alone exceeds the cache limit.
+   */
+  void add(const UniqueKey& uniqueKey, bool mipmapped, std::shared_ptr<ImageBuffer> buffer);
+
+  /**
+   * Wraps the specified source into a DataSource that adds the decoded ImageBuffer to the cache
+   * once it is loaded. Returns the original source if the cache is disabled.
+   */
+  std::shared_ptr<DataSource<ImageBuffer>> wrap(const UniqueKey& uniqueKey, bool mipmapped,
+                                                std::shared_ptr<DataSource<ImageBuffer>> source);
+
+  /**
+   * Removes all buffers cached for the specified unique domain. Called when the last UniqueKey of
+   * the domain is released, since no image can look them up anymore.
+   */
+  void remove(uint32_t domainID);
+
+ private:
+  struct Entry {
+    uint64_t key = 0;
+    size_t bytes = 0;
+    std::shared_ptr<ImageBuffer> buffer = nullptr;
+  };
+
+  mutable std::mutex locker = {};
+  std::atomic<size_t> bytesLimit = {0};
+  size_t totalBytes = 0;
+  std::list<Entry> entries = {};
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> entryMap = {};
+
+  ImageBufferCache() = default;
+
+  void addBuffer(uint64_t key, std::shared_ptr<ImageBuffer> buffer);
+  // Both methods move the removed buffers into removedBuffers, which callers must destroy after
+  // unlocking, since releasing a buffer may release other unique domains and re-enter remove().
+  void removeEntry(std::list<Entry>::iterator position,
+                   std::vector<std::shared_ptr<ImageBuffer>>* removedBuffers);
+  void purgeUntilMemoryTo(size_t bytesLimit,
+                          std::vector<std::shared_ptr<ImageBuffer>>* removedBuffers);
+
+  friend class CachedImageSource;
+};
+}  // namespace tgfx
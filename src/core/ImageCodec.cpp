@@ -17,13 +17,17 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/core/ImageCodec.h"
+#include <algorithm>
 #include "core/PixelBuffer.h"
+#include "core/codecs/KTX2Generator.h"
 #include "core/utils/USE.h"
 #include "core/utils/WeakMap.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/ImageInfo.h"
 #include "tgfx/core/Pixmap.h"
 #include "tgfx/core/Stream.h"
+#include "tgfx/core/Task.h"
+#include "tgfx/core/WriteStream.h"
 
 #if defined(TGFX_USE_WEBP_DECODE) || defined(TGFX_USE_WEBP_ENCODE)
 #include "core/codecs/webp/WebpCodec.h"
@@ -116,32 +120,91 @@ std::shared_ptr<ImageCodec> ImageCodec::MakeFrom(std::shared_ptr<Data> imageByte
 }
 
 std::shared_ptr<Data> ImageCodec::Encode(const Pixmap& pixmap, EncodedFormat format, int quality) {
-  if (pixmap.isEmpty()) {
+  EncodeOptions options = {};
+  options.quality = quality;
+  return Encode(pixmap, format, options);
+}
+
+std::shared_ptr<Data> ImageCodec::Encode(const Pixmap& pixmap, EncodedFormat format,
+                                         const EncodeOptions& options) {
+  auto stream = MemoryWriteStream::Make();
+  if (!Encode(pixmap, format, options, stream.get())) {
     return nullptr;
   }
-  USE(format);
-  if (quality > 100) {
-    quality = 100;
-  }
-  if (quality < 0) {
-    quality = 0;
+  return stream->readData();
+}
+
+bool ImageCodec::Encode(const Pixmap& pixmap, EncodedFormat format, const EncodeOptions& options,
+                        WriteStream* stream) {
+  if (pixmap.isEmpty() || stream == nullptr) {
+    return false;
+  }
+  auto encodeOptions = options;
+  encodeOptions.quality = std::clamp(options.quality, 0, 100);
+  USE(encodeOptions);
+  if (format == EncodedFormat::KTX2) {
+    auto data = KTX2Generator::Encode(pixmap);
+    return data != nullptr && stream->write(data->data(), data->size());
   }
 #ifdef TGFX_USE_JPEG_ENCODE
   if (format == EncodedFormat::JPEG) {
-    return JpegCodec::Encode(pixmap, quality);
+    return JpegCodec::Encode(pixmap, encodeOptions, stream);
   }
 #endif
 #ifdef TGFX_USE_WEBP_ENCODE
   if (format == EncodedFormat::WEBP) {
-    return WebpCodec::Encode(pixmap, quality);
+    return WebpCodec::Encode(pixmap, encodeOptions, stream);
   }
 #endif
 #ifdef TGFX_USE_PNG_ENCODE
   if (format == EncodedFormat::PNG) {
-    return PngCodec::Encode(pixmap, quality);
+    return PngCodec::Encode(pixmap, encodeOptions, stream);
   }
 #endif
-  return nullptr;
+  return false;
+}
+
+class EncodeTask : public Task {
+ public:
+  EncodeTask(const Pixmap& pixmap, EncodedFormat format, const EncodeOptions& options)
+      : pixmap(pixmap), format(format), options(options) {
+  }
+
+  std::shared_ptr<Data> getData() const {
+    return data;
+  }
+
+ protected:
+  void onExecute() override {
+    data = ImageCodec::Encode(pixmap, format, options);
+  }
+
+ private:
+  Pixmap pixmap = {};
+  EncodedFormat format = EncodedFormat::PNG;
+  EncodeOptions options = {};
+  std::shared_ptr<Data> data = nullptr;
+};
+
+std::vector<std::shared_ptr<Data>> ImageCodec::Encode(const std::vector<Pixmap>& pixmaps,
+                                                      EncodedFormat format,
+                                                      const EncodeOptions& options) {
+  std::vector<std::shared_ptr<EncodeTask>> tasks = {};
+  tasks.reserve(pixmaps.size());
+  for (auto& pixmap : pixmaps) {
+    auto task = std::make_shared<EncodeTask>(pixmap, format, options);
+    Task::Run(task);
+    tasks.push_back(std::move(task));
+  }
+  std::vector<std::shared_ptr<Data>> results = {};
+  results.reserve(tasks.size());
+  for (auto& task : tasks) {
+    // wait() executes the task on the calling thread if no worker has picked it up yet, so the
+    // calling thread helps with the batch instead of sitting idle.
+    task->wait();
+    results.push_back(task->getData());
+  }
+  return results;
 }
 
 std::shared_ptr<ImageBuffer> ImageCodec::onMakeBuffer(bool tryHardware) const {
@@ -17,13 +17,18 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/core/ImageFilter.h"
+#include "core/images/ResourceImage.h"
+#include "core/utils/Types.h"
 #include "gpu/DrawingManager.h"
+#include "gpu/ProxyProvider.h"
 #include "gpu/RenderContext.h"
+#include "gpu/Resource.h"
 #include "gpu/TPArgs.h"
 #include "gpu/processors/FragmentProcessor.h"
 #include "gpu/processors/TextureEffect.h"
 #include "gpu/processors/TiledTextureEffect.h"
 #include "gpu/proxies/RenderTargetProxy.h"
+#include "tgfx/core/RenderFlags.h"
 
 namespace tgfx {
 Rect ImageFilter::filterBounds(const Rect& rect) const {
@@ -58,6 +63,89 @@ std::shared_ptr<TextureProxy> ImageFilter::lockTextureProxy(std::shared_ptr<Imag
   return renderTarget->asTextureProxy();
 }
 
+bool ImageFilter::onComputeCacheKey(BytesKey*) const {
+  return false;
+}
+
+UniqueKey ImageFilter::getCacheKey(const Image* source, const Rect& clipBounds,
+                                   bool mipmapped) const {
+  UniqueKey imageKey = {};
+  switch (Types::Get(source)) {
+    case Types::ImageType::Buffer:
+    case Types::ImageType::Codec:
+    case Types::ImageType::Decoded:
+    case Types::ImageType::Generator:
+    case Types::ImageType::Mipmap:
+    case Types::ImageType::Rasterized:
+      imageKey = static_cast<const ResourceImage*>(source)->uniqueKey;
+      break;
+    default:
+      return {};
+  }
+  BytesKey bytesKey = {};
+  bytesKey.write(static_cast<uint32_t>(type()));
+  if (!onComputeCacheKey(&bytesKey)) {
+    return {};
+  }
+  bytesKey.write(clipBounds.left);
+  bytesKey.write(clipBounds.top);
+  bytesKey.write(clipBounds.right);
+  bytesKey.write(clipBounds.bottom);
+  bytesKey.write(static_cast<uint32_t>(mipmapped));
+  return UniqueKey::Append(imageKey, bytesKey.data(), bytesKey.size());
+}
+
+/**
+ * DrawnMarker is an empty resource that records a filter output key was drawn recently. It shares
+ * the unique domain of the source image, so it goes away with the image or once it expires in the
+ * ResourceCache.
+ */
+class DrawnMarker : public Resource {
+ public:
+  size_t memoryUsage() const override {
+    return 0;
+  }
+
+ protected:
+  void onReleaseGPU() override {
+  }
+};
+
+// Returns true if the cache key was drawn before, otherwise marks it as drawn and returns false.
+static bool CheckDrawnBefore(Context* context, const UniqueKey& cacheKey) {
+  static constexpr uint32_t DrawnMarkerType = 1;
+  auto markerKey = UniqueKey::Append(cacheKey, &DrawnMarkerType, 1);
+  if (Resource::Find<DrawnMarker>(context, markerKey) != nullptr) {
+    return true;
+  }
+  auto marker = Resource::AddToCache(context, new DrawnMarker());
+  marker->assignUniqueKey(markerKey);
+  return false;
+}
+
+std::shared_ptr<TextureProxy> ImageFilter::lockCachedTextureProxy(std::shared_ptr<Image> source,
+                                                                  const Rect& clipBounds,
+                                                                  const TPArgs& args,
+                                                                  const UniqueKey& cacheKey) const {
+  if (cacheKey.empty() || (args.renderFlags & RenderFlags::DisableCache)) {
+    return lockTextureProxy(std::move(source), clipBounds, args);
+  }
+  auto proxyProvider = args.context->proxyProvider();
+  auto width = static_cast<int>(clipBounds.width());
+  auto height = static_cast<int>(clipBounds.height());
+  if (auto textureProxy = proxyProvider->findOrWrapTextureProxy(cacheKey, width, height)) {
+    return textureProxy;
+  }
+  if (!CheckDrawnBefore(args.context, cacheKey)) {
+    return lockTextureProxy(std::move(source), clipBounds, args);
+  }
+  auto textureProxy = lockTextureProxy(std::move(source), clipBounds, args);
+  if (textureProxy != nullptr) {
+    proxyProvider->assignProxyUniqueKey(textureProxy, cacheKey);
+  }
+  return textureProxy;
+}
+
 bool ImageFilter::applyCropRect(const Rect& srcRect, Rect* dstRect, const Rect* clipBounds) const {
   *dstRect = onFilterBounds(srcRect);
   if (clipBounds) {
@@ -84,7 +172,8 @@ PlacementPtr<FragmentProcessor> ImageFilter::makeFPFromTextureProxy(
   auto isAlphaOnly = source->isAlphaOnly();
   auto mipmapped = source->hasMipmaps() && sampling.mipmapMode != MipmapMode::None;
   TPArgs tpArgs(args.context, args.renderFlags, mipmapped);
-  auto textureProxy = lockTextureProxy(std::move(source), dstBounds, tpArgs);
+  auto cacheKey = getCacheKey(source.get(), dstBounds, mipmapped);
+  auto textureProxy = lockCachedTextureProxy(std::move(source), dstBounds, tpArgs, cacheKey);
   if (textureProxy == nullptr) {
     return nullptr;
   }
@@ -96,6 +96,10 @@ class PixelBuffer : public ImageBuffer {
 
   std::shared_ptr<Texture> onMakeTexture(Context* context, bool mipmapped) const override;
 
+  size_t onMemoryUsage() const override {
+    return _info.byteSize();
+  }
+
   virtual void* onLockPixels() const = 0;
   virtual void onUnlockPixels() const = 0;
   virtual std::shared_ptr<Texture> onBindToHardwareTexture(Context* context) const = 0;
@@ -63,6 +63,10 @@ class RawPixelData : public ImageBuffer {
     }
   }
 
+  size_t onMemoryUsage() const override {
+    return info.byteSize();
+  }
+
  private:
   ImageInfo info = {};
   std::shared_ptr<Data> pixels = nullptr;
@@ -31,6 +31,10 @@ class RawPixelCodec : public ImageCodec {
     return info.isAlphaOnly();
   }
 
+  bool isOpaque() const override {
+    return info.alphaType() == AlphaType::Opaque && !info.isAlphaOnly();
+  }
+
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override {
     return Pixmap(info, pixels->data()).readPixels(dstInfo, dstPixels);
   }
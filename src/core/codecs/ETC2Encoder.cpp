@@ -0,0 +1,328 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ETC2Encoder.h"
+#include <algorithm>
+#include <climits>
+#include <vector>
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/Task.h"
+
+namespace tgfx {
+static constexpr int BlockBytesRGB = 8;
+static constexpr int BlockBytesRGBA = 16;
+// The number of block rows compressed by a single task.
+static constexpr int BlockRowsPerTask = 16;
+
+// The ETC1 modifier tables. A pixel index selects +small, +large, -small or -large.
+static constexpr int ETC1Modifiers[8][2] = {{2, 8},   {5, 17},  {9, 29},   {13, 42},
+                                            {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+// The EAC modifier tables used for the alpha channel of ETC2_RGBA8.
+static constexpr int EACModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},  {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},  {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},   {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+/**
+ * The 16 pixels of a 4x4 block in RGBA order. Pixels are stored column by column, which is the
+ * order ETC uses for pixel indices.
+ */
+struct BlockPixels {
+  uint8_t rgba[16][4] = {};
+};
+
+static int ETC1Modifier(int table, int index) {
+  auto value = ETC1Modifiers[table][index & 1];
+  return index & 2 ? -value : value;
+}
+
+static int Square(int value) {
+  return value * value;
+}
+
+static void WriteBigEndian(uint64_t value, uint8_t* dst) {
+  for (int i = 7; i >= 0; i--) {
+    dst[i] = static_cast<uint8_t>(value & 0xFF);
+    value >>= 8;
+  }
+}
+
+/**
+ * Picks the modifier table and pixel indices that best approximate the given pixels of a subblock
+ * around the base color. Returns the squared error.
+ */
+static int FitSubblock(const BlockPixels& block, const int* pixels, const int base[3], int* table,
+                       int* indices) {
+  int bestError = INT_MAX;
+  for (int t = 0; t < 8; t++) {
+    int tableError = 0;
+    int tableIndices[8] = {};
+    for (int i = 0; i < 8 && tableError < bestError; i++) {
+      auto color = block.rgba[pixels[i]];
+      int pixelError = INT_MAX;
+      for (int index = 0; index < 4; index++) {
+        auto modifier = ETC1Modifier(t, index);
+        int error = 0;
+        for (int c = 0; c < 3; c++) {
+          error += Square(std::clamp(base[c] + modifier, 0, 255) - color[c]);
+        }
+        if (error < pixelError) {
+          pixelError = error;
+          tableIndices[i] = index;
+        }
+      }
+      tableError += pixelError;
+    }
+    if (tableError < bestError) {
+      bestError = tableError;
+      *table = t;
+      std::copy(tableIndices, tableIndices + 8, indices);
+    }
+  }
+  return bestError;
+}
+
+static uint64_t EncodeColorBlock(const BlockPixels& block) {
+  uint64_t bestBits = 0;
+  int bestError = INT_MAX;
+  for (int flip = 0; flip < 2; flip++) {
+    // When flip is 0 the block is split into two 2x4 halves side by side, otherwise into two 4x2
+    // halves on top of each other.
+    int subblocks[2][8] = {};
+    int counts[2] = {};
+    float average[2][3] = {};
+    for (int i = 0; i < 16; i++) {
+      auto x = i / 4;
+      auto y = i % 4;
+      auto s = (flip ? y : x) >= 2 ? 1 : 0;
+      subblocks[s][counts[s]++] = i;
+      for (int c = 0; c < 3; c++) {
+        average[s][c] += static_cast<float>(block.rgba[i][c]) / 8.0f;
+      }
+    }
+    int quantized5[2][3] = {};
+    int quantized4[2][3] = {};
+    bool differentialFits = true;
+    for (int s = 0; s < 2; s++) {
+      for (int c = 0; c < 3; c++) {
+        quantized5[s][c] = static_cast<int>(average[s][c] * 31.0f / 255.0f + 0.5f);
+        quantized4[s][c] = static_cast<int>(average[s][c] * 15.0f / 255.0f + 0.5f);
+      }
+    }
+    for (int c = 0; c < 3; c++) {
+      auto delta = quantized5[1][c] - quantized5[0][c];
+      if (delta < -4 || delta > 3) {
+        differentialFits = false;
+      }
+    }
+    for (int differential = 0; differential < 2; differential++) {
+      if (differential && !differentialFits) {
+        continue;
+      }
+      int base[2][3] = {};
+      for (int s = 0; s < 2; s++) {
+        for (int c = 0; c < 3; c++) {
+          auto value = differential ? quantized5[s][c] : quantized4[s][c];
+          base[s][c] = differential ? (value << 3) | (value >> 2) : (value << 4) | value;
+        }
+      }
+      int tables[2] = {};
+      int indices[2][8] = {};
+      int error = FitSubblock(block, subblocks[0], base[0], &tables[0], indices[0]);
+      if (error >= bestError) {
+        continue;
+      }
+      error += FitSubblock(block, subblocks[1], base[1], &tables[1], indices[1]);
+      if (error >= bestError) {
+        continue;
+      }
+      bestError = error;
+      uint32_t header = 0;
+      if (differential) {
+        for (int c = 0; c < 3; c++) {
+          auto delta = static_cast<uint32_t>(quantized5[1][c] - quantized5[0][c]) & 0x7;
+          auto shift = 27 - c * 8;
+          header |= static_cast<uint32_t>(quantized5[0][c]) << shift;
+          header |= delta << (shift - 3);
+        }
+      } else {
+        for (int c = 0; c < 3; c++) {
+          auto shift = 28 - c * 8;
+          header |= static_cast<uint32_t>(quantized4[0][c]) << shift;
+          header |= static_cast<uint32_t>(quantized4[1][c]) << (shift - 4);
+        }
+      }
+      header |= static_cast<uint32_t>(tables[0]) << 5 | static_cast<uint32_t>(tables[1]) << 2;
+      header |= static_cast<uint32_t>(differential) << 1 | static_cast<uint32_t>(flip);
+      uint32_t pixelBits = 0;
+      for (int s = 0; s < 2; s++) {
+        for (int i = 0; i < 8; i++) {
+          auto pixel = subblocks[s][i];
+          auto index = static_cast<uint32_t>(indices[s][i]);
+          pixelBits |= (index >> 1) << (16 + pixel);
+          pixelBits |= (index & 1) << pixel;
+        }
+      }
+      bestBits = static_cast<uint64_t>(header) << 32 | pixelBits;
+    }
+  }
+  return bestBits;
+}
+
+static int FitAlpha(const BlockPixels& block, int base, int multiplier, int table, int bestError,
+                    int* indices) {
+  int error = 0;
+  for (int i = 0; i < 16 && error < bestError; i++) {
+    auto alpha = block.rgba[i][3];
+    int pixelError = INT_MAX;
+    for (int index = 0; index < 8; index++) {
+      auto value = std::clamp(base + EACModifiers[table][index] * multiplier, 0, 255);
+      auto valueError = Square(value - alpha);
+      if (valueError < pixelError) {
+        pixelError = valueError;
+        indices[i] = index;
+      }
+    }
+    error += pixelError;
+  }
+  return error;
+}
+
+static uint64_t EncodeAlphaBlock(const BlockPixels& block) {
+  int minAlpha = 255;
+  int maxAlpha = 0;
+  for (auto& pixel : block.rgba) {
+    minAlpha = std::min(minAlpha, static_cast<int>(pixel[3]));
+    maxAlpha = std::max(maxAlpha, static_cast<int>(pixel[3]));
+  }
+  int bestBase = minAlpha;
+  int bestMultiplier = 1;
+  // Table 13 contains a zero modifier at index 4, which reproduces a constant alpha exactly.
+  int bestTable = 13;
+  int bestIndices[16] = {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4};
+  if (minAlpha != maxAlpha) {
+    int bestError = INT_MAX;
+    for (int table = 0; table < 16 && bestError > 0; table++) {
+      auto tableMin = *std::min_element(EACModifiers[table], EACModifiers[table] + 8);
+      auto tableMax = *std::max_element(EACModifiers[table], EACModifiers[table] + 8);
+      auto tableRange = tableMax - tableMin;
+      auto idealMultiplier = (maxAlpha - minAlpha + tableRange / 2) / tableRange;
+      for (int multiplier = std::max(1, idealMultiplier - 1);
+           multiplier <= std::min(15, idealMultiplier + 1); multiplier++) {
+        auto center = (minAlpha + maxAlpha - (tableMin + tableMax) * multiplier) / 2;
+        for (int base = std::max(0, center - 1); base <= std::min(255, center + 1); base++) {
+          int indices[16] = {};
+          auto error = FitAlpha(block, base, multiplier, table, bestError, indices);
+          if (error < bestError) {
+            bestError = error;
+            bestBase = base;
+            bestMultiplier = multiplier;
+            bestTable = table;
+            std::copy(indices, indices + 16, bestIndices);
+          }
+        }
+      }
+    }
+  }
+  auto bits = static_cast<uint64_t>(bestBase) << 56 | static_cast<uint64_t>(bestMultiplier) << 52 |
+              static_cast<uint64_t>(bestTable) << 48;
+  for (int i = 0; i < 16; i++) {
+    bits |= static_cast<uint64_t>(bestIndices[i]) << (45 - 3 * i);
+  }
+  return bits;
+}
+
+static void EncodeBlockRows(const uint8_t* pixels, size_t rowBytes, int width, int height,
+                            bool hasAlpha, int startBlockRow, int endBlockRow, uint8_t* dst) {
+  auto blockBytes = hasAlpha ? BlockBytesRGBA : BlockBytesRGB;
+  auto blocksX = (width + 3) / 4;
+  for (int blockY = startBlockRow; blockY < endBlockRow; blockY++) {
+    for (int blockX = 0; blockX < blocksX; blockX++) {
+      BlockPixels block = {};
+      for (int i = 0; i < 16; i++) {
+        // Pixels outside the image replicate the nearest edge pixel.
+        auto x = std::min(blockX * 4 + i / 4, width - 1);
+        auto y = std::min(blockY * 4 + i % 4, height - 1);
+        auto src = pixels + static_cast<size_t>(y) * rowBytes + static_cast<size_t>(x) * 4;
+        std::copy(src, src + 4, block.rgba[i]);
+      }
+      auto blockIndex = static_cast<size_t>(blockY) * static_cast<size_t>(blocksX) +
+                        static_cast<size_t>(blockX);
+      auto output = dst + blockIndex * static_cast<size_t>(blockBytes);
+      if (hasAlpha) {
+        WriteBigEndian(EncodeAlphaBlock(block), output);
+        output += BlockBytesRGB;
+      }
+      WriteBigEndian(EncodeColorBlock(block), output);
+    }
+  }
+}
+
+std::shared_ptr<Data> ETC2Encoder::Encode(const Pixmap& pixmap, PixelFormat* outFormat) {
+  if (pixmap.isEmpty()) {
+    return nullptr;
+  }
+  auto width = pixmap.width();
+  auto height = pixmap.height();
+  auto alphaType = pixmap.alphaType() == AlphaType::Opaque ? AlphaType::Opaque
+                                                           : AlphaType::Premultiplied;
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, alphaType);
+  Buffer buffer(info.byteSize());
+  if (buffer.isEmpty() || !pixmap.readPixels(info, buffer.data())) {
+    return nullptr;
+  }
+  auto pixels = buffer.bytes();
+  bool hasAlpha = false;
+  if (alphaType != AlphaType::Opaque) {
+    for (size_t i = 3; i < buffer.size() && !hasAlpha; i += 4) {
+      hasAlpha = pixels[i] != 255;
+    }
+  }
+  auto blocksX = static_cast<size_t>(width + 3) / 4;
+  auto blocksY = (height + 3) / 4;
+  auto blockBytes = static_cast<size_t>(hasAlpha ? BlockBytesRGBA : BlockBytesRGB);
+  Buffer output(blocksX * static_cast<size_t>(blocksY) * blockBytes);
+  if (output.isEmpty()) {
+    return nullptr;
+  }
+  auto rowBytes = info.rowBytes();
+  auto dst = output.bytes();
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (int startRow = BlockRowsPerTask; startRow < blocksY; startRow += BlockRowsPerTask) {
+    auto endRow = std::min(startRow + BlockRowsPerTask, blocksY);
+    tasks.push_back(Task::Run([=]() {
+      EncodeBlockRows(pixels, rowBytes, width, height, hasAlpha, startRow, endRow, dst);
+    }));
+  }
+  EncodeBlockRows(pixels, rowBytes, width, height, hasAlpha, 0,
+                  std::min(BlockRowsPerTask, blocksY), dst);
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  if (outFormat != nullptr) {
+    *outFormat = hasAlpha ? PixelFormat::ETC2_RGBA8 : PixelFormat::ETC2_RGB8;
+  }
+  return output.release();
+}
+}  // namespace tgfx
@@ -0,0 +1,40 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/Data.h"
+#include "tgfx/core/Pixmap.h"
+#include "tgfx/gpu/PixelFormat.h"
+
+namespace tgfx {
+/**
+ * ETC2Encoder compresses pixels into ETC2 blocks on the CPU, so images can be transcoded once at
+ * import time and uploaded as compressed textures afterward.
+ */
+class ETC2Encoder {
+ public:
+  /**
+   * Compresses the pixmap into PixelFormat::ETC2_RGB8 blocks if it is opaque, or into
+   * PixelFormat::ETC2_RGBA8 blocks otherwise. Translucent pixels are premultiplied before
+   * compression. The chosen format is returned in outFormat. Returns nullptr if the pixmap is empty
+   * or its pixels can not be converted.
+   */
+  static std::shared_ptr<Data> Encode(const Pixmap& pixmap, PixelFormat* outFormat);
+};
+}  // namespace tgfx
@@ -0,0 +1,281 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "KTX2Generator.h"
+#include <cstring>
+#include "core/codecs/ETC2Encoder.h"
+#include "core/utils/Log.h"
+#include "core/utils/PixelFormatUtil.h"
+#include "gpu/Texture.h"
+#include "tgfx/core/Buffer.h"
+
+namespace tgfx {
+// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+static constexpr uint8_t KTX2Identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                               0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+static constexpr size_t KTX2HeaderSize = 80;
+static constexpr size_t KTX2LevelIndexSize = 24;
+
+// The VkFormat values of the supported block-compressed formats.
+static constexpr uint32_t VK_FORMAT_BC1_RGBA_UNORM_BLOCK = 133;
+static constexpr uint32_t VK_FORMAT_BC1_RGBA_SRGB_BLOCK = 134;
+static constexpr uint32_t VK_FORMAT_BC3_UNORM_BLOCK = 137;
+static constexpr uint32_t VK_FORMAT_BC3_SRGB_BLOCK = 138;
+static constexpr uint32_t VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK = 147;
+static constexpr uint32_t VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK = 148;
+static constexpr uint32_t VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK = 151;
+static constexpr uint32_t VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK = 152;
+static constexpr uint32_t VK_FORMAT_ASTC_4x4_UNORM_BLOCK = 157;
+static constexpr uint32_t VK_FORMAT_ASTC_4x4_SRGB_BLOCK = 158;
+
+// Constants of the Khronos basic data format descriptor.
+static constexpr uint32_t KHR_DF_MODEL_ETC2 = 161;
+static constexpr uint32_t KHR_DF_PRIMARIES_BT709 = 1;
+static constexpr uint32_t KHR_DF_TRANSFER_SRGB = 2;
+static constexpr uint32_t KHR_DF_FLAG_ALPHA_PREMULTIPLIED = 1;
+static constexpr uint32_t KHR_DF_CHANNEL_ETC2_COLOR = 2;
+static constexpr uint32_t KHR_DF_CHANNEL_ETC2_ALPHA = 15;
+
+static PixelFormat VkFormatToPixelFormat(uint32_t vkFormat) {
+  switch (vkFormat) {
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+      return PixelFormat::BC1_RGBA;
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+      return PixelFormat::BC3_RGBA;
+    case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+      return PixelFormat::ETC2_RGB8;
+    case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+      return PixelFormat::ETC2_RGBA8;
+    case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+      return PixelFormat::ASTC_4x4;
+    default:
+      return PixelFormat::Unknown;
+  }
+}
+
+static uint32_t ReadUint32(const uint8_t* bytes, size_t offset) {
+  uint32_t value = 0;
+  memcpy(&value, bytes + offset, sizeof(value));
+  return value;
+}
+
+static uint64_t ReadUint64(const uint8_t* bytes, size_t offset) {
+  uint64_t value = 0;
+  memcpy(&value, bytes + offset, sizeof(value));
+  return value;
+}
+
+static void WriteUint32(uint8_t* bytes, size_t offset, uint32_t value) {
+  memcpy(bytes + offset, &value, sizeof(value));
+}
+
+static void WriteUint64(uint8_t* bytes, size_t offset, uint64_t value) {
+  memcpy(bytes + offset, &value, sizeof(value));
+}
+
+/**
+ * CompressedBuffer holds the block-compressed data of a texture and all its mipmap levels.
+ */
+class CompressedBuffer : public ImageBuffer {
+ public:
+  CompressedBuffer(int width, int height, PixelFormat format, std::shared_ptr<Data> fileData,
+                   std::vector<std::shared_ptr<Data>> levels)
+      : _width(width), _height(height), format(format), fileData(std::move(fileData)),
+        levels(std::move(levels)) {
+  }
+
+  int width() const override {
+    return _width;
+  }
+
+  int height() const override {
+    return _height;
+  }
+
+  bool isAlphaOnly() const override {
+    return false;
+  }
+
+ protected:
+  std::shared_ptr<Texture> onMakeTexture(Context* context, bool) const override {
+    // The mipmap levels are decided by the container, they can't be generated for compressed data.
+    auto texture = Texture::MakeCompressed(context, _width, _height, format, levels);
+    if (texture == nullptr) {
+      LOGE("CompressedBuffer::onMakeTexture() The compressed format is not supported by the GPU.");
+    }
+    return texture;
+  }
+
+  size_t onMemoryUsage() const override {
+    size_t bytes = 0;
+    for (auto& level : levels) {
+      bytes += level->size();
+    }
+    return bytes;
+  }
+
+ private:
+  int _width = 0;
+  int _height = 0;
+  PixelFormat format = PixelFormat::Unknown;
+  // Keeps the memory referenced by the levels alive.
+  std::shared_ptr<Data> fileData = nullptr;
+  std::vector<std::shared_ptr<Data>> levels = {};
+};
+
+bool KTX2Generator::IsKTX2(const std::shared_ptr<Data>& data) {
+  return data != nullptr && data->size() >= sizeof(KTX2Identifier) &&
+         memcmp(data->data(), KTX2Identifier, sizeof(KTX2Identifier)) == 0;
+}
+
+std::shared_ptr<KTX2Generator> KTX2Generator::MakeFrom(std::shared_ptr<Data> data) {
+  if (!IsKTX2(data) || data->size() < KTX2HeaderSize) {
+    return nullptr;
+  }
+  auto bytes = data->bytes();
+  auto format = VkFormatToPixelFormat(ReadUint32(bytes, 12));
+  auto width = ReadUint32(bytes, 20);
+  auto height = ReadUint32(bytes, 24);
+  auto depth = ReadUint32(bytes, 28);
+  auto layerCount = ReadUint32(bytes, 32);
+  auto faceCount = ReadUint32(bytes, 36);
+  auto levelCount = std::max(ReadUint32(bytes, 40), 1u);
+  auto supercompressionScheme = ReadUint32(bytes, 44);
+  if (format == PixelFormat::Unknown || supercompressionScheme != 0 || depth > 1 ||
+      layerCount > 1 || faceCount != 1 ||
+      !ImageInfo::IsValidSize(static_cast<int>(width), static_cast<int>(height))) {
+    return nullptr;
+  }
+  // Rejects level counts beyond the full mipmap chain, which would also overflow the shifts below.
+  uint32_t maxLevelCount = 1;
+  for (auto size = std::max(width, height); size > 1; size >>= 1) {
+    maxLevelCount++;
+  }
+  if (levelCount > maxLevelCount ||
+      data->size() < KTX2HeaderSize + KTX2LevelIndexSize * levelCount) {
+    return nullptr;
+  }
+  std::vector<std::shared_ptr<Data>> levels = {};
+  for (uint32_t level = 0; level < levelCount; level++) {
+    auto indexOffset = KTX2HeaderSize + KTX2LevelIndexSize * level;
+    auto byteOffset = ReadUint64(bytes, indexOffset);
+    auto byteLength = ReadUint64(bytes, indexOffset + 8);
+    auto levelWidth = std::max(1, static_cast<int>(width >> level));
+    auto levelHeight = std::max(1, static_cast<int>(height >> level));
+    if (byteOffset > data->size() || byteLength > data->size() - byteOffset ||
+        byteLength < CompressedDataSize(format, levelWidth, levelHeight)) {
+      return nullptr;
+    }
+    levels.push_back(Data::MakeWithoutCopy(bytes + byteOffset, static_cast<size_t>(byteLength)));
+  }
+  auto generator = new KTX2Generator(static_cast<int>(width), static_cast<int>(height), format,
+                                     std::move(data), std::move(levels));
+  return std::shared_ptr<KTX2Generator>(generator);
+}
+
+/**
+ * Writes the basic data format descriptor for the ETC2 formats, which is required by the KTX2
+ * specification whenever vkFormat is defined.
+ */
+static size_t WriteETC2Descriptor(uint8_t* bytes, size_t offset, bool hasAlpha) {
+  uint32_t sampleCount = hasAlpha ? 2 : 1;
+  uint32_t blockSize = 24 + 16 * sampleCount;
+  WriteUint32(bytes, offset, 4 + blockSize);
+  offset += 4;
+  // vendorId and descriptorType are both zero for the basic descriptor block.
+  WriteUint32(bytes, offset, 0);
+  WriteUint32(bytes, offset + 4, 2 | blockSize << 16);
+  auto flags = hasAlpha ? KHR_DF_FLAG_ALPHA_PREMULTIPLIED : 0;
+  WriteUint32(bytes, offset + 8, KHR_DF_MODEL_ETC2 | KHR_DF_PRIMARIES_BT709 << 8 |
+                                     KHR_DF_TRANSFER_SRGB << 16 | flags << 24);
+  // The texel block dimensions are stored minus one.
+  WriteUint32(bytes, offset + 12, 3 | 3 << 8);
+  WriteUint32(bytes, offset + 16, hasAlpha ? 16 : 8);
+  WriteUint32(bytes, offset + 20, 0);
+  offset += 24;
+  std::vector<uint32_t> channels = {};
+  if (hasAlpha) {
+    channels.push_back(KHR_DF_CHANNEL_ETC2_ALPHA);
+  }
+  channels.push_back(KHR_DF_CHANNEL_ETC2_COLOR);
+  uint32_t bitOffset = 0;
+  for (auto channel : channels) {
+    // Each channel occupies 64 bits, the bit length is stored minus one.
+    WriteUint32(bytes, offset, bitOffset | 63 << 16 | channel << 24);
+    WriteUint32(bytes, offset + 4, 0);
+    WriteUint32(bytes, offset + 8, 0);
+    WriteUint32(bytes, offset + 12, UINT32_MAX);
+    offset += 16;
+    bitOffset += 64;
+  }
+  return offset;
+}
+
+std::shared_ptr<Data> KTX2Generator::Encode(const Pixmap& pixmap) {
+  auto format = PixelFormat::Unknown;
+  auto blocks = ETC2Encoder::Encode(pixmap, &format);
+  if (blocks == nullptr) {
+    return nullptr;
+  }
+  bool hasAlpha = format == PixelFormat::ETC2_RGBA8;
+  size_t dfdOffset = KTX2HeaderSize + KTX2LevelIndexSize;
+  size_t dfdLength = 4 + 24 + (hasAlpha ? 32 : 16);
+  // The level data must be aligned to the least common multiple of the block size and 4.
+  size_t levelOffset = (dfdOffset + dfdLength + 15) & ~static_cast<size_t>(15);
+  Buffer buffer(levelOffset + blocks->size());
+  if (buffer.isEmpty()) {
+    return nullptr;
+  }
+  buffer.clear();
+  auto bytes = buffer.bytes();
+  memcpy(bytes, KTX2Identifier, sizeof(KTX2Identifier));
+  // The pixels are sRGB encoded, the loader maps the sRGB formats to the same PixelFormats, which
+  // are sampled without decoding.
+  WriteUint32(bytes, 12, hasAlpha ? VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+                                  : VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK);
+  WriteUint32(bytes, 16, 1);  // typeSize
+  WriteUint32(bytes, 20, static_cast<uint32_t>(pixmap.width()));
+  WriteUint32(bytes, 24, static_cast<uint32_t>(pixmap.height()));
+  WriteUint32(bytes, 36, 1);  // faceCount
+  WriteUint32(bytes, 40, 1);  // levelCount
+  WriteUint32(bytes, 48, static_cast<uint32_t>(dfdOffset));
+  WriteUint32(bytes, 52, static_cast<uint32_t>(dfdLength));
+  WriteUint64(bytes, KTX2HeaderSize, levelOffset);
+  WriteUint64(bytes, KTX2HeaderSize + 8, blocks->size());
+  WriteUint64(bytes, KTX2HeaderSize + 16, blocks->size());
+  WriteETC2Descriptor(bytes, dfdOffset, hasAlpha);
+  memcpy(bytes + levelOffset, blocks->data(), blocks->size());
+  return buffer.release();
+}
+
+KTX2Generator::KTX2Generator(int width, int height, PixelFormat format,
+                             std::shared_ptr<Data> fileData,
+                             std::vector<std::shared_ptr<Data>> levels)
+    : ImageGenerator(width, height), _format(format), fileData(std::move(fileData)),
+      levels(std::move(levels)) {
+}
+
+std::shared_ptr<ImageBuffer> KTX2Generator::onMakeBuffer(bool) const {
+  return std::make_shared<CompressedBuffer>(width(), height(), _format, fileData, levels);
+}
+}  // namespace tgfx
@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "tgfx/core/Data.h"
+#include "tgfx/core/ImageGenerator.h"
+#include "tgfx/core/Pixmap.h"
+#include "tgfx/gpu/PixelFormat.h"
+
+namespace tgfx {
+/**
+ * KTX2Generator loads pre-compressed textures from KTX2 containers. The compressed data is
+ * uploaded to the GPU as-is, so it must be supported by the GPU backend (see
+ * Caps::isCompressedFormatSupported()), and the color channels of translucent images must be
+ * premultiplied by alpha. Supercompressed containers are not supported.
+ */
+class KTX2Generator : public ImageGenerator {
+ public:
+  /**
+   * Returns true if the data starts with the KTX2 file identifier.
+   */
+  static bool IsKTX2(const std::shared_ptr<Data>& data);
+
+  /**
+   * Creates a KTX2Generator from the KTX2 file data. Returns nullptr if the data is not a valid
+   * KTX2 container or its format is not one of the compressed PixelFormats.
+   */
+  static std::shared_ptr<KTX2Generator> MakeFrom(std::shared_ptr<Data> data);
+
+  /**
+   * Transcodes the pixmap into ETC2 blocks on the CPU and wraps them in a KTX2 container with a
+   * single mipmap level. Returns nullptr if the pixmap is empty or can not be converted.
+   */
+  static std::shared_ptr<Data> Encode(const Pixmap& pixmap);
+
+  /**
+   * Returns the compressed pixel format of the texture.
+   */
+  PixelFormat format() const {
+    return _format;
+  }
+
+  bool isAlphaOnly() const override {
+    return false;
+  }
+
+  bool asyncSupport() const override {
+    // The compressed data is ready to upload, there is nothing to decode.
+    return false;
+  }
+
+ protected:
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override;
+
+ private:
+  PixelFormat _format = PixelFormat::Unknown;
+  std::shared_ptr<Data> fileData = nullptr;
+  std::vector<std::shared_ptr<Data>> levels = {};
+
+  KTX2Generator(int width, int height, PixelFormat format, std::shared_ptr<Data> fileData,
+                std::vector<std::shared_ptr<Data>> levels);
+};
+}  // namespace tgfx
@@ -17,12 +17,14 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/codecs/jpeg/JpegCodec.h"
+#include <algorithm>
 #include <csetjmp>
 #include "core/utils/OrientationHelper.h"
 #include "skcms.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Data.h"
 #include "tgfx/core/Pixmap.h"
+#include "tgfx/core/WriteStream.h"
 
 extern "C" {
 #include "jerror.h"
@@ -267,59 +269,114 @@ std::shared_ptr<Data> JpegCodec::getEncodedData() const {
 }
 
 #ifdef TGFX_USE_JPEG_ENCODE
-std::shared_ptr<Data> JpegCodec::Encode(const Pixmap& pixmap, int quality) {
+static constexpr size_t JPEG_DEST_BUFFER_SIZE = 4096;
+static constexpr JDIMENSION JPEG_ROWS_PER_BATCH = 16;
+
+/**
+ * A libjpeg destination manager that forwards the compressed bytes to a WriteStream through a
+ * small fixed-size buffer.
+ */
+struct JpegStreamDestination {
+  jpeg_destination_mgr manager = {};
+  WriteStream* stream = nullptr;
+  JOCTET buffer[JPEG_DEST_BUFFER_SIZE] = {};
+};
+
+static void my_error_exit(j_common_ptr cinfo) {
+  auto err = reinterpret_cast<my_error_mgr*>(cinfo->err);
+  longjmp(err->setjmp_buffer, 1);
+}
+
+static void jpeg_stream_init_destination(j_compress_ptr cinfo) {
+  auto dest = reinterpret_cast<JpegStreamDestination*>(cinfo->dest);
+  dest->manager.next_output_byte = dest->buffer;
+  dest->manager.free_in_buffer = JPEG_DEST_BUFFER_SIZE;
+}
+
+static boolean jpeg_stream_empty_output_buffer(j_compress_ptr cinfo) {
+  auto dest = reinterpret_cast<JpegStreamDestination*>(cinfo->dest);
+  if (!dest->stream->write(dest->buffer, JPEG_DEST_BUFFER_SIZE)) {
+    ERREXIT(cinfo, JERR_FILE_WRITE);
+  }
+  dest->manager.next_output_byte = dest->buffer;
+  dest->manager.free_in_buffer = JPEG_DEST_BUFFER_SIZE;
+  return TRUE;
+}
+
+static void jpeg_stream_term_destination(j_compress_ptr cinfo) {
+  auto dest = reinterpret_cast<JpegStreamDestination*>(cinfo->dest);
+  auto size = JPEG_DEST_BUFFER_SIZE - dest->manager.free_in_buffer;
+  if (size > 0 && !dest->stream->write(dest->buffer, size)) {
+    ERREXIT(cinfo, JERR_FILE_WRITE);
+  }
+}
+
+bool JpegCodec::Encode(const Pixmap& pixmap, const EncodeOptions& options, WriteStream* stream) {
   auto srcPixels = static_cast<uint8_t*>(const_cast<void*>(pixmap.pixels()));
-  int srcRowBytes = static_cast<int>(pixmap.rowBytes());
-  jpeg_compress_struct cinfo = {};
-  jpeg_error_mgr jerr = {};
-  JSAMPROW row_pointer[1];
-  cinfo.err = jpeg_std_error(&jerr);
-  jpeg_create_compress(&cinfo);
-  uint8_t* dstBuffer = nullptr;
-  unsigned long dstBufferSize = 0;  // NOLINT
-  jpeg_mem_dest(&cinfo, &dstBuffer, &dstBufferSize);
-  cinfo.image_width = static_cast<JDIMENSION>(pixmap.width());
-  cinfo.image_height = static_cast<JDIMENSION>(pixmap.height());
+  auto srcRowBytes = pixmap.rowBytes();
   Buffer buffer = {};
+  J_COLOR_SPACE colorSpace = JCS_EXT_RGBA;
+  int components = 4;
   switch (pixmap.colorType()) {
     case ColorType::RGBA_8888:
-      cinfo.in_color_space = JCS_EXT_RGBA;
-      cinfo.input_components = 4;
       break;
     case ColorType::BGRA_8888:
-      cinfo.in_color_space = JCS_EXT_BGRA;
-      cinfo.input_components = 4;
+      colorSpace = JCS_EXT_BGRA;
       break;
     case ColorType::Gray_8:
-      cinfo.in_color_space = JCS_GRAYSCALE;
-      cinfo.input_components = 1;
+      colorSpace = JCS_GRAYSCALE;
+      components = 1;
       break;
     default:
       auto info = ImageInfo::Make(pixmap.width(), pixmap.height(), ColorType::RGBA_8888);
       buffer.alloc(info.byteSize());
       if (buffer.isEmpty()) {
-        return nullptr;
+        return false;
       }
       srcPixels = buffer.bytes();
-      srcRowBytes = static_cast<int>(info.rowBytes());
+      srcRowBytes = info.rowBytes();
       Pixmap(info, srcPixels).writePixels(pixmap.info(), pixmap.pixels());
-      cinfo.in_color_space = JCS_EXT_RGBA;
-      cinfo.input_components = 4;
       break;
   }
+  jpeg_compress_struct cinfo = {};
+  my_error_mgr jerr = {};
+  cinfo.err = jpeg_std_error(&jerr.pub);
+  jerr.pub.error_exit = my_error_exit;
+  if (setjmp(jerr.setjmp_buffer)) {
+    jpeg_destroy_compress(&cinfo);
+    return false;
+  }
+  jpeg_create_compress(&cinfo);
+  JpegStreamDestination dest = {};
+  dest.stream = stream;
+  dest.manager.init_destination = jpeg_stream_init_destination;
+  dest.manager.empty_output_buffer = jpeg_stream_empty_output_buffer;
+  dest.manager.term_destination = jpeg_stream_term_destination;
+  cinfo.dest = &dest.manager;
+  cinfo.image_width = static_cast<JDIMENSION>(pixmap.width());
+  cinfo.image_height = static_cast<JDIMENSION>(pixmap.height());
+  cinfo.in_color_space = colorSpace;
+  cinfo.input_components = components;
   jpeg_set_defaults(&cinfo);
   cinfo.optimize_coding = TRUE;
-  jpeg_set_quality(&cinfo, quality, TRUE);
+  if (options.jpegFastDCT) {
+    cinfo.dct_method = JDCT_IFAST;
+  }
+  jpeg_set_quality(&cinfo, options.quality, TRUE);
   jpeg_start_compress(&cinfo, TRUE);
+  JSAMPROW rows[JPEG_ROWS_PER_BATCH] = {};
   while (cinfo.next_scanline < cinfo.image_height) {
-    row_pointer[0] = &(srcPixels)[cinfo.next_scanline * static_cast<JDIMENSION>(srcRowBytes)];
-    (void)jpeg_write_scanlines(&cinfo, row_pointer, 1);
+    auto rowCount = std::min(JPEG_ROWS_PER_BATCH, cinfo.image_height - cinfo.next_scanline);
+    for (JDIMENSION i = 0; i < rowCount; i++) {
+      rows[i] = srcPixels + static_cast<size_t>(cinfo.next_scanline + i) * srcRowBytes;
+    }
+    jpeg_write_scanlines(&cinfo, rows, rowCount);
   }
 
   /* similar to read file, clean up after we're done compressing */
   jpeg_finish_compress(&cinfo);
   jpeg_destroy_compress(&cinfo);
-  return Data::MakeAdopted(dstBuffer, dstBufferSize, Data::FreeProc);
+  return true;
 }
 #endif
 
@@ -28,9 +28,13 @@ class JpegCodec : public ImageCodec {
   static bool IsJpeg(const std::shared_ptr<Data>& data);
 
 #ifdef TGFX_USE_JPEG_ENCODE
-  static std::shared_ptr<Data> Encode(const Pixmap& pixmap, int quality);
+  static bool Encode(const Pixmap& pixmap, const EncodeOptions& options, WriteStream* stream);
 #endif
 
+  bool isOpaque() const override {
+    return true;
+  }
+
  protected:
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
 
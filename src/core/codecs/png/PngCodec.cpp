@@ -17,9 +17,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/codecs/png/PngCodec.h"
+#include <algorithm>
 #include "png.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Pixmap.h"
+#include "tgfx/core/WriteStream.h"
 
 namespace tgfx {
 std::shared_ptr<ImageCodec> PngCodec::MakeFrom(const std::string& filePath) {
@@ -218,44 +220,54 @@ std::shared_ptr<Data> PngCodec::getEncodedData() const {
 }
 
 #ifdef TGFX_USE_PNG_ENCODE
-struct PngWriter {
-  unsigned char* data = nullptr;
-  size_t length = 0;
-};
+// The number of rows handed to libpng per call, which keeps the per-call overhead low while the
+// temporary buffer for ALPHA_8 conversion stays small.
+static constexpr int ROWS_PER_BATCH = 16;
+
+static void png_writer_write_data(png_structp png_ptr, png_bytep data, png_size_t length) {
+  auto stream = static_cast<WriteStream*>(png_get_io_ptr(png_ptr));
+  if (!stream->write(data, length)) {
+    png_error(png_ptr, "Failed to write to the stream.");
+  }
+}
 
-static void png_reader_write_data(png_structp png_ptr, png_bytep data, png_size_t length) {
-  auto writer = static_cast<PngWriter*>(png_get_io_ptr(png_ptr));
-  size_t nsize = writer->length + length;
-  if (writer->data) {
-    writer->data = static_cast<unsigned char*>(realloc(writer->data, nsize));
-  } else {
-    writer->data = static_cast<unsigned char*>(malloc(nsize));
+static int ToPngFilterFlags(PNGFilter filter) {
+  switch (filter) {
+    case PNGFilter::None:
+      return PNG_FILTER_NONE;
+    case PNGFilter::Sub:
+      return PNG_FILTER_SUB;
+    case PNGFilter::Up:
+      return PNG_FILTER_UP;
+    case PNGFilter::Paeth:
+      return PNG_FILTER_PAETH;
+    default:
+      return PNG_ALL_FILTERS;
   }
-  memcpy(writer->data + writer->length, data, length);
-  writer->length += length;
 }
 
-std::shared_ptr<Data> PngCodec::Encode(const Pixmap& pixmap, int) {
+bool PngCodec::Encode(const Pixmap& pixmap, const EncodeOptions& options, WriteStream* stream) {
   auto srcPixels = static_cast<png_bytep>(const_cast<void*>((pixmap.pixels())));
-  auto srcRowBytes = static_cast<int>(pixmap.rowBytes());
-  uint8_t* alphaPixels = nullptr;
+  auto srcRowBytes = pixmap.rowBytes();
+  bool isAlphaOnly = pixmap.colorType() == ColorType::ALPHA_8;
   Buffer tempBuffer;
-  if (pixmap.colorType() == ColorType::ALPHA_8) {
-    tempBuffer.alloc(static_cast<size_t>(pixmap.width()) * 2);
-    alphaPixels = tempBuffer.bytes();
-    srcRowBytes = static_cast<int>(tempBuffer.size());
+  Buffer alphaBuffer;
+  if (isAlphaOnly) {
+    alphaBuffer.alloc(static_cast<size_t>(pixmap.width()) * 2 * ROWS_PER_BATCH);
+    if (alphaBuffer.isEmpty()) {
+      return false;
+    }
   } else if (pixmap.colorType() != ColorType::RGBA_8888 ||
              pixmap.alphaType() == AlphaType::Premultiplied) {
     auto dstInfo = ImageInfo::Make(pixmap.width(), pixmap.height(), ColorType::RGBA_8888,
                                    AlphaType::Unpremultiplied);
     tempBuffer.alloc(dstInfo.byteSize());
     if (!pixmap.readPixels(dstInfo, tempBuffer.data())) {
-      return nullptr;
+      return false;
     }
     srcPixels = tempBuffer.bytes();
-    srcRowBytes = static_cast<int>(dstInfo.rowBytes());
+    srcRowBytes = dstInfo.rowBytes();
   }
-  PngWriter pngWriter;
   png_structp png_ptr = nullptr;
   png_infop info_ptr = nullptr;
   png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
@@ -273,7 +285,7 @@ std::shared_ptr<Data> PngCodec::Encode(const Pixmap& pixmap, int) {
     }
     png_color_8 sigBit = {8, 8, 8, 0, 8};
     int colorType = PNG_COLOR_TYPE_RGB_ALPHA;
-    if (pixmap.colorType() == ColorType::ALPHA_8) {
+    if (isAlphaOnly) {
       // We store ALPHA_8 images as GrayAlpha in png. If the gray channel is set to 1, we assume the
       // gray channel can be ignored, and we output just alpha. We tried 0 at first, but png doesn't
       // like a 0 sigBit for a channel it expects, hence we chose 1.
@@ -284,22 +296,31 @@ std::shared_ptr<Data> PngCodec::Encode(const Pixmap& pixmap, int) {
                  static_cast<png_uint_32>(pixmap.height()), 8, colorType, PNG_INTERLACE_NONE,
                  PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
     png_set_sBIT(png_ptr, info_ptr, &sigBit);
-    png_set_write_fn(png_ptr, &pngWriter, png_reader_write_data, nullptr);
+    if (options.pngCompressionLevel >= 0) {
+      png_set_compression_level(png_ptr, std::min(options.pngCompressionLevel, 9));
+    }
+    png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, ToPngFilterFlags(options.pngFilter));
+    png_set_write_fn(png_ptr, stream, png_writer_write_data, nullptr);
     png_write_info(png_ptr, info_ptr);
-    for (int i = 0; i < pixmap.height(); ++i) {
-      if (pixmap.colorType() == ColorType::ALPHA_8) {
-        // convert alpha8 to gray
-        for (int j = 0; j < pixmap.width(); j++) {
-          *(alphaPixels++) = 0;
-          *(alphaPixels++) = *(srcPixels++);
+    png_bytep rows[ROWS_PER_BATCH] = {};
+    auto alphaRowBytes = static_cast<size_t>(pixmap.width()) * 2;
+    for (int y = 0; y < pixmap.height(); y += ROWS_PER_BATCH) {
+      auto rowCount = std::min(ROWS_PER_BATCH, pixmap.height() - y);
+      for (int i = 0; i < rowCount; i++) {
+        auto srcRow = srcPixels + static_cast<size_t>(y + i) * srcRowBytes;
+        if (isAlphaOnly) {
+          // convert alpha8 to gray
+          auto dstRow = alphaBuffer.bytes() + static_cast<size_t>(i) * alphaRowBytes;
+          for (int x = 0; x < pixmap.width(); x++) {
+            dstRow[x * 2] = 0;
+            dstRow[x * 2 + 1] = srcRow[x];
+          }
+          rows[i] = dstRow;
+        } else {
+          rows[i] = srcRow;
         }
-        alphaPixels -= srcRowBytes;
-        srcPixels += (pixmap.rowBytes() - static_cast<size_t>(pixmap.width()));
-        png_write_row(png_ptr, reinterpret_cast<png_const_bytep>(alphaPixels));
-      } else {
-        png_write_row(png_ptr, reinterpret_cast<png_const_bytep>(srcPixels));
-        srcPixels += srcRowBytes;
       }
+      png_write_rows(png_ptr, rows, static_cast<png_uint_32>(rowCount));
     }
     png_write_end(png_ptr, info_ptr);
     encodeSuccess = true;
@@ -307,13 +328,7 @@ std::shared_ptr<Data> PngCodec::Encode(const Pixmap& pixmap, int) {
   if (png_ptr) {
     png_destroy_write_struct(&png_ptr, &info_ptr);
   }
-  if (!encodeSuccess) {
-    if (pngWriter.data) {
-      free(pngWriter.data);
-    }
-    return nullptr;
-  }
-  return Data::MakeAdopted(pngWriter.data, pngWriter.length, Data::FreeProc);
+  return encodeSuccess;
 }
 #endif
 
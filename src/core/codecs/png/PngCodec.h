@@ -30,7 +30,7 @@ class PngCodec : public ImageCodec {
   bool isAlphaOnly() const override;
 
 #ifdef TGFX_USE_PNG_ENCODE
-  static std::shared_ptr<Data> Encode(const Pixmap& pixmap, int quality);
+  static bool Encode(const Pixmap& pixmap, const EncodeOptions& options, WriteStream* stream);
 #endif
 
  protected:
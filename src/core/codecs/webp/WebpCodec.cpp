@@ -17,9 +17,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/codecs/webp/WebpCodec.h"
+#include <algorithm>
 #include "core/codecs/webp/WebpUtility.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Pixmap.h"
+#include "tgfx/core/WriteStream.h"
 
 namespace tgfx {
 
@@ -123,26 +125,13 @@ std::shared_ptr<Data> WebpCodec::getEncodedData() const {
 }
 
 #ifdef TGFX_USE_WEBP_ENCODE
-struct WebpWriter {
-  unsigned char* data = nullptr;
-  size_t length = 0;
-};
-
-static int webp_reader_write_data(const uint8_t* data, size_t data_size,
+static int webp_writer_write_data(const uint8_t* data, size_t data_size,
                                   const WebPPicture* picture) {
-  auto writer = static_cast<WebpWriter*>(picture->custom_ptr);
-  size_t nsize = writer->length + data_size;
-  if (writer->data) {
-    writer->data = static_cast<unsigned char*>(realloc(writer->data, nsize));
-  } else {
-    writer->data = static_cast<unsigned char*>(malloc(nsize));
-  }
-  memcpy(writer->data + writer->length, data, data_size);
-  writer->length += data_size;
-  return 1;
+  auto stream = static_cast<WriteStream*>(picture->custom_ptr);
+  return stream->write(data, data_size) ? 1 : 0;
 }
 
-std::shared_ptr<Data> WebpCodec::Encode(const Pixmap& pixmap, int quality) {
+bool WebpCodec::Encode(const Pixmap& pixmap, const EncodeOptions& options, WriteStream* stream) {
   const uint8_t* srcPixels = static_cast<uint8_t*>(const_cast<void*>(pixmap.pixels()));
   auto srcInfo = pixmap.info();
   Buffer tempBuffer = {};
@@ -154,23 +143,24 @@ std::shared_ptr<Data> WebpCodec::Encode(const Pixmap& pixmap, int quality) {
     tempBuffer.alloc(srcInfo.byteSize());
     srcPixels = tempBuffer.bytes();
     if (!pixmap.readPixels(srcInfo, tempBuffer.data())) {
-      return nullptr;
+      return false;
     }
   }
   WebPConfig webp_config;
+  auto quality = options.quality;
   bool isLossless = false;
   if (quality == 100) {
     quality = 75;
     isLossless = true;
   }
   if (!WebPConfigPreset(&webp_config, WEBP_PRESET_DEFAULT, static_cast<float>(quality))) {
-    return nullptr;
+    return false;
   }
   WebPPicture pic;
   WebPPictureInit(&pic);
   pic.width = srcInfo.width();
   pic.height = srcInfo.height();
-  pic.writer = webp_reader_write_data;
+  pic.writer = webp_writer_write_data;
   if (isLossless) {
     webp_config.lossless = 1;
     webp_config.method = 0;
@@ -180,9 +170,10 @@ std::shared_ptr<Data> WebpCodec::Encode(const Pixmap& pixmap, int quality) {
     webp_config.method = 3;
     pic.use_argb = 0;
   }
-
-  WebpWriter webpWriter;
-  pic.custom_ptr = &webpWriter;
+  if (options.webpMethod >= 0) {
+    webp_config.method = std::min(options.webpMethod, 6);
+  }
+  pic.custom_ptr = stream;
   auto importProc = WebPPictureImportRGBX;
   if (ColorType::RGBA_8888 == srcInfo.colorType()) {
     if (AlphaType::Opaque == srcInfo.alphaType()) {
@@ -200,13 +191,10 @@ std::shared_ptr<Data> WebpCodec::Encode(const Pixmap& pixmap, int quality) {
   auto rowBytes = static_cast<int>(srcInfo.rowBytes());
   if (!importProc(&pic, srcPixels, rowBytes) || !WebPEncode(&webp_config, &pic)) {
     WebPPictureFree(&pic);
-    if (webpWriter.data) {
-      free(webpWriter.data);
-    }
-    return nullptr;
+    return false;
   }
   WebPPictureFree(&pic);
-  return Data::MakeAdopted(webpWriter.data, webpWriter.length, Data::FreeProc);
+  return true;
 }
 #endif
 
@@ -31,7 +31,7 @@ class WebpCodec : public ImageCodec {
   static bool IsWebp(const std::shared_ptr<Data>& data);
 
 #ifdef TGFX_USE_WEBP_ENCODE
-  static std::shared_ptr<Data> Encode(const Pixmap& pixmap, int quality);
+  static bool Encode(const Pixmap& pixmap, const EncodeOptions& options, WriteStream* stream);
 #endif
 
  protected:
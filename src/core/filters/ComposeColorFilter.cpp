@@ -17,10 +17,55 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ComposeColorFilter.h"
+#include "MatrixColorFilter.h"
 #include "core/utils/Types.h"
 #include "gpu/processors/FragmentProcessor.h"
 
 namespace tgfx {
+// Returns true if the matrix may produce values outside [0, 1] for inputs within [0, 1], in which
+// case its output is clamped before being passed to the next filter.
+static bool NeedsClamping(const std::array<float, 20>& matrix) {
+  for (int row = 0; row < 4; row++) {
+    auto translate = matrix[row * 5 + 4];
+    auto min = translate;
+    auto max = translate;
+    for (int column = 0; column < 4; column++) {
+      auto value = matrix[row * 5 + column];
+      if (value < 0) {
+        min += value;
+      } else {
+        max += value;
+      }
+    }
+    if (min < 0 || max > 1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns true if the alpha output of the matrix only depends on the input alpha. Each matrix stage
+// runs on unpremultiplied colors, so the colors of an inner stage that outputs zero alpha are lost
+// before the outer stage runs, which only matters if the outer alpha depends on them.
+static bool IsAlphaOnlyScaled(const std::array<float, 20>& matrix) {
+  return matrix[15] == 0.0f && matrix[16] == 0.0f && matrix[17] == 0.0f && matrix[19] == 0.0f;
+}
+
+static std::array<float, 20> ConcatMatrix(const std::array<float, 20>& outer,
+                                          const std::array<float, 20>& inner) {
+  std::array<float, 20> result = {};
+  for (int row = 0; row < 4; row++) {
+    for (int column = 0; column < 5; column++) {
+      auto value = column == 4 ? outer[row * 5 + 4] : 0.0f;
+      for (int k = 0; k < 4; k++) {
+        value += outer[row * 5 + k] * inner[k * 5 + column];
+      }
+      result[row * 5 + column] = value;
+    }
+  }
+  return result;
+}
+
 std::shared_ptr<ColorFilter> ColorFilter::Compose(std::shared_ptr<ColorFilter> inner,
                                                   std::shared_ptr<ColorFilter> outer) {
   if (outer == nullptr && inner == nullptr) {
@@ -32,6 +77,23 @@ std::shared_ptr<ColorFilter> ColorFilter::Compose(std::shared_ptr<ColorFilter> i
   if (inner == nullptr) {
     return outer;
   }
+  if (Types::Get(outer.get()) == Types::ColorFilterType::Matrix) {
+    if (Types::Get(inner.get()) == Types::ColorFilterType::Compose) {
+      // Folds the matrix into the last stage of the inner chain if possible.
+      auto composeFilter = static_cast<const ComposeColorFilter*>(inner.get());
+      if (Types::Get(composeFilter->outer.get()) == Types::ColorFilterType::Matrix) {
+        return Compose(composeFilter->inner, Compose(composeFilter->outer, std::move(outer)));
+      }
+    } else if (Types::Get(inner.get()) == Types::ColorFilterType::Matrix) {
+      // Two matrices can run as one when the inner one never gets clamped, and the outer alpha
+      // doesn't depend on the colors the inner one may zero out.
+      auto& innerMatrix = static_cast<const MatrixColorFilter*>(inner.get())->matrix;
+      auto& outerMatrix = static_cast<const MatrixColorFilter*>(outer.get())->matrix;
+      if (!NeedsClamping(innerMatrix) && IsAlphaOnlyScaled(outerMatrix)) {
+        return std::make_shared<MatrixColorFilter>(ConcatMatrix(outerMatrix, innerMatrix));
+      }
+    }
+  }
   return std::make_shared<ComposeColorFilter>(std::move(inner), std::move(outer));
 }
 
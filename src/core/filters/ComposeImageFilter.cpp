@@ -17,9 +17,26 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ComposeImageFilter.h"
+#include "ColorImageFilter.h"
 #include "core/images/FilterImage.h"
+#include "core/utils/Types.h"
 
 namespace tgfx {
+// Merges adjacent color filters into one, so a chain of color adjustments runs as a single color
+// stage instead of wrapping the image once per filter.
+static void AppendFilter(std::vector<std::shared_ptr<ImageFilter>>* filters,
+                         std::shared_ptr<ImageFilter> filter) {
+  if (filter != nullptr && !filters->empty() && filters->back() != nullptr &&
+      Types::Get(filter.get()) == Types::ImageFilterType::Color &&
+      Types::Get(filters->back().get()) == Types::ImageFilterType::Color) {
+    auto inner = static_cast<const ColorImageFilter*>(filters->back().get())->filter;
+    auto outer = static_cast<const ColorImageFilter*>(filter.get())->filter;
+    filters->back() = std::make_shared<ColorImageFilter>(ColorFilter::Compose(inner, outer));
+    return;
+  }
+  filters->push_back(std::move(filter));
+}
+
 std::shared_ptr<ImageFilter> ImageFilter::Compose(std::shared_ptr<ImageFilter> inner,
                                                   std::shared_ptr<ImageFilter> outer) {
   if (outer == nullptr && inner == nullptr) {
@@ -40,9 +57,14 @@ std::shared_ptr<ImageFilter> ImageFilter::Compose(std::shared_ptr<ImageFilter> i
   }
   if (outer->type() == Type::Compose) {
     auto outerFilters = static_cast<ComposeImageFilter*>(outer.get())->filters;
-    filters.insert(filters.end(), outerFilters.begin(), outerFilters.end());
+    for (auto& filter : outerFilters) {
+      AppendFilter(&filters, filter);
+    }
   } else {
-    filters.push_back(std::move(outer));
+    AppendFilter(&filters, std::move(outer));
+  }
+  if (filters.size() == 1) {
+    return filters[0];
   }
   return std::make_shared<ComposeImageFilter>(std::move(filters));
 }
@@ -52,10 +74,15 @@ std::shared_ptr<ImageFilter> ImageFilter::Compose(
   if (filters.empty()) {
     return nullptr;
   }
-  if (filters.size() == 1) {
-    return filters[0];
+  std::vector<std::shared_ptr<ImageFilter>> mergedFilters = {};
+  mergedFilters.reserve(filters.size());
+  for (auto& filter : filters) {
+    AppendFilter(&mergedFilters, std::move(filter));
   }
-  return std::make_shared<ComposeImageFilter>(std::move(filters));
+  if (mergedFilters.size() == 1) {
+    return mergedFilters[0];
+  }
+  return std::make_shared<ComposeImageFilter>(std::move(mergedFilters));
 }
 
 ComposeImageFilter::ComposeImageFilter(std::vector<std::shared_ptr<ImageFilter>> filters)
@@ -70,6 +97,16 @@ Rect ComposeImageFilter::onFilterBounds(const Rect& srcRect) const {
   return bounds;
 }
 
+bool ComposeImageFilter::onComputeCacheKey(BytesKey* key) const {
+  for (auto& filter : filters) {
+    key->write(static_cast<uint32_t>(filter->type()));
+    if (!filter->onComputeCacheKey(key)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 PlacementPtr<FragmentProcessor> ComposeImageFilter::asFragmentProcessor(
     std::shared_ptr<Image> source, const FPArgs& args, const SamplingOptions& sampling,
     SrcRectConstraint constraint, const Matrix* uvMatrix) const {
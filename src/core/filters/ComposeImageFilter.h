@@ -34,6 +34,8 @@ class ComposeImageFilter : public ImageFilter {
 
   Rect onFilterBounds(const Rect& srcRect) const override;
 
+  bool onComputeCacheKey(BytesKey* key) const override;
+
   PlacementPtr<FragmentProcessor> asFragmentProcessor(std::shared_ptr<Image> source,
                                                       const FPArgs& args,
                                                       const SamplingOptions& sampling,
@@ -39,6 +39,8 @@ class DropShadowImageFilter : public ImageFilter {
 
   Rect onFilterBounds(const Rect& srcRect) const override;
 
+  bool onComputeCacheKey(BytesKey* key) const override;
+
   PlacementPtr<FragmentProcessor> asFragmentProcessor(std::shared_ptr<Image> source,
                                                       const FPArgs& args,
                                                       const SamplingOptions& sampling,
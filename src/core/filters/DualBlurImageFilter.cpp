@@ -18,6 +18,7 @@
 
 #include "DualBlurImageFilter.h"
 #include "core/utils/MathExtra.h"
+#include "core/utils/UniqueID.h"
 #include "gpu/DrawingManager.h"
 #include "gpu/RenderContext.h"
 #include "gpu/TPArgs.h"
@@ -203,6 +204,15 @@ std::shared_ptr<TextureProxy> DualBlurImageFilter::lockTextureProxy(std::shared_
   return lastRenderTarget->asTextureProxy();
 }
 
+bool DualBlurImageFilter::onComputeCacheKey(BytesKey* key) const {
+  static const auto DualBlurType = UniqueID::Next();
+  key->write(DualBlurType);
+  key->write(blurrinessX);
+  key->write(blurrinessY);
+  key->write(static_cast<uint32_t>(tileMode));
+  return true;
+}
+
 PlacementPtr<FragmentProcessor> DualBlurImageFilter::asFragmentProcessor(
     std::shared_ptr<Image> source, const FPArgs& args, const SamplingOptions& sampling,
     SrcRectConstraint constraint, const Matrix* uvMatrix) const {
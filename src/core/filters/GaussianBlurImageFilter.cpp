@@ -19,6 +19,8 @@
 #include "GaussianBlurImageFilter.h"
 #include <memory>
 #include <utility>
+#include "core/utils/MathExtra.h"
+#include "core/utils/UniqueID.h"
 #include "gpu/DrawingManager.h"
 #include "gpu/TPArgs.h"
 #include "gpu/processors/GaussianBlur1DFragmentProcessor.h"
@@ -48,16 +50,21 @@ GaussianBlurImageFilter::GaussianBlurImageFilter(float blurrinessX, float blurri
     : BlurImageFilter(blurrinessX, blurrinessY, tileMode) {
 }
 
+// The texelStep is the distance between two taps in texels of the source, adjacent taps are only
+// merged into one bilinear fetch if it is exactly one texel.
 static void Blur1D(PlacementPtr<FragmentProcessor> source,
                    std::shared_ptr<RenderTargetProxy> renderTarget, float sigma,
-                   GaussianBlurDirection direction, float stepLength, uint32_t renderFlags) {
+                   GaussianBlurDirection direction, float stepLength, float texelStep,
+                   uint32_t renderFlags) {
   if (!renderTarget) {
     return;
   }
   auto context = renderTarget->getContext();
   auto drawingManager = context->drawingManager();
-  auto processor = GaussianBlur1DFragmentProcessor::Make(
-      context->drawingBuffer(), std::move(source), sigma, direction, stepLength, MAX_BLUR_SIGMA);
+  auto mergeTaps = FloatNearlyEqual(texelStep, 1.0f);
+  auto processor =
+      GaussianBlur1DFragmentProcessor::Make(context->drawingBuffer(), std::move(source), sigma,
+                                            direction, stepLength, MAX_BLUR_SIGMA, mergeTaps);
   drawingManager->fillRTWithFP(renderTarget, std::move(processor), renderFlags);
 }
 
@@ -80,6 +87,46 @@ static std::shared_ptr<TextureProxy> ScaleTexture(const TPArgs& args,
   return renderTarget->asTextureProxy();
 }
 
+// Halves the sampled area repeatedly until it is less than twice the target size, so that every
+// source pixel still contributes to the blur input of a heavily downscaled blur. Each step samples
+// the previous level at texel corners, where the bilinear filter averages exactly 2x2 texels.
+// Returns nullptr if no downsampling is needed.
+static std::shared_ptr<TextureProxy> DownsampleSource(std::shared_ptr<Image> source,
+                                                      const Rect& sampleBounds,
+                                                      const Rect& targetBounds, TileMode tileMode,
+                                                      const TPArgs& args) {
+  auto width = sampleBounds.width();
+  auto height = sampleBounds.height();
+  std::shared_ptr<TextureProxy> texture = nullptr;
+  auto drawingManager = args.context->drawingManager();
+  while (width >= 2.0f * targetBounds.width() && height >= 2.0f * targetBounds.height()) {
+    auto levelWidth = ceilf(width * 0.5f);
+    auto levelHeight = ceilf(height * 0.5f);
+    auto renderTarget = RenderTargetProxy::MakeFallback(
+        args.context, static_cast<int>(levelWidth), static_cast<int>(levelHeight),
+        source->isAlphaOnly(), 1, false, ImageOrigin::TopLeft, BackingFit::Approx);
+    if (renderTarget == nullptr) {
+      return nullptr;
+    }
+    auto uvMatrix = Matrix::MakeScale(width / levelWidth, height / levelHeight);
+    PlacementPtr<FragmentProcessor> processor = nullptr;
+    if (texture == nullptr) {
+      uvMatrix.postTranslate(sampleBounds.left, sampleBounds.top);
+      FPArgs fpArgs(args.context, args.renderFlags, Rect::MakeWH(levelWidth, levelHeight));
+      processor = FragmentProcessor::Make(source, fpArgs, tileMode, tileMode, {},
+                                          SrcRectConstraint::Fast, &uvMatrix);
+    } else {
+      SamplingArgs samplingArgs = {tileMode, tileMode, {}, SrcRectConstraint::Fast};
+      processor = TiledTextureEffect::Make(std::move(texture), samplingArgs, &uvMatrix);
+    }
+    drawingManager->fillRTWithFP(renderTarget, std::move(processor), args.renderFlags);
+    texture = renderTarget->asTextureProxy();
+    width = levelWidth;
+    height = levelHeight;
+  }
+  return texture;
+}
+
 std::shared_ptr<TextureProxy> GaussianBlurImageFilter::lockTextureProxy(
     std::shared_ptr<Image> source, const Rect& clipBounds, const TPArgs& args) const {
   const float maxSigma = std::max(blurrinessX, blurrinessY);
@@ -118,12 +165,26 @@ std::shared_ptr<TextureProxy> GaussianBlurImageFilter::lockTextureProxy(
   FPArgs fpArgs(args.context, args.renderFlags,
                 Rect::MakeWH(scaledBounds.width(), scaledBounds.height()));
 
-  auto sourceProcessor = FragmentProcessor::Make(source, fpArgs, tileMode, tileMode, {},
-                                                 SrcRectConstraint::Fast, &uvMatrix);
+  PlacementPtr<FragmentProcessor> sourceProcessor = nullptr;
+  // The downsampled levels cover the sampled bounds only, so they can stand in for the source when
+  // sampling beyond their edges gives the same result as the tile mode, which holds for decal and
+  // clamp because the sampled bounds already include the whole blur margin in 2D blurs.
+  if (blur2D && (tileMode == TileMode::Decal || tileMode == TileMode::Clamp)) {
+    if (auto texture = DownsampleSource(source, boundsWillSample, scaledBounds, tileMode, args)) {
+      uvMatrix = Matrix::MakeScale(static_cast<float>(texture->width()) / scaledBounds.width(),
+                                   static_cast<float>(texture->height()) / scaledBounds.height());
+      SamplingArgs samplingArgs = {tileMode, tileMode, {}, SrcRectConstraint::Fast};
+      sourceProcessor = TiledTextureEffect::Make(std::move(texture), samplingArgs, &uvMatrix);
+    }
+  }
+  if (sourceProcessor == nullptr) {
+    sourceProcessor = FragmentProcessor::Make(source, fpArgs, tileMode, tileMode, {},
+                                              SrcRectConstraint::Fast, &uvMatrix);
+  }
 
   if (blur2D) {
     Blur1D(std::move(sourceProcessor), renderTarget, blurrinessX * scaleFactor,
-           GaussianBlurDirection::Horizontal, 1.0f, args.renderFlags);
+           GaussianBlurDirection::Horizontal, 1.0f, uvMatrix.getScaleX(), args.renderFlags);
 
     // blur and scale the texture to the clip bounds.
     uvMatrix = Matrix::MakeScale(scaledBounds.width() / boundsWillSample.width(),
@@ -145,16 +206,16 @@ std::shared_ptr<TextureProxy> GaussianBlurImageFilter::lockTextureProxy(
 
     Blur1D(std::move(sourceProcessor), renderTarget, blurrinessY * scaleFactor,
            GaussianBlurDirection::Vertical, boundsWillSample.height() / scaledBounds.height(),
-           args.renderFlags);
+           1.0f, args.renderFlags);
     return renderTarget->asTextureProxy();
   }
 
   if (blurrinessX > 0) {
     Blur1D(std::move(sourceProcessor), renderTarget, blurrinessX * scaleFactor,
-           GaussianBlurDirection::Horizontal, 1.0f, args.renderFlags);
+           GaussianBlurDirection::Horizontal, 1.0f, uvMatrix.getScaleX(), args.renderFlags);
   } else if (blurrinessY > 0) {
     Blur1D(std::move(sourceProcessor), renderTarget, blurrinessY * scaleFactor,
-           GaussianBlurDirection::Vertical, 1.0f, args.renderFlags);
+           GaussianBlurDirection::Vertical, 1.0f, uvMatrix.getScaleY(), args.renderFlags);
   }
 
   if (maxSigma <= MAX_BLUR_SIGMA) {
@@ -169,6 +230,15 @@ Rect GaussianBlurImageFilter::onFilterBounds(const Rect& srcRect) const {
   return srcRect.makeOutset(2.f * blurrinessX, 2.f * blurrinessY);
 }
 
+bool GaussianBlurImageFilter::onComputeCacheKey(BytesKey* key) const {
+  static const auto GaussianBlurType = UniqueID::Next();
+  key->write(GaussianBlurType);
+  key->write(blurrinessX);
+  key->write(blurrinessY);
+  key->write(static_cast<uint32_t>(tileMode));
+  return true;
+}
+
 PlacementPtr<FragmentProcessor> GaussianBlurImageFilter::asFragmentProcessor(
     std::shared_ptr<Image> source, const FPArgs& args, const SamplingOptions& sampling,
     SrcRectConstraint constraint, const Matrix* uvMatrix) const {
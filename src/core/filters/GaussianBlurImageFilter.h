@@ -35,6 +35,8 @@ class GaussianBlurImageFilter : public BlurImageFilter {
                                                  const Rect& clipBounds,
                                                  const TPArgs& args) const override;
 
+  bool onComputeCacheKey(BytesKey* key) const override;
+
   PlacementPtr<FragmentProcessor> asFragmentProcessor(std::shared_ptr<Image> source,
                                                       const FPArgs& args,
                                                       const SamplingOptions& sampling,
@@ -45,6 +45,22 @@ InnerShadowImageFilter::InnerShadowImageFilter(float dx, float dy, float blurrin
       shadowOnly(shadowOnly) {
 }
 
+bool InnerShadowImageFilter::onComputeCacheKey(BytesKey* key) const {
+  key->write(dx);
+  key->write(dy);
+  key->write(color.red);
+  key->write(color.green);
+  key->write(color.blue);
+  key->write(color.alpha);
+  key->write(static_cast<uint32_t>(shadowOnly));
+  if (blurFilter == nullptr) {
+    key->write(static_cast<uint32_t>(0));
+    return true;
+  }
+  key->write(static_cast<uint32_t>(blurFilter->type()) + 1);
+  return blurFilter->onComputeCacheKey(key);
+}
+
 PlacementPtr<FragmentProcessor> InnerShadowImageFilter::asFragmentProcessor(
     std::shared_ptr<Image> source, const FPArgs& args, const SamplingOptions& sampling,
     SrcRectConstraint constraint, const Matrix* uvMatrix) const {
@@ -37,6 +37,8 @@ class InnerShadowImageFilter : public ImageFilter {
     return Type::InnerShadow;
   }
 
+  bool onComputeCacheKey(BytesKey* key) const override;
+
   PlacementPtr<FragmentProcessor> asFragmentProcessor(std::shared_ptr<Image> source,
                                                       const FPArgs& args,
                                                       const SamplingOptions& sampling,
@@ -19,6 +19,7 @@
 #include "FilterImage.h"
 #include "SubsetImage.h"
 #include "core/utils/AddressOf.h"
+#include "gpu/ResourceKey.h"
 #include "gpu/processors/TiledTextureEffect.h"
 
 namespace tgfx {
@@ -109,7 +110,8 @@ std::shared_ptr<Image> FilterImage::onMakeWithFilter(std::shared_ptr<ImageFilter
 std::shared_ptr<TextureProxy> FilterImage::lockTextureProxy(const TPArgs& args) const {
   auto inputBounds = Rect::MakeWH(source->width(), source->height());
   auto filterBounds = filter->filterBounds(inputBounds);
-  return filter->lockTextureProxy(source, filterBounds, args);
+  auto cacheKey = filter->getCacheKey(source.get(), filterBounds, args.mipmapped);
+  return filter->lockCachedTextureProxy(source, filterBounds, args, cacheKey);
 }
 
 PlacementPtr<FragmentProcessor> FilterImage::asFragmentProcessor(const FPArgs& args,
@@ -130,13 +132,16 @@ PlacementPtr<FragmentProcessor> FilterImage::asFragmentProcessor(const FPArgs& a
     return nullptr;
   }
   auto sampling = samplingArgs.sampling;
-  if (dstBounds.contains(drawBounds)) {
+  auto mipmapped = source->hasMipmaps() && sampling.mipmapMode != MipmapMode::None;
+  auto cacheKey = filter->getCacheKey(source.get(), dstBounds, mipmapped);
+  // A cached filter output is cheaper to sample than applying the filter again, so the texture
+  // path is taken whenever the output can be cached.
+  if (dstBounds.contains(drawBounds) && cacheKey.empty()) {
     return filter->asFragmentProcessor(source, args, sampling, samplingArgs.constraint,
                                        AddressOf(fpMatrix));
   }
-  auto mipmapped = source->hasMipmaps() && sampling.mipmapMode != MipmapMode::None;
   TPArgs tpArgs(args.context, args.renderFlags, mipmapped);
-  auto textureProxy = filter->lockTextureProxy(source, dstBounds, tpArgs);
+  auto textureProxy = filter->lockCachedTextureProxy(source, dstBounds, tpArgs, cacheKey);
   if (textureProxy == nullptr) {
     return nullptr;
   }
@@ -43,6 +43,10 @@ class FilterImage : public SubsetImage {
     return static_cast<int>(bounds.height());
   }
 
+  bool isOpaque() const override {
+    return false;
+  }
+
  protected:
   Type type() const override {
     return Type::Filter;
@@ -40,6 +40,10 @@ class GeneratorImage : public ResourceImage {
     return generator->isAlphaOnly();
   }
 
+  bool isOpaque() const override {
+    return generator->isOpaque();
+  }
+
   bool isFullyDecoded() const override {
     return false;
   }
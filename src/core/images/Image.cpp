@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/core/Image.h"
+#include "core/ImageBufferCache.h"
+#include "core/codecs/KTX2Generator.h"
 #include "core/images/CodecImage.h"
 #include "core/images/FilterImage.h"
 #include "core/images/OrientImage.h"
@@ -42,7 +44,7 @@ std::shared_ptr<Image> Image::MakeFromFile(const std::string& filePath) {
     return cached;
   }
   auto codec = ImageCodec::MakeFrom(filePath);
-  auto image = MakeFrom(codec);
+  auto image = codec ? MakeFrom(codec) : MakeFromEncoded(Data::MakeFromFile(filePath));
   if (image != nullptr) {
     imageMap.insert(filePath, image);
   }
@@ -50,6 +52,9 @@ std::shared_ptr<Image> Image::MakeFromFile(const std::string& filePath) {
 }
 
 std::shared_ptr<Image> Image::MakeFromEncoded(std::shared_ptr<Data> encodedData) {
+  if (KTX2Generator::IsKTX2(encodedData)) {
+    return MakeFrom(KTX2Generator::MakeFrom(std::move(encodedData)));
+  }
   auto codec = ImageCodec::MakeFrom(std::move(encodedData));
   return MakeFrom(std::move(codec));
 }
@@ -119,6 +124,14 @@ std::shared_ptr<Image> Image::MakeAdopted(Context* context, const BackendTexture
   return TextureImage::Wrap(std::move(textureProxy));
 }
 
+size_t Image::DecodedCacheLimit() {
+  return ImageBufferCache::GetInstance()->cacheLimit();
+}
+
+void Image::SetDecodedCacheLimit(size_t bytesLimit) {
+  ImageBufferCache::GetInstance()->setCacheLimit(bytesLimit);
+}
+
 std::shared_ptr<Image> Image::makeTextureImage(Context* context) const {
   if (context == nullptr) {
     return nullptr;
@@ -37,6 +37,10 @@ class MipmapImage : public ResourceImage {
     return source->isAlphaOnly();
   }
 
+  bool isOpaque() const override {
+    return source->isOpaque();
+  }
+
   bool hasMipmaps() const override {
     return true;
   }
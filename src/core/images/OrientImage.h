@@ -32,6 +32,10 @@ class OrientImage : public TransformImage {
 
   int height() const override;
 
+  bool isOpaque() const override {
+    return source->isOpaque();
+  }
+
  protected:
   Type type() const override {
     return Type::Orient;
@@ -30,6 +30,10 @@ class RGBAAAImage : public SubsetImage {
     return false;
   }
 
+  bool isOpaque() const override {
+    return false;
+  }
+
  protected:
   Type type() const override {
     return Type::RGBAAA;
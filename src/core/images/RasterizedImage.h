@@ -40,6 +40,10 @@ class RasterizedImage : public ResourceImage {
     return source->isAlphaOnly();
   }
 
+  bool isOpaque() const override {
+    return source->isOpaque();
+  }
+
   bool isFullyDecoded() const override {
     return source->isFullyDecoded();
   }
@@ -49,5 +49,6 @@ class ResourceImage : public Image {
                                                       const Matrix* uvMatrix) const override;
 
   friend class MipmapImage;
+  friend class ImageFilter;
 };
 }  // namespace tgfx
@@ -38,6 +38,10 @@ class SubsetImage : public TransformImage {
     return static_cast<int>(bounds.height());
   }
 
+  bool isOpaque() const override {
+    return source->isOpaque();
+  }
+
   Rect bounds = {};
 
  protected:
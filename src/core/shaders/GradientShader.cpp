@@ -104,8 +104,10 @@ static PlacementPtr<FragmentProcessor> MakeColorizer(const Context* context, con
   }
   // Otherwise, fall back to a raster gradient sample by a texture, which can handle
   // arbitrary gradients (the only downside being sampling resolution).
-  auto gradient = context->globalCache()->getGradient(colors + offset, positions + offset, count);
-  return TextureGradientColorizer::Make(drawingBuffer, std::move(gradient));
+  int row = 0;
+  auto gradient =
+      context->globalCache()->getGradient(colors + offset, positions + offset, count, &row);
+  return TextureGradientColorizer::Make(drawingBuffer, std::move(gradient), row);
 }
 
 GradientShader::GradientShader(const std::vector<Color>& colors,
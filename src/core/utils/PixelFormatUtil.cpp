@@ -29,6 +29,8 @@ PixelFormat ColorTypeToPixelFormat(ColorType type) {
       return PixelFormat::BGRA_8888;
     case ColorType::Gray_8:
       return PixelFormat::GRAY_8;
+    case ColorType::RGBA_F16:
+      return PixelFormat::RGBA_16F;
     default:
       return PixelFormat::Unknown;
   }
@@ -44,6 +46,8 @@ ColorType PixelFormatToColorType(PixelFormat format) {
       return ColorType::BGRA_8888;
     case PixelFormat::GRAY_8:
       return ColorType::Gray_8;
+    case PixelFormat::RGBA_16F:
+      return ColorType::RGBA_F16;
     default:
       return ColorType::Unknown;
   }
@@ -59,11 +63,41 @@ size_t PixelFormatBytesPerPixel(PixelFormat format) {
     case PixelFormat::RGBA_8888:
     case PixelFormat::BGRA_8888:
       return 4;
+    case PixelFormat::RGBA_16F:
+      return 8;
     default:
       return 0;
   }
 }
 
+static size_t CompressedBlockBytes(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::ETC2_RGB8:
+    case PixelFormat::BC1_RGBA:
+      return 8;
+    case PixelFormat::ETC2_RGBA8:
+    case PixelFormat::ASTC_4x4:
+    case PixelFormat::BC3_RGBA:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+bool IsCompressedPixelFormat(PixelFormat format) {
+  return CompressedBlockBytes(format) > 0;
+}
+
+size_t CompressedDataSize(PixelFormat format, int width, int height) {
+  if (width <= 0 || height <= 0) {
+    return 0;
+  }
+  // All supported compressed formats use 4x4 blocks.
+  auto blocksX = static_cast<size_t>(width + 3) / 4;
+  auto blocksY = static_cast<size_t>(height + 3) / 4;
+  return blocksX * blocksY * CompressedBlockBytes(format);
+}
+
 PixelFormat MaskFormatToPixelFormat(MaskFormat format) {
   switch (format) {
     case MaskFormat::A8:
@@ -30,6 +30,17 @@ ColorType PixelFormatToColorType(PixelFormat format);
 
 size_t PixelFormatBytesPerPixel(PixelFormat format);
 
+/**
+ * Returns true if the format stores pixels in compressed 4x4 blocks.
+ */
+bool IsCompressedPixelFormat(PixelFormat format);
+
+/**
+ * Returns the number of bytes needed to store an image of the given size in the compressed format,
+ * or 0 if the format is not compressed.
+ */
+size_t CompressedDataSize(PixelFormat format, int width, int height);
+
 PixelFormat MaskFormatToPixelFormat(MaskFormat format);
 
 }  // namespace tgfx
@@ -29,8 +29,11 @@ size_t DefaultTexture::memoryUsage() const {
   if (auto hardwareBuffer = _sampler->getHardwareBuffer()) {
     return HardwareBufferGetInfo(hardwareBuffer).byteSize();
   }
-  auto colorSize = static_cast<size_t>(_width) * static_cast<size_t>(_height) *
-                   PixelFormatBytesPerPixel(_sampler->format());
+  auto format = _sampler->format();
+  auto colorSize = IsCompressedPixelFormat(format)
+                       ? CompressedDataSize(format, _width, _height)
+                       : static_cast<size_t>(_width) * static_cast<size_t>(_height) *
+                             PixelFormatBytesPerPixel(format);
   return _sampler->hasMipmaps() ? colorSize * 4 / 3 : colorSize;
 }
 }  // namespace tgfx
@@ -85,10 +85,17 @@ void DrawingManager::addRuntimeDrawTask(std::shared_ptr<RenderTargetProxy> rende
   if (renderTarget == nullptr || inputs.empty() || effect == nullptr) {
     return;
   }
-  auto task = drawingBuffer->make<RuntimeDrawTask>(renderTarget, std::move(inputs),
+  // Merge into the previous task if it is the last one and shares the same program, so that
+  // consecutive runs of an effect skip the per-task setup. The task resolves its targets itself.
+  if (lastRuntimeTask != nullptr && !renderTasks.empty() &&
+      renderTasks.back().get() == lastRuntimeTask &&
+      lastRuntimeTask->addRun(renderTarget, inputs, effect, offset)) {
+    return;
+  }
+  auto task = drawingBuffer->make<RuntimeDrawTask>(std::move(renderTarget), std::move(inputs),
                                                    std::move(effect), offset);
+  lastRuntimeTask = task.get();
   renderTasks.emplace_back(std::move(task));
-  addTextureResolveTask(std::move(renderTarget));
 }
 
 void DrawingManager::addTextureResolveTask(std::shared_ptr<RenderTargetProxy> renderTarget) {
@@ -132,7 +139,7 @@ bool DrawingManager::flush() {
   // Flush the shared vertex buffer before executing the tasks. It may generate new resource tasks.
   proxyProvider->flushSharedVertexBuffer();
 
-  if (resourceTasks.empty() && renderTasks.empty()) {
+  if (resourceTasks.empty() && renderTasks.empty() && atlasCellDatas.empty()) {
     proxyProvider->clearSharedVertexBuffer();
     clearAtlasCellCodecTasks();
     return false;
@@ -153,6 +160,7 @@ bool DrawingManager::flush() {
     task = nullptr;
   }
   renderTasks.clear();
+  lastRuntimeTask = nullptr;
   return true;
 }
 
@@ -160,6 +168,7 @@ void DrawingManager::releaseAll() {
   compositors.clear();
   resourceTasks.clear();
   renderTasks.clear();
+  lastRuntimeTask = nullptr;
   atlasCellCodecTasks.clear();
   atlasCellDatas.clear();
 }
@@ -188,6 +197,15 @@ void DrawingManager::addAtlasCellCodecTask(const std::shared_ptr<TextureProxy>&
   atlasCellCodecTasks.emplace_back(std::move(task));
 }
 
+void DrawingManager::addAtlasCellData(const std::shared_ptr<TextureProxy>& textureProxy,
+                                      const Point& atlasOffset, std::shared_ptr<Data> pixels,
+                                      const ImageInfo& info) {
+  if (textureProxy == nullptr || pixels == nullptr) {
+    return;
+  }
+  atlasCellDatas[textureProxy].emplace_back(std::move(pixels), info, atlasOffset);
+}
+
 void DrawingManager::clearAtlasCellCodecTasks() {
   atlasCellCodecTasks.clear();
   atlasCellDatas.clear();
@@ -212,7 +230,7 @@ void DrawingManager::uploadAtlasToGPU() {
       auto rect = Rect::MakeXYWH(atlasOffset.x, atlasOffset.y, static_cast<float>(info.width()),
                                  static_cast<float>(info.height()));
       texture->getSampler()->writePixels(context, rect, data->data(), info.rowBytes());
-      // Text atlas has no mipmaps, so we don't need to regenerate mipmaps.
+      // Atlas textures have no mipmaps, so we don't need to regenerate mipmaps.
     }
   }
   clearAtlasCellCodecTasks();
@@ -24,6 +24,7 @@
 #include "gpu/tasks/OpsRenderTask.h"
 #include "gpu/tasks/RenderTask.h"
 #include "gpu/tasks/ResourceTask.h"
+#include "gpu/tasks/RuntimeDrawTask.h"
 
 namespace tgfx {
 struct AtlasCellData {
@@ -76,6 +77,13 @@ class DrawingManager {
   void addAtlasCellCodecTask(const std::shared_ptr<TextureProxy>& textureProxy,
                              const Point& atlasOffset, std::shared_ptr<ImageCodec> codec);
 
+  /**
+   * Adds pixels that are written into the atlas texture at the specified offset before any render
+   * task of the next flush is executed.
+   */
+  void addAtlasCellData(const std::shared_ptr<TextureProxy>& textureProxy, const Point& atlasOffset,
+                        std::shared_ptr<Data> pixels, const ImageInfo& info);
+
   void uploadAtlasToGPU();
 
  private:
@@ -84,6 +92,7 @@ class DrawingManager {
   std::unique_ptr<RenderPass> renderPass = nullptr;
   std::vector<PlacementPtr<ResourceTask>> resourceTasks = {};
   std::vector<PlacementPtr<RenderTask>> renderTasks = {};
+  RuntimeDrawTask* lastRuntimeTask = nullptr;
   std::list<std::shared_ptr<OpsCompositor>> compositors = {};
   std::vector<std::shared_ptr<Task>> atlasCellCodecTasks = {};
   std::map<std::shared_ptr<TextureProxy>, std::vector<AtlasCellData>> atlasCellDatas = {};
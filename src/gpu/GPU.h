@@ -35,8 +35,12 @@ class GPU {
     return context;
   }
 
+  /**
+   * Copies the srcRect of the render target to the texture at the dstPoint. The copied area is
+   * clipped to the bounds of both the render target and the texture.
+   */
   virtual void copyRenderTargetToTexture(const RenderTarget* renderTarget, Texture* texture,
-                                         int srcX, int srcY) = 0;
+                                         const Rect& srcRect, const Point& dstPoint) = 0;
 
   virtual void resolveRenderTarget(RenderTarget* renderTarget, const Rect& bounds) = 0;
 
@@ -17,7 +17,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GlobalCache.h"
+#include "core/AtlasManager.h"
 #include "core/PixelBuffer.h"
+#include "gpu/DrawingManager.h"
 #include "gpu/GradientGenerator.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/ops/RRectDrawOp.h"
@@ -26,7 +28,7 @@
 
 namespace tgfx {
 static constexpr size_t MAX_PROGRAM_COUNT = 128;
-static constexpr size_t MaxNumCachedGradientBitmaps = 32;
+static constexpr int GradientAtlasHeight = 256;
 static constexpr uint16_t VerticesPerNonAAQuad = 4;
 static constexpr uint16_t VerticesPerAAQuad = 8;
 
@@ -64,8 +66,9 @@ std::shared_ptr<Program> GlobalCache::getProgram(const ProgramCreator* programCr
 void GlobalCache::releaseAll() {
   programLRU.clear();
   programMap.clear();
+  gradientAtlas = nullptr;
   gradientLRU.clear();
-  gradientTextures.clear();
+  gradientRows.clear();
   aaQuadIndexBuffer = nullptr;
   nonAAQuadIndexBuffer = nullptr;
   rRectFillIndexBuffer = nullptr;
@@ -73,7 +76,7 @@ void GlobalCache::releaseAll() {
 }
 
 std::shared_ptr<TextureProxy> GlobalCache::getGradient(const Color* colors, const float* positions,
-                                                       int count) {
+                                                       int count, int* row) {
   BytesKey bytesKey = {};
   for (int i = 0; i < count; ++i) {
     bytesKey.write(colors[i].red);
@@ -82,29 +85,53 @@ std::shared_ptr<TextureProxy> GlobalCache::getGradient(const Color* colors, cons
     bytesKey.write(colors[i].alpha);
     bytesKey.write(positions[i]);
   }
-  auto result = gradientTextures.find(bytesKey);
-  if (result != gradientTextures.end()) {
-    auto& texture = result->second;
-    gradientLRU.erase(texture->cachedPosition);
-    gradientLRU.push_front(texture.get());
-    texture->cachedPosition = gradientLRU.begin();
-    return texture->textureProxy;
-  }
-  auto generator = std::make_shared<GradientGenerator>(colors, positions, count);
-  auto textureProxy = context->proxyProvider()->createTextureProxy({}, std::move(generator));
-  if (textureProxy == nullptr) {
+  auto nextFlushToken = context->atlasManager()->nextFlushToken();
+  auto result = gradientRows.find(bytesKey);
+  if (result != gradientRows.end()) {
+    auto& gradientRow = result->second;
+    gradientLRU.erase(gradientRow->cachedPosition);
+    gradientLRU.push_front(gradientRow.get());
+    gradientRow->cachedPosition = gradientLRU.begin();
+    gradientRow->lastUseToken = nextFlushToken;
+    *row = gradientRow->row;
+    return gradientAtlas;
+  }
+  if (gradientAtlas == nullptr) {
+    gradientAtlas = context->proxyProvider()->createTextureProxy(
+        UniqueKey::Make(), GradientWidth, GradientAtlasHeight, PixelFormat::RGBA_8888);
+  }
+  auto info = ImageInfo::Make(GradientWidth, 1, ColorType::RGBA_8888);
+  auto length = info.byteSize();
+  auto buffer = new (std::nothrow) uint8_t[length];
+  if (buffer == nullptr) {
     return nullptr;
   }
-  auto gradientTexture = std::make_unique<GradientTexture>(textureProxy, bytesKey);
-  gradientLRU.push_front(gradientTexture.get());
-  gradientTexture->cachedPosition = gradientLRU.begin();
-  gradientTextures[bytesKey] = std::move(gradientTexture);
-  while (gradientLRU.size() > MaxNumCachedGradientBitmaps) {
-    auto texture = gradientLRU.back();
+  auto pixels = Data::MakeAdopted(buffer, length, Data::DeleteProc);
+  GradientGenerator::WritePixels(colors, positions, count, buffer);
+  std::unique_ptr<GradientRow> gradientRow = nullptr;
+  if (gradientRows.size() < static_cast<size_t>(GradientAtlasHeight)) {
+    gradientRow = std::make_unique<GradientRow>(bytesKey, static_cast<int>(gradientRows.size()));
+  } else if (gradientLRU.back()->lastUseToken < nextFlushToken) {
+    // The least recently used row is not referenced by any pending draw, so it can be overwritten.
+    auto oldRow = gradientLRU.back();
     gradientLRU.pop_back();
-    gradientTextures.erase(texture->gradientKey);
+    gradientRow = std::make_unique<GradientRow>(bytesKey, oldRow->row);
+    gradientRows.erase(oldRow->gradientKey);
+  }
+  if (gradientAtlas == nullptr || gradientRow == nullptr) {
+    // Every row of the atlas is used by pending draws, fall back to a standalone texture.
+    auto generator = std::make_shared<GradientGenerator>(colors, positions, count);
+    *row = 0;
+    return context->proxyProvider()->createTextureProxy({}, std::move(generator));
   }
-  return textureProxy;
+  context->drawingManager()->addAtlasCellData(gradientAtlas, Point::Make(0, gradientRow->row),
+                                              std::move(pixels), info);
+  gradientRow->lastUseToken = nextFlushToken;
+  gradientLRU.push_front(gradientRow.get());
+  gradientRow->cachedPosition = gradientLRU.begin();
+  *row = gradientRow->row;
+  gradientRows[bytesKey] = std::move(gradientRow);
+  return gradientAtlas;
 }
 
 // clang-format off
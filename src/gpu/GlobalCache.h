@@ -20,6 +20,7 @@
 
 #include <list>
 #include <unordered_map>
+#include "core/AtlasTypes.h"
 #include "gpu/Program.h"
 #include "gpu/ProgramCreator.h"
 #include "gpu/proxies/GPUBufferProxy.h"
@@ -41,9 +42,13 @@ class GlobalCache {
   std::shared_ptr<Program> getProgram(const ProgramCreator* programCreator);
 
   /**
-   * Returns a texture that represents a gradient created from the specified colors and positions.
+   * Returns a texture that contains the gradient created from the specified colors and positions,
+   * and sets the row of the texture that holds the gradient. Gradients are usually packed into a
+   * shared atlas texture, one row per gradient, so that draws with different gradients can use the
+   * same texture.
    */
-  std::shared_ptr<TextureProxy> getGradient(const Color* colors, const float* positions, int count);
+  std::shared_ptr<TextureProxy> getGradient(const Color* colors, const float* positions, int count,
+                                            int* row);
 
   /**
    * Returns a GPU buffer that contains indices for rendering a quad with or without antialiasing.
@@ -57,21 +62,22 @@ class GlobalCache {
   std::shared_ptr<GPUBufferProxy> getRRectIndexBuffer(bool stroke);
 
  private:
-  struct GradientTexture {
-    GradientTexture(std::shared_ptr<TextureProxy> textureProxy, BytesKey gradientKey)
-        : textureProxy(std::move(textureProxy)), gradientKey(std::move(gradientKey)) {
+  struct GradientRow {
+    GradientRow(BytesKey gradientKey, int row) : gradientKey(std::move(gradientKey)), row(row) {
     }
 
-    std::shared_ptr<TextureProxy> textureProxy = nullptr;
     BytesKey gradientKey = {};
-    std::list<GradientTexture*>::iterator cachedPosition = {};
+    int row = 0;
+    AtlasToken lastUseToken = AtlasToken::InvalidToken();
+    std::list<GradientRow*>::iterator cachedPosition = {};
   };
 
   Context* context = nullptr;
   std::list<Program*> programLRU = {};
   BytesKeyMap<std::shared_ptr<Program>> programMap = {};
-  std::list<GradientTexture*> gradientLRU = {};
-  BytesKeyMap<std::unique_ptr<GradientTexture>> gradientTextures = {};
+  std::shared_ptr<TextureProxy> gradientAtlas = nullptr;
+  std::list<GradientRow*> gradientLRU = {};
+  BytesKeyMap<std::unique_ptr<GradientRow>> gradientRows = {};
   std::shared_ptr<GPUBufferProxy> aaQuadIndexBuffer = nullptr;
   std::shared_ptr<GPUBufferProxy> nonAAQuadIndexBuffer = nullptr;
   std::shared_ptr<GPUBufferProxy> rRectFillIndexBuffer = nullptr;
@@ -20,8 +20,6 @@
 #include "core/PixelBuffer.h"
 
 namespace tgfx {
-static constexpr int GradientWidth = 256;
-
 GradientGenerator::GradientGenerator(const Color* colors, const float* positions, int count)
     : ImageGenerator(GradientWidth, 1), colors(colors, colors + count),
       positions(positions, positions + count) {
@@ -32,46 +30,11 @@ std::shared_ptr<ImageBuffer> GradientGenerator::onMakeBuffer(bool) const {
   if (pixelBuffer == nullptr) {
     return nullptr;
   }
-  auto pixels = reinterpret_cast<uint8_t*>(pixelBuffer->lockPixels());
+  auto pixels = pixelBuffer->lockPixels();
   if (pixels == nullptr) {
     return nullptr;
   }
-  memset(pixels, 0, pixelBuffer->info().byteSize());
-  int prevIndex = 0;
-  auto count = colors.size();
-  for (size_t i = 1; i < count; ++i) {
-    int nextIndex = std::min(static_cast<int>(positions[i] * static_cast<float>(GradientWidth)),
-                             GradientWidth - 1);
-
-    if (nextIndex > prevIndex) {
-      auto r0 = colors[i - 1].red;
-      auto g0 = colors[i - 1].green;
-      auto b0 = colors[i - 1].blue;
-      auto a0 = colors[i - 1].alpha;
-      auto r1 = colors[i].red;
-      auto g1 = colors[i].green;
-      auto b1 = colors[i].blue;
-      auto a1 = colors[i].alpha;
-
-      auto step = 1.0f / static_cast<float>(nextIndex - prevIndex);
-      auto deltaR = (r1 - r0) * step;
-      auto deltaG = (g1 - g0) * step;
-      auto deltaB = (b1 - b0) * step;
-      auto deltaA = (a1 - a0) * step;
-
-      for (int curIndex = prevIndex; curIndex <= nextIndex; ++curIndex) {
-        pixels[curIndex * 4] = static_cast<uint8_t>(r0 * 255.0f);
-        pixels[curIndex * 4 + 1] = static_cast<uint8_t>(g0 * 255.0f);
-        pixels[curIndex * 4 + 2] = static_cast<uint8_t>(b0 * 255.0f);
-        pixels[curIndex * 4 + 3] = static_cast<uint8_t>(a0 * 255.0f);
-        r0 += deltaR;
-        g0 += deltaG;
-        b0 += deltaB;
-        a0 += deltaA;
-      }
-    }
-    prevIndex = nextIndex;
-  }
+  WritePixels(colors.data(), positions.data(), static_cast<int>(colors.size()), pixels);
   pixelBuffer->unlockPixels();
   return pixelBuffer;
 }
@@ -23,9 +23,19 @@
 #include "tgfx/core/ImageGenerator.h"
 
 namespace tgfx {
+/**
+ * The number of pixels used to represent a gradient in a texture.
+ */
+static constexpr int GradientWidth = 256;
 
 class GradientGenerator : public ImageGenerator {
  public:
+  /**
+   * Writes the gradient created from the specified colors and positions into the pixels, which
+   * must hold GradientWidth pixels in the RGBA_8888 format.
+   */
+  static void WritePixels(const Color* colors, const float* positions, int count, void* pixels);
+
   GradientGenerator(const Color* colors, const float* positions, int count);
 
   bool isAlphaOnly() const override {
@@ -0,0 +1,76 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gpu/GradientGenerator.h"
+#include <algorithm>
+#include <cstring>
+// First undef to prevent error when re-included.
+#undef HWY_TARGET_INCLUDE
+// For dynamic dispatch, specify the name of the current file (unfortunately
+// __FILE__ is not reliable) so that foreach_target.h can re-include it.
+#define HWY_TARGET_INCLUDE "gpu/GradientGeneratorSIMD.cpp"
+// Generates code for each enabled target by re-including this source file.
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// Must come after foreach_target.h to avoid redefinition errors.
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace tgfx {
+namespace HWY_NAMESPACE {
+namespace hn = hwy::HWY_NAMESPACE;
+void WriteGradientPixelsHWYImpl(const Color* colors, const float* positions, int count,
+                                uint8_t* pixels) {
+  memset(pixels, 0, static_cast<size_t>(GradientWidth) * 4);
+  // Each pixel is interpolated with all four channels in a single vector.
+  const hn::Full128<float> d;
+  const hn::Rebind<int32_t, decltype(d)> di;
+  const hn::Rebind<uint8_t, decltype(d)> du8;
+  auto scale = hn::Set(d, 255.0f);
+  int prevIndex = 0;
+  for (int i = 1; i < count; ++i) {
+    int nextIndex = std::min(static_cast<int>(positions[i] * static_cast<float>(GradientWidth)),
+                             GradientWidth - 1);
+    if (nextIndex > prevIndex) {
+      auto color = hn::LoadU(d, &colors[i - 1].red);
+      auto step = hn::Set(d, 1.0f / static_cast<float>(nextIndex - prevIndex));
+      auto delta = hn::Mul(hn::Sub(hn::LoadU(d, &colors[i].red), color), step);
+      for (int curIndex = prevIndex; curIndex <= nextIndex; ++curIndex) {
+        auto value = hn::ConvertTo(di, hn::Mul(color, scale));
+        hn::StoreU(hn::DemoteTo(du8, value), du8, pixels + curIndex * 4);
+        color = hn::Add(color, delta);
+      }
+    }
+    prevIndex = nextIndex;
+  }
+}
+}  // namespace HWY_NAMESPACE
+}  // namespace tgfx
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace tgfx {
+HWY_EXPORT(WriteGradientPixelsHWYImpl);
+
+void GradientGenerator::WritePixels(const Color* colors, const float* positions, int count,
+                                    void* pixels) {
+  HWY_DYNAMIC_DISPATCH(WriteGradientPixelsHWYImpl)(colors, positions, count,
+                                                   static_cast<uint8_t*>(pixels));
+}
+}  // namespace tgfx
+#endif
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "OpsCompositor.h"
+#include <cmath>
 #include "core/Atlas.h"
 #include "core/PathRasterizer.h"
 #include "core/PathRef.h"
@@ -24,15 +25,20 @@
 #include "core/utils/RectToRectMatrix.h"
 #include "core/utils/Types.h"
 #include "gpu/DrawingManager.h"
+#include "gpu/GlobalCache.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/ops/AtlasTextOp.h"
 #include "gpu/ops/ClearOp.h"
 #include "gpu/ops/DstTextureCopyOp.h"
 #include "gpu/ops/ResolveOp.h"
 #include "gpu/ops/ShapeDrawOp.h"
+#include "gpu/processors/AAConvexPolyEffect.h"
+#include "gpu/processors/AARRectEffect.h"
 #include "gpu/processors/AARectEffect.h"
 #include "gpu/processors/DeviceSpaceTextureEffect.h"
+#include "gpu/processors/SRGBToLinearEffect.h"
 #include "processors/PorterDuffXferProcessor.h"
+#include "tgfx/core/RenderFlags.h"
 
 namespace tgfx {
 /**
@@ -194,8 +200,14 @@ void OpsCompositor::fillShape(std::shared_ptr<Shape> shape, const MCState& state
   addDrawOp(std::move(drawOp), clip, fill, localBounds, deviceBounds);
 }
 
+bool OpsCompositor::isLinearColorSpace() const {
+  return (renderFlags & RenderFlags::LinearColorSpace) &&
+         renderTarget->format() == PixelFormat::RGBA_16F;
+}
+
 void OpsCompositor::discardAll() {
   ops.clear();
+  resetDstCopyState();
   if (pendingType != PendingOpType::Unknown) {
     resetPendingOps();
   }
@@ -313,9 +325,14 @@ void OpsCompositor::flushPendingOps(PendingOpType type, Path clip, Fill fill) {
   if (needLocalBounds || needDeviceBounds) {
     if (pendingType == PendingOpType::RRect) {
       deviceBounds = Rect::MakeEmpty();
-      for (auto& record : pendingRRects) {
-        auto rect = record->viewMatrix.mapRect(record->rRect.rect);
-        deviceBounds->join(rect);
+      for (size_t i = 0; i < pendingRRects.size(); i++) {
+        auto& record = pendingRRects[i];
+        auto rect = record->rRect.rect;
+        if (i < pendingStrokes.size()) {
+          auto halfWidth = pendingStrokes[i]->width * 0.5f;
+          rect.outset(halfWidth, halfWidth);
+        }
+        deviceBounds->join(record->viewMatrix.mapRect(rect));
       }
       localBounds = deviceBounds;
       if (!localBounds->intersect(clipBounds)) {
@@ -399,6 +416,10 @@ static void FlipYIfNeeded(Rect* rect, const RenderTargetProxy* renderTarget) {
   }
 }
 
+static float SRGBToLinear(float value) {
+  return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
 static bool HasColorOnly(const Fill& fill) {
   return !fill.shader && !fill.maskFilter && !fill.colorFilter;
 }
@@ -429,14 +450,23 @@ bool OpsCompositor::drawAsClear(const Rect& rect, const MCState& state, const Fi
   if (bounds == deviceBounds) {
     // discard all previous ops if the clear rect covers the entire render target.
     ops.clear();
+    resetDstCopyState();
   }
   auto format = renderTarget->format();
   auto caps = context->caps();
   auto& writeSwizzle = caps->getWriteSwizzle(format);
-  auto color = writeSwizzle.applyTo(fill.color.premultiply());
+  auto clearColor = fill.color;
+  if (isLinearColorSpace()) {
+    clearColor = {SRGBToLinear(clearColor.red), SRGBToLinear(clearColor.green),
+                  SRGBToLinear(clearColor.blue), clearColor.alpha};
+  }
+  auto color = writeSwizzle.applyTo(clearColor.premultiply());
   auto op = ClearOp::Make(context, color, bounds);
   if (op != nullptr) {
     ops.emplace_back(std::move(op));
+    if (!dstCopyOps.empty()) {
+      dstDirtyBounds.join(bounds);
+    }
   }
   return true;
 }
@@ -446,6 +476,7 @@ void OpsCompositor::makeClosed() {
     return;
   }
   flushPendingOps();
+  makeDstTexture();
   auto drawingManager = context->drawingManager();
   auto opArray = drawingBuffer()->makeArray(std::move(ops));
   drawingManager->addOpsRenderTask(std::move(renderTarget), std::move(opArray));
@@ -466,7 +497,9 @@ AAType OpsCompositor::getAAType(const Fill& fill) const {
 std::pair<bool, bool> OpsCompositor::needComputeBounds(const Fill& fill, bool hasCoverage,
                                                        bool hasImageFill) {
   bool needLocalBounds = hasImageFill || fill.shader != nullptr || fill.maskFilter != nullptr;
-  bool needDeviceBounds = false;
+  // Once a dst copy has been made, every later op reports the area it modifies, so that the copy is
+  // only redone when a draw reads back from a changed area.
+  bool needDeviceBounds = !dstCopyOps.empty();
   if (BlendModeNeedDstTexture(fill.blendMode, hasCoverage)) {
     auto caps = context->caps();
     if (!caps->frameBufferFetchSupport &&
@@ -506,19 +539,84 @@ std::pair<std::optional<Rect>, bool> OpsCompositor::getClipRect(const Path& clip
   return {rect, false};
 }
 
+static void ComputeClipMaskKey(const Path& clip, AAType aaType, const Rect& bounds,
+                               BytesKey* clipKey) {
+  // Clip paths are usually rebuilt every frame, so the key is made from the path content instead of
+  // the PathRef identity to let masks be reused across frames and surfaces.
+  clipKey->write(static_cast<uint32_t>(aaType != AAType::None));
+  clipKey->write(static_cast<uint32_t>(clip.getFillType()));
+  clipKey->write(bounds.left);
+  clipKey->write(bounds.top);
+  clipKey->write(bounds.right);
+  clipKey->write(bounds.bottom);
+  clip.decompose([&](PathVerb verb, const Point pts[4], void*) {
+    clipKey->write(static_cast<uint32_t>(verb));
+    switch (verb) {
+      case PathVerb::Move:
+        clipKey->write(pts[0].x);
+        clipKey->write(pts[0].y);
+        break;
+      case PathVerb::Line:
+        clipKey->write(pts[1].x);
+        clipKey->write(pts[1].y);
+        break;
+      case PathVerb::Quad:
+        for (int i = 1; i < 3; i++) {
+          clipKey->write(pts[i].x);
+          clipKey->write(pts[i].y);
+        }
+        break;
+      case PathVerb::Cubic:
+        for (int i = 1; i < 4; i++) {
+          clipKey->write(pts[i].x);
+          clipKey->write(pts[i].y);
+        }
+        break;
+      default:
+        break;
+    }
+  });
+}
+
 std::shared_ptr<TextureProxy> OpsCompositor::getClipTexture(const Path& clip, AAType aaType) {
   auto uniqueKey = PathRef::GetUniqueKey(clip);
   if (aaType != AAType::None) {
     static const auto AntialiasFlag = UniqueID::Next();
     uniqueKey = UniqueKey::Append(uniqueKey, &AntialiasFlag, 1);
   }
-  if (uniqueKey == clipKey) {
-    return clipTexture;
+  for (auto iter = clipMasks.begin(); iter != clipMasks.end(); ++iter) {
+    if (iter->first == uniqueKey) {
+      std::rotate(clipMasks.begin(), iter, iter + 1);
+      return clipMasks.front().second;
+    }
   }
   auto bounds = getClipBounds(clip);
   if (bounds.isEmpty()) {
     return nullptr;
   }
+  // Clip masks are stored in the ResourceCache under keys made from the clip content, so they can
+  // be shared by all compositors of the context across frames and are purged like other textures.
+  static const auto& ClipMaskDomain = *new UniqueKey(UniqueKey::Make());
+  BytesKey clipKey = {};
+  ComputeClipMaskKey(clip, aaType, bounds, &clipKey);
+  auto maskKey = UniqueKey::Append(ClipMaskDomain, clipKey.data(), clipKey.size());
+  auto clipTexture = proxyProvider()->findOrWrapTextureProxy(maskKey);
+  if (clipTexture == nullptr) {
+    clipTexture = makeClipTexture(clip, aaType, bounds, maskKey);
+    if (clipTexture == nullptr) {
+      return nullptr;
+    }
+  }
+  if (clipMasks.size() >= MAX_CLIP_MASKS) {
+    clipMasks.pop_back();
+  }
+  clipMasks.emplace(clipMasks.begin(), uniqueKey, clipTexture);
+  return clipTexture;
+}
+
+std::shared_ptr<TextureProxy> OpsCompositor::makeClipTexture(const Path& clip, AAType aaType,
+                                                             const Rect& bounds,
+                                                             const UniqueKey& uniqueKey) {
   auto width = static_cast<int>(ceilf(bounds.width()));
   auto height = static_cast<int>(ceilf(bounds.height()));
   auto rasterizeMatrix = Matrix::MakeTrans(-bounds.left, -bounds.top);
@@ -534,19 +632,76 @@ std::shared_ptr<TextureProxy> OpsCompositor::getClipTexture(const Path& clip, AA
     if (clipRenderTarget == nullptr) {
       return nullptr;
     }
-    clipTexture = clipRenderTarget->asTextureProxy();
+    auto clipTexture = clipRenderTarget->asTextureProxy();
+    proxyProvider()->assignProxyUniqueKey(clipTexture, uniqueKey);
     auto clearOp = ClearOp::Make(context, Color::Transparent(), clipRenderTarget->bounds());
     auto opList = drawingBuffer()->makeArray<Op>(2);
     opList[0] = std::move(clearOp);
     opList[1] = std::move(drawOp);
     context->drawingManager()->addOpsRenderTask(std::move(clipRenderTarget), std::move(opList));
-  } else {
-    auto rasterizer =
-        PathRasterizer::MakeFrom(width, height, clip, aaType != AAType::None, &rasterizeMatrix);
-    clipTexture = proxyProvider()->createTextureProxy({}, rasterizer, false, renderFlags);
+    return clipTexture;
   }
-  clipKey = uniqueKey;
-  return clipTexture;
+  auto rasterizer =
+      PathRasterizer::MakeFrom(width, height, clip, aaType != AAType::None, &rasterizeMatrix);
+  return proxyProvider()->createTextureProxy(uniqueKey, rasterizer, false, renderFlags);
+}
+
+static bool GetPolygonPoints(const Path& path, std::vector<Point>* points) {
+  if (path.countVerbs() > static_cast<int>(AAConvexPolyEffect::MaxEdges) + 2) {
+    return false;
+  }
+  bool isPolygon = true;
+  int contourCount = 0;
+  path.decompose([&](PathVerb verb, const Point pts[4], void*) {
+    switch (verb) {
+      case PathVerb::Move:
+        contourCount++;
+        points->push_back(pts[0]);
+        break;
+      case PathVerb::Line:
+        if (pts[1] != points->back()) {
+          points->push_back(pts[1]);
+        }
+        break;
+      case PathVerb::Close:
+        break;
+      default:
+        isPolygon = false;
+        break;
+    }
+  });
+  if (!isPolygon || contourCount != 1) {
+    return false;
+  }
+  if (points->size() > 1 && points->back() == points->front()) {
+    points->pop_back();
+  }
+  return true;
+}
+
+PlacementPtr<FragmentProcessor> OpsCompositor::getAnalyticClipFP(const Path& clip,
+                                                                 AAType aaType) {
+  // The analytic effects are always antialiased, aliased clips keep using masks.
+  if (aaType == AAType::None || clip.isInverseFillType()) {
+    return nullptr;
+  }
+  auto buffer = drawingBuffer();
+  RRect rRect = {};
+  Rect oval = {};
+  if (clip.isOval(&oval)) {
+    rRect.setOval(oval);
+  } else if (!clip.isRRect(&rRect)) {
+    std::vector<Point> points = {};
+    if (!GetPolygonPoints(clip, &points)) {
+      return nullptr;
+    }
+    if (renderTarget->origin() == ImageOrigin::BottomLeft) {
+      renderTarget->getOriginTransform().mapPoints(points.data(), static_cast<int>(points.size()));
+    }
+    return AAConvexPolyEffect::Make(buffer, points);
+  }
+  FlipYIfNeeded(&rRect.rect, renderTarget.get());
+  return AARRectEffect::Make(buffer, rRect);
 }
 
 std::pair<PlacementPtr<FragmentProcessor>, bool> OpsCompositor::getClipMaskFP(const Path& clip,
@@ -571,6 +726,9 @@ std::pair<PlacementPtr<FragmentProcessor>, bool> OpsCompositor::getClipMaskFP(co
   *scissorRect = clipBounds;
   FlipYIfNeeded(scissorRect, renderTarget.get());
   scissorRect->roundOut();
+  if (auto processor = getAnalyticClipFP(clip, aaType)) {
+    return {std::move(processor), true};
+  }
   auto textureProxy = getClipTexture(clip, aaType);
   auto uvMatrix = Matrix::MakeTrans(-clipBounds.left, -clipBounds.top);
   if (renderTarget->origin() == ImageOrigin::BottomLeft) {
@@ -580,16 +738,17 @@ std::pair<PlacementPtr<FragmentProcessor>, bool> OpsCompositor::getClipMaskFP(co
   return {FragmentProcessor::MulInputByChildAlpha(buffer, std::move(processor)), true};
 }
 
-DstTextureInfo OpsCompositor::makeDstTextureInfo(const Rect& deviceBounds, AAType aaType) {
+std::optional<DstTextureInfo> OpsCompositor::makeDstTextureInfo(const Rect& deviceBounds,
+                                                                AAType aaType) {
   auto caps = context->caps();
   if (caps->frameBufferFetchSupport) {
-    return {};
+    return DstTextureInfo{};
   }
   Rect bounds = {};
   auto textureProxy = caps->textureBarrierSupport ? renderTarget->asTextureProxy() : nullptr;
   if (textureProxy == nullptr || renderTarget->sampleCount() > 1) {
     if (deviceBounds.isEmpty()) {
-      return {};
+      return std::nullopt;
     }
     bounds = deviceBounds;
     if (aaType != AAType::None) {
@@ -597,7 +756,7 @@ DstTextureInfo OpsCompositor::makeDstTextureInfo(const Rect& deviceBounds, AATyp
     }
     bounds.roundOut();
     if (!bounds.intersect(renderTarget->bounds())) {
-      return {};
+      return std::nullopt;
     }
     FlipYIfNeeded(&bounds, renderTarget.get());
   }
@@ -613,18 +772,69 @@ DstTextureInfo OpsCompositor::makeDstTextureInfo(const Rect& deviceBounds, AATyp
     dstTextureInfo.requiresBarrier = true;
     return dstTextureInfo;
   }
-  dstTextureInfo.offset = {bounds.x(), bounds.y()};
-  textureProxy = proxyProvider()->createTextureProxy(
+  if (!dstCopyOps.empty() && !Rect::Intersects(dstDirtyBounds, bounds)) {
+    // Nothing inside the bounds has changed since the last copy, so extend that copy instead of
+    // adding a new one.
+    dstCopyOps.back()->addRect(bounds);
+  } else {
+    auto dstTextureCopyOp = DstTextureCopyOp::Make(context, bounds);
+    if (dstTextureCopyOp == nullptr) {
+      return std::nullopt;
+    }
+    dstCopyOps.push_back(dstTextureCopyOp.get());
+    dstDirtyBounds.setEmpty();
+    ops.emplace_back(std::move(dstTextureCopyOp));
+  }
+  // The copy texture is bound in makeDstTexture().
+  return dstTextureInfo;
+}
+
+void OpsCompositor::addDstDirtyBounds(const std::optional<Rect>& deviceBounds, AAType aaType,
+                                      const Rect& scissorRect) {
+  if (dstCopyOps.empty()) {
+    return;
+  }
+  if (!deviceBounds.has_value()) {
+    dstDirtyBounds = renderTarget->bounds();
+    return;
+  }
+  auto bounds = *deviceBounds;
+  if (aaType != AAType::None) {
+    bounds.outset(1.0f, 1.0f);
+  }
+  bounds.roundOut();
+  FlipYIfNeeded(&bounds, renderTarget.get());
+  if (!scissorRect.isEmpty() && !bounds.intersect(scissorRect)) {
+    return;
+  }
+  dstDirtyBounds.join(bounds);
+}
+
+void OpsCompositor::makeDstTexture() {
+  if (dstCopyOps.empty()) {
+    return;
+  }
+  auto bounds = Rect::MakeEmpty();
+  for (auto& copyOp : dstCopyOps) {
+    bounds.join(copyOp->srcRect());
+  }
+  auto textureProxy = proxyProvider()->createTextureProxy(
       {}, static_cast<int>(bounds.width()), static_cast<int>(bounds.height()),
       renderTarget->format(), false, renderTarget->origin(), BackingFit::Approx);
-  auto dstTextureCopyOp = DstTextureCopyOp::Make(textureProxy, static_cast<int>(bounds.x()),
-                                                 static_cast<int>(bounds.y()));
-  if (dstTextureCopyOp == nullptr) {
-    return {};
+  auto offset = Point::Make(bounds.left, bounds.top);
+  for (auto& copyOp : dstCopyOps) {
+    copyOp->setTexture(textureProxy, offset);
   }
-  ops.emplace_back(std::move(dstTextureCopyOp));
-  dstTextureInfo.textureProxy = std::move(textureProxy);
-  return dstTextureInfo;
+  for (auto& xferProcessor : dstTextureReaders) {
+    xferProcessor->setDstTextureInfo({textureProxy, offset});
+  }
+  resetDstCopyState();
+}
+
+void OpsCompositor::resetDstCopyState() {
+  dstCopyOps.clear();
+  dstTextureReaders.clear();
+  dstDirtyBounds.setEmpty();
 }
 
 void OpsCompositor::addDrawOp(PlacementPtr<DrawOp> op, const Path& clip, const Fill& fill,
@@ -653,6 +863,11 @@ void OpsCompositor::addDrawOp(PlacementPtr<DrawOp> op, const Path& clip, const F
       op->addColorFP(std::move(processor));
     }
   }
+  if (isLinearColorSpace()) {
+    // Shading happens in the sRGB-encoded space, only the final color is linearized so that the
+    // coverage and the blending are applied in the linear-light space.
+    op->addColorFP(SRGBToLinearEffect::Make(drawingBuffer()));
+  }
   if (fill.maskFilter) {
     if (auto processor = fill.maskFilter->asFragmentProcessor(args, nullptr)) {
       op->addCoverageFP(std::move(processor));
@@ -674,14 +889,20 @@ void OpsCompositor::addDrawOp(PlacementPtr<DrawOp> op, const Path& clip, const F
   op->setBlendMode(fill.blendMode);
   if (BlendModeNeedDstTexture(fill.blendMode, op->hasCoverage())) {
     auto dstTextureInfo = makeDstTextureInfo(deviceBounds.value_or(Rect::MakeEmpty()), aaType);
-    if (!context->caps()->frameBufferFetchSupport && dstTextureInfo.textureProxy == nullptr) {
+    if (!dstTextureInfo.has_value()) {
       return;
     }
+    auto readsDstCopy =
+        !context->caps()->frameBufferFetchSupport && dstTextureInfo->textureProxy == nullptr;
     auto xferProcessor =
-        PorterDuffXferProcessor::Make(drawingBuffer(), fill.blendMode, std::move(dstTextureInfo));
+        PorterDuffXferProcessor::Make(drawingBuffer(), fill.blendMode, std::move(*dstTextureInfo));
+    if (readsDstCopy) {
+      dstTextureReaders.push_back(xferProcessor.get());
+    }
     op->setXferProcessor(std::move(xferProcessor));
   }
   ops.emplace_back(std::move(op));
+  addDstDirtyBounds(deviceBounds, aaType, scissorRect);
 }
 
 void OpsCompositor::fillTextAtlas(std::shared_ptr<TextureProxy> textureProxy, const Rect& rect,
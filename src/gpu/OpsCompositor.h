@@ -19,13 +19,19 @@
 #pragma once
 
 #include "core/MCState.h"
+#include "gpu/ops/DstTextureCopyOp.h"
 #include "gpu/ops/RRectDrawOp.h"
 #include "gpu/ops/RectDrawOp.h"
+#include "gpu/processors/PorterDuffXferProcessor.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/Fill.h"
 #include "tgfx/core/Shape.h"
 
 namespace tgfx {
+// Maximum number of clip masks kept by an OpsCompositor, so draws alternating between a few clips
+// keep reusing their masks.
+static constexpr size_t MAX_CLIP_MASKS = 4;
+
 enum class PendingOpType {
   Unknown,
   Image,
@@ -103,8 +109,8 @@ class OpsCompositor {
   std::list<std::shared_ptr<OpsCompositor>>::iterator cachedPosition;
   std::shared_ptr<RenderTargetProxy> renderTarget = nullptr;
   uint32_t renderFlags = 0;
-  UniqueKey clipKey = {};
-  std::shared_ptr<TextureProxy> clipTexture = nullptr;
+  // The clip masks built so far, ordered from the most recently used.
+  std::vector<std::pair<UniqueKey, std::shared_ptr<TextureProxy>>> clipMasks = {};
   PendingOpType pendingType = PendingOpType::Unknown;
   Path pendingClip = {};
   Fill pendingFill = {};
@@ -116,9 +122,17 @@ class OpsCompositor {
   std::vector<PlacementPtr<RRectRecord>> pendingRRects = {};
   std::vector<PlacementPtr<Stroke>> pendingStrokes = {};
   std::vector<PlacementPtr<Op>> ops = {};
+  // The dst copies and the xfer processors reading them. They share one scratch texture that only
+  // covers the union of the copied areas, so it is created in makeClosed() once that is known.
+  std::vector<DstTextureCopyOp*> dstCopyOps = {};
+  std::vector<PorterDuffXferProcessor*> dstTextureReaders = {};
+  // The device area modified by ops added after the last dst copy op.
+  Rect dstDirtyBounds = {};
 
   static bool CompareFill(const Fill& a, const Fill& b);
 
+  bool isLinearColorSpace() const;
+
   BlockBuffer* drawingBuffer() const {
     return context->drawingBuffer();
   }
@@ -138,10 +152,17 @@ class OpsCompositor {
                                           bool hasImageFill = false);
   Rect getClipBounds(const Path& clip);
   std::shared_ptr<TextureProxy> getClipTexture(const Path& clip, AAType aaType);
+  std::shared_ptr<TextureProxy> makeClipTexture(const Path& clip, AAType aaType, const Rect& bounds,
+                                                const UniqueKey& uniqueKey);
   std::pair<std::optional<Rect>, bool> getClipRect(const Path& clip);
+  PlacementPtr<FragmentProcessor> getAnalyticClipFP(const Path& clip, AAType aaType);
   std::pair<PlacementPtr<FragmentProcessor>, bool> getClipMaskFP(const Path& clip, AAType aaType,
                                                                  Rect* scissorRect);
-  DstTextureInfo makeDstTextureInfo(const Rect& deviceBounds, AAType aaType);
+  std::optional<DstTextureInfo> makeDstTextureInfo(const Rect& deviceBounds, AAType aaType);
+  void addDstDirtyBounds(const std::optional<Rect>& deviceBounds, AAType aaType,
+                         const Rect& scissorRect);
+  void makeDstTexture();
+  void resetDstCopyState();
   void addDrawOp(PlacementPtr<DrawOp> op, const Path& clip, const Fill& fill,
                  const std::optional<Rect>& localBounds, const std::optional<Rect>& deviceBounds);
 
@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/core/PixelReadback.h"
+#include <cstring>
+#include "gpu/ReadbackBuffer.h"
+#include "tgfx/core/Pixmap.h"
+
+namespace tgfx {
+PixelReadback::PixelReadback(std::shared_ptr<ReadbackBuffer> buffer, const ImageInfo& info,
+                             bool flipY)
+    : _info(info), flipY(flipY), buffer(std::move(buffer)) {
+}
+
+bool PixelReadback::isReady() {
+  return buffer == nullptr || buffer->isFinished();
+}
+
+bool PixelReadback::readPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX, int srcY) {
+  if (dstInfo.isEmpty() || dstPixels == nullptr) {
+    return false;
+  }
+  if (buffer != nullptr && !flipY) {
+    // Read straight from the mapped buffer to avoid an intermediate copy.
+    auto mappedPixels = buffer->map();
+    if (mappedPixels == nullptr) {
+      return false;
+    }
+    auto success = Pixmap(_info, mappedPixels).readPixels(dstInfo, dstPixels, srcX, srcY);
+    buffer->unmap();
+    return success;
+  }
+  if (!resolve()) {
+    return false;
+  }
+  return Pixmap(_info, pixels.data()).readPixels(dstInfo, dstPixels, srcX, srcY);
+}
+
+bool PixelReadback::resolve() {
+  if (buffer == nullptr) {
+    return !pixels.isEmpty();
+  }
+  auto mappedPixels = buffer->map();
+  if (mappedPixels == nullptr) {
+    buffer = nullptr;
+    return false;
+  }
+  pixels.alloc(_info.byteSize());
+  if (flipY) {
+    auto rowBytes = _info.rowBytes();
+    auto rowCount = static_cast<size_t>(_info.height());
+    auto src = static_cast<const uint8_t*>(mappedPixels);
+    auto dst = pixels.bytes();
+    for (size_t i = 0; i < rowCount; i++) {
+      memcpy(dst + (rowCount - i - 1) * rowBytes, src + i * rowBytes, rowBytes);
+    }
+  } else {
+    memcpy(pixels.data(), mappedPixels, pixels.size());
+  }
+  buffer->unmap();
+  // Return the transfer buffer to the cache so that the next readback can reuse it.
+  buffer = nullptr;
+  return true;
+}
+}  // namespace tgfx
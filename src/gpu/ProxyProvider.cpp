@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ProxyProvider.h"
+#include "core/ImageBufferCache.h"
 #include "core/ShapeRasterizer.h"
 #include "core/shapes/MatrixShape.h"
 #include "core/utils/MathExtra.h"
@@ -263,6 +264,10 @@ std::shared_ptr<TextureProxy> ProxyProvider::createTextureProxy(
   if (proxy != nullptr) {
     return proxy;
   }
+  auto bufferCache = ImageBufferCache::GetInstance();
+  if (auto buffer = bufferCache->find(uniqueKey, mipmapped)) {
+    return createTextureProxy(uniqueKey, std::move(buffer), mipmapped, renderFlags);
+  }
   auto width = generator->width();
   auto height = generator->height();
   auto alphaOnly = generator->isAlphaOnly();
@@ -272,7 +277,9 @@ std::shared_ptr<TextureProxy> ProxyProvider::createTextureProxy(
   auto asyncDecoding = false;
 #endif
   // Ensure the image source is retained so it won't be destroyed prematurely during async decoding.
-  auto source = ImageSource::MakeFrom(std::move(generator), !mipmapped, asyncDecoding);
+  std::shared_ptr<DataSource<ImageBuffer>> source =
+      ImageSource::MakeFrom(std::move(generator), !mipmapped, asyncDecoding);
+  source = bufferCache->wrap(uniqueKey, mipmapped, std::move(source));
   return createTextureProxyByImageSource(uniqueKey, std::move(source), width, height, alphaOnly,
                                          mipmapped, renderFlags);
 }
@@ -284,6 +291,11 @@ std::shared_ptr<TextureProxy> ProxyProvider::createTextureProxy(
   if (proxy != nullptr || source == nullptr) {
     return proxy;
   }
+  auto bufferCache = ImageBufferCache::GetInstance();
+  if (auto buffer = bufferCache->find(uniqueKey, mipmapped)) {
+    return createTextureProxy(uniqueKey, std::move(buffer), mipmapped, renderFlags);
+  }
+  source = bufferCache->wrap(uniqueKey, mipmapped, std::move(source));
   return createTextureProxyByImageSource(uniqueKey, std::move(source), width, height, alphaOnly,
                                          mipmapped, renderFlags);
 }
@@ -447,15 +459,8 @@ std::shared_ptr<GPUBufferProxy> ProxyProvider::findOrWrapGPUBufferProxy(
   return proxy;
 }
 
-std::shared_ptr<TextureProxy> ProxyProvider::findOrWrapTextureProxy(const UniqueKey& uniqueKey) {
-  auto proxy = std::static_pointer_cast<TextureProxy>(findProxy(uniqueKey));
-  if (proxy != nullptr) {
-    return proxy;
-  }
-  auto texture = Resource::Find<Texture>(context, uniqueKey);
-  if (texture == nullptr) {
-    return nullptr;
-  }
+std::shared_ptr<TextureProxy> ProxyProvider::WrapTexture(std::shared_ptr<Texture> texture) {
+  std::shared_ptr<TextureProxy> proxy = nullptr;
   if (auto renderTarget = texture->asRenderTarget()) {
     proxy = std::shared_ptr<TextureProxy>(new TextureRenderTargetProxy(
         texture->width(), texture->height(), renderTarget->format(), renderTarget->sampleCount(),
@@ -466,10 +471,55 @@ std::shared_ptr<TextureProxy> ProxyProvider::findOrWrapTextureProxy(const Unique
         texture->width(), texture->height(), format, texture->hasMipmaps(), texture->origin()));
   }
   proxy->resource = std::move(texture);
+  return proxy;
+}
+
+std::shared_ptr<TextureProxy> ProxyProvider::findOrWrapTextureProxy(const UniqueKey& uniqueKey) {
+  auto proxy = std::static_pointer_cast<TextureProxy>(findProxy(uniqueKey));
+  if (proxy != nullptr) {
+    return proxy;
+  }
+  auto texture = Resource::Find<Texture>(context, uniqueKey);
+  if (texture == nullptr) {
+    return nullptr;
+  }
+  proxy = WrapTexture(std::move(texture));
+  addResourceProxy(proxy, uniqueKey);
+  return proxy;
+}
+
+std::shared_ptr<TextureProxy> ProxyProvider::findOrWrapTextureProxy(const UniqueKey& uniqueKey,
+                                                                    int width, int height) {
+  // A proxy found by the key may be in use by other draws, so its size is never changed.
+  auto proxy = std::static_pointer_cast<TextureProxy>(findProxy(uniqueKey));
+  if (proxy != nullptr) {
+    return proxy->width() == width && proxy->height() == height ? proxy : nullptr;
+  }
+  auto texture = Resource::Find<Texture>(context, uniqueKey);
+  if (texture == nullptr || width > texture->width() || height > texture->height()) {
+    return nullptr;
+  }
+  proxy = WrapTexture(std::move(texture));
+  // The texture may have an approximate size, the new proxy only covers the requested area.
+  proxy->_width = width;
+  proxy->_height = height;
   addResourceProxy(proxy, uniqueKey);
   return proxy;
 }
 
+void ProxyProvider::assignProxyUniqueKey(std::shared_ptr<TextureProxy> proxy,
+                                         const UniqueKey& uniqueKey) {
+  if (proxy == nullptr || uniqueKey.empty() || proxy->resource != nullptr) {
+    return;
+  }
+  // Only render target proxies are lazily instantiated from a DefaultTextureProxy here.
+  if (proxy->asRenderTargetProxy() == nullptr) {
+    return;
+  }
+  static_cast<DefaultTextureProxy*>(proxy.get())->uniqueKey = uniqueKey;
+  addResourceProxy(std::move(proxy), uniqueKey);
+}
+
 std::shared_ptr<ResourceProxy> ProxyProvider::findProxy(const UniqueKey& uniqueKey) {
   if (uniqueKey.empty()) {
     return nullptr;
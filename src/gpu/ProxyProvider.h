@@ -50,6 +50,22 @@ class ProxyProvider {
    */
   std::shared_ptr<TextureProxy> findOrWrapTextureProxy(const UniqueKey& uniqueKey);
 
+  /**
+   * Returns the texture proxy for the given UniqueKey if it has the specified width and height. If
+   * only the texture exists, it is wrapped in a new proxy of that size, which may be smaller than
+   * the texture if it was created with an approximate size. Returns nullptr if neither exists or
+   * the size doesn't match.
+   */
+  std::shared_ptr<TextureProxy> findOrWrapTextureProxy(const UniqueKey& uniqueKey, int width,
+                                                       int height);
+
+  /**
+   * Assigns the UniqueKey to a render target proxy that has not been instantiated yet, so that its
+   * texture can be found by the key later. Does nothing if the proxy is already instantiated, as
+   * its texture may be owned by another key.
+   */
+  void assignProxyUniqueKey(std::shared_ptr<TextureProxy> proxy, const UniqueKey& uniqueKey);
+
   /**
    * Creates a GPUBufferProxy for the given Data. The data will be released after being uploaded to
    * the GPU.
@@ -177,6 +193,8 @@ class ProxyProvider {
 
   std::shared_ptr<GPUBufferProxy> findOrWrapGPUBufferProxy(const UniqueKey& uniqueKey);
 
+  static std::shared_ptr<TextureProxy> WrapTexture(std::shared_ptr<Texture> texture);
+
   void addResourceProxy(std::shared_ptr<ResourceProxy> proxy, const UniqueKey& uniqueKey = {});
 
   void uploadSharedVertexBuffer(std::shared_ptr<Data> data);
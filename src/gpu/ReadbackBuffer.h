@@ -0,0 +1,68 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/Resource.h"
+
+namespace tgfx {
+/**
+ * ReadbackBuffer is a GPU-side transfer buffer that receives pixels copied from a render target.
+ * The copy is executed asynchronously by the GPU, call isFinished() to poll its state or map() to
+ * wait for it and access the pixels on the CPU.
+ */
+class ReadbackBuffer : public Resource {
+ public:
+  /**
+   * Creates a new ReadbackBuffer with the specified size in bytes, or returns a recycled one from
+   * the ResourceCache if available. Returns nullptr if the backend does not support asynchronous
+   * readbacks.
+   */
+  static std::shared_ptr<ReadbackBuffer> Make(Context* context, size_t byteSize);
+
+  size_t size() const {
+    return _size;
+  }
+
+  size_t memoryUsage() const override {
+    return _size;
+  }
+
+  /**
+   * Returns true if the GPU has finished copying pixels into the buffer. This method never blocks.
+   */
+  virtual bool isFinished() = 0;
+
+  /**
+   * Waits for the GPU to finish copying pixels and maps the buffer into the CPU address space.
+   * Returns nullptr if the mapping fails. Call unmap() when the returned pixels are no longer used.
+   */
+  virtual const void* map() = 0;
+
+  /**
+   * Releases the CPU mapping obtained by a previous call to map().
+   */
+  virtual void unmap() = 0;
+
+ protected:
+  size_t _size = 0;
+
+  explicit ReadbackBuffer(size_t size) : _size(size) {
+  }
+};
+}  // namespace tgfx
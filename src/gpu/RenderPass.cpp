@@ -83,8 +83,8 @@ void RenderPass::resolve(const Rect& bounds) {
   drawPipelineStatus = DrawPipelineStatus::NotConfigured;
 }
 
-void RenderPass::copyToTexture(Texture* texture, int srcX, int srcY) {
-  onCopyToTexture(texture, srcX, srcY);
+void RenderPass::copyToTexture(Texture* texture, const Rect& srcRect, const Point& dstPoint) {
+  onCopyToTexture(texture, srcRect, dstPoint);
   drawPipelineStatus = DrawPipelineStatus::NotConfigured;
 }
 }  // namespace tgfx
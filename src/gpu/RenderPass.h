@@ -56,7 +56,7 @@ class RenderPass {
   void drawIndexed(PrimitiveType primitiveType, size_t baseIndex, size_t indexCount);
   void clear(const Rect& scissor, Color color);
   void resolve(const Rect& bounds);
-  void copyToTexture(Texture* texture, int srcX, int srcY);
+  void copyToTexture(Texture* texture, const Rect& srcRect, const Point& dstPoint);
 
  protected:
   explicit RenderPass(Context* context) : context(context) {
@@ -70,7 +70,7 @@ class RenderPass {
   virtual void onDraw(PrimitiveType primitiveType, size_t offset, size_t count,
                       bool drawIndexed) = 0;
   virtual void onClear(const Rect& scissor, Color color) = 0;
-  virtual void onCopyToTexture(Texture* texture, int srcX, int srcY) = 0;
+  virtual void onCopyToTexture(Texture* texture, const Rect& srcRect, const Point& dstPoint) = 0;
 
   Context* context = nullptr;
   std::shared_ptr<RenderTarget> _renderTarget = nullptr;
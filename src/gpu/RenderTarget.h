@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "gpu/ReadbackBuffer.h"
 #include "gpu/Texture.h"
 
 namespace tgfx {
@@ -117,5 +118,14 @@ class RenderTarget {
    */
   virtual bool readPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX = 0,
                           int srcY = 0) const = 0;
+
+  /**
+   * Schedules a copy of a rect of pixels into a ReadbackBuffer without waiting for the GPU. The
+   * pixels are stored in the color type of the render target with tightly packed rows, in the
+   * vertical order of the render target's origin. The rect must be contained by the render target
+   * bounds. Returns nullptr if the backend does not support asynchronous readbacks.
+   */
+  virtual std::shared_ptr<ReadbackBuffer> readPixelsAsync(int srcX, int srcY, int width,
+                                                          int height) const = 0;
 };
 }  // namespace tgfx
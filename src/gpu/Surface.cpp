@@ -23,8 +23,37 @@
 #include "core/utils/PixelFormatUtil.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/RenderContext.h"
+#include "skcms.h"
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/Pixmap.h"
+#include "tgfx/core/RenderFlags.h"
 
 namespace tgfx {
+// Three in-flight readbacks are enough to overlap rendering, transferring and consuming frames.
+static constexpr size_t MAX_PENDING_READBACKS = 3;
+
+static const gfx::skcms_ICCProfile* LinearSRGBProfile() {
+  static const auto profile = [] {
+    auto result = *gfx::skcms_sRGB_profile();
+    gfx::skcms_SetTransferFunction(&result, gfx::skcms_Identity_TransferFunction());
+    return result;
+  }();
+  return &profile;
+}
+
+/**
+ * Encodes the premultiplied half float pixels from the linear-light space into the sRGB space in
+ * place.
+ */
+static bool EncodeLinearPixels(const ImageInfo& info, void* pixels) {
+  auto pixelCount = static_cast<size_t>(info.width()) * static_cast<size_t>(info.height());
+  return gfx::skcms_Transform(pixels, gfx::skcms_PixelFormat_RGBA_hhhh,
+                              gfx::skcms_AlphaFormat_PremulAsEncoded, LinearSRGBProfile(), pixels,
+                              gfx::skcms_PixelFormat_RGBA_hhhh,
+                              gfx::skcms_AlphaFormat_PremulAsEncoded, gfx::skcms_sRGB_profile(),
+                              pixelCount);
+}
+
 std::shared_ptr<Surface> Surface::Make(Context* context, int width, int height, bool alphaOnly,
                                        int sampleCount, bool mipmapped, uint32_t renderFlags) {
   return Make(context, width, height, alphaOnly ? ColorType::ALPHA_8 : ColorType::RGBA_8888,
@@ -158,6 +187,12 @@ std::shared_ptr<Image> Surface::makeImageSnapshot() {
     return cachedImage;
   }
   auto renderTarget = renderContext->renderTarget;
+  if ((renderContext->renderFlags & RenderFlags::LinearColorSpace) &&
+      renderTarget->format() == PixelFormat::RGBA_16F) {
+    // Images are expected to hold sRGB-encoded values. Drawing the linear values of this surface
+    // as an image would linearize them a second time.
+    return nullptr;
+  }
   auto drawingManager = getContext()->drawingManager();
   renderContext->flush();
   auto textureProxy = renderTarget->asTextureProxy();
@@ -183,6 +218,25 @@ bool Surface::readPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX, in
     return false;
   }
   auto renderTargetProxy = renderContext->renderTarget;
+  if ((renderContext->renderFlags & RenderFlags::LinearColorSpace) &&
+      renderTargetProxy->format() == PixelFormat::RGBA_16F &&
+      dstInfo.colorType() != ColorType::RGBA_F16) {
+    // Reads the linear values first, then encodes them into the sRGB space before converting them
+    // into the requested color type.
+    auto outPixels = dstInfo.computeOffset(dstPixels, -srcX, -srcY);
+    auto outInfo = dstInfo.makeIntersect(-srcX, -srcY, width(), height());
+    if (outInfo.isEmpty()) {
+      return false;
+    }
+    auto linearInfo = ImageInfo::Make(outInfo.width(), outInfo.height(), ColorType::RGBA_F16);
+    Buffer buffer(linearInfo.byteSize());
+    if (buffer.isEmpty() ||
+        !readPixels(linearInfo, buffer.data(), std::max(srcX, 0), std::max(srcY, 0)) ||
+        !EncodeLinearPixels(linearInfo, buffer.data())) {
+      return false;
+    }
+    return Pixmap(linearInfo, buffer.data()).readPixels(outInfo, outPixels);
+  }
   auto context = renderTargetProxy->getContext();
   context->flush();
   auto texture = renderTargetProxy->getTexture();
@@ -204,6 +258,49 @@ bool Surface::readPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX, in
   return renderTarget->readPixels(dstInfo, dstPixels, srcX, srcY);
 }
 
+std::shared_ptr<PixelReadback> Surface::readPixelsAsync(int srcX, int srcY, int width,
+                                                        int height) {
+  auto left = std::max(srcX, 0);
+  auto top = std::max(srcY, 0);
+  auto right = std::min(srcX + width, this->width());
+  auto bottom = std::min(srcY + height, this->height());
+  if (right <= left || bottom <= top) {
+    return nullptr;
+  }
+  auto renderTargetProxy = renderContext->renderTarget;
+  auto context = renderTargetProxy->getContext();
+  context->flush();
+  auto renderTarget = renderTargetProxy->getRenderTarget();
+  if (renderTarget == nullptr) {
+    return nullptr;
+  }
+  auto readback = pendingReadbacks.begin();
+  while (readback != pendingReadbacks.end()) {
+    auto pending = readback->lock();
+    if (pending == nullptr || !pending->isPending()) {
+      readback = pendingReadbacks.erase(readback);
+    } else {
+      readback++;
+    }
+  }
+  if (pendingReadbacks.size() >= MAX_PENDING_READBACKS) {
+    if (auto oldest = pendingReadbacks.front().lock()) {
+      oldest->resolve();
+    }
+    pendingReadbacks.pop_front();
+  }
+  auto buffer = renderTarget->readPixelsAsync(left, top, right - left, bottom - top);
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  auto colorType = PixelFormatToColorType(renderTarget->format());
+  auto info = ImageInfo::Make(right - left, bottom - top, colorType, AlphaType::Premultiplied);
+  auto flipY = renderTarget->origin() == ImageOrigin::BottomLeft;
+  auto result = std::shared_ptr<PixelReadback>(new PixelReadback(std::move(buffer), info, flipY));
+  pendingReadbacks.push_back(result);
+  return result;
+}
+
 bool Surface::aboutToDraw(bool discardContent) {
   if (cachedImage == nullptr) {
     return true;
@@ -32,10 +32,14 @@ bool Texture::CheckSizeAndFormat(Context* context, int width, int height, PixelF
     return false;
   }
   if (format != PixelFormat::ALPHA_8 && format != PixelFormat::RGBA_8888 &&
-      format != PixelFormat::BGRA_8888) {
+      format != PixelFormat::BGRA_8888 && format != PixelFormat::RGBA_16F) {
     return false;
   }
   auto caps = context->caps();
+  // Half float textures are only available when the backend can also render to them.
+  if (format == PixelFormat::RGBA_16F && !caps->isFormatRenderable(format)) {
+    return false;
+  }
   auto maxTextureSize = caps->maxTextureSize;
   return width <= maxTextureSize && height <= maxTextureSize;
 }
@@ -81,6 +85,26 @@ std::shared_ptr<Texture> Texture::MakeFormat(Context* context, int width, int he
   return texture;
 }
 
+std::shared_ptr<Texture> Texture::MakeCompressed(Context* context, int width, int height,
+                                                 PixelFormat pixelFormat,
+                                                 const std::vector<std::shared_ptr<Data>>& levels,
+                                                 ImageOrigin origin) {
+  if (context == nullptr || width < 1 || height < 1) {
+    return nullptr;
+  }
+  auto maxTextureSize = context->caps()->maxTextureSize;
+  if (width > maxTextureSize || height > maxTextureSize) {
+    return nullptr;
+  }
+  // Compressed textures are immutable once created, so they are not recycled as scratch resources.
+  auto sampler = TextureSampler::MakeCompressed(context, width, height, pixelFormat, levels);
+  if (sampler == nullptr) {
+    return nullptr;
+  }
+  return Resource::AddToCache(context,
+                              new DefaultTexture(std::move(sampler), width, height, origin));
+}
+
 std::shared_ptr<Texture> Texture::MakeFrom(Context* context, const BackendTexture& backendTexture,
                                            ImageOrigin origin, bool adopted) {
   if (context == nullptr || !backendTexture.isValid()) {
@@ -107,6 +107,16 @@ class Texture : public Resource {
                                              PixelFormat pixelFormat, bool mipmapped = false,
                                              ImageOrigin origin = ImageOrigin::TopLeft);
 
+  /**
+   * Creates a new texture from data in a compressed pixel format, such as ETC2 or ASTC. The levels
+   * contain the compressed data of the base level followed by its mipmap levels, if any. Returns
+   * nullptr if any of the parameters is invalid or the backend does not support the format.
+   */
+  static std::shared_ptr<Texture> MakeCompressed(Context* context, int width, int height,
+                                                 PixelFormat pixelFormat,
+                                                 const std::vector<std::shared_ptr<Data>>& levels,
+                                                 ImageOrigin origin = ImageOrigin::TopLeft);
+
   /**
    * Creates a new Texture which wraps the specified backend texture. The caller must ensure the
    * backend texture is valid for the lifetime of returned Texture.
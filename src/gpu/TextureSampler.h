@@ -18,8 +18,10 @@
 
 #pragma once
 
+#include <vector>
 #include "gpu/YUVFormat.h"
 #include "tgfx/core/BytesKey.h"
+#include "tgfx/core/Data.h"
 #include "tgfx/gpu/Context.h"
 #include "tgfx/gpu/PixelFormat.h"
 #include "tgfx/platform/HardwareBuffer.h"
@@ -81,6 +83,17 @@ class TextureSampler {
                                               PixelFormat format = PixelFormat::RGBA_8888,
                                               bool mipmapped = false);
 
+  /**
+   * Creates a new TextureSampler from data in a compressed pixel format. The levels contain the
+   * compressed data of the base level followed by its mipmap levels, if any. Mipmap levels are only
+   * used if the full mipmap chain is provided. Returns nullptr if the format is not supported by
+   * the GPU or any level is smaller than required. The returned sampler cannot be written with
+   * writePixels().
+   */
+  static std::unique_ptr<TextureSampler> MakeCompressed(
+      Context* context, int width, int height, PixelFormat format,
+      const std::vector<std::shared_ptr<Data>>& levels);
+
   virtual ~TextureSampler() = default;
 
   /**
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "UniqueDomain.h"
+#include "core/ImageBufferCache.h"
 
 namespace tgfx {
 static constexpr uint32_t InvalidDomain = 0;
@@ -43,6 +44,11 @@ void UniqueDomain::addReference() {
 
 void UniqueDomain::releaseReference() {
   if (_useCount.fetch_add(-1, std::memory_order_acq_rel) <= 1) {
+    // Skips the locked lookup entirely while the cache is disabled, which is the default.
+    auto imageBufferCache = ImageBufferCache::GetInstance();
+    if (imageBufferCache->cacheLimit() > 0) {
+      imageBufferCache->remove(_uniqueID);
+    }
     delete this;
   }
 }
@@ -18,6 +18,7 @@
 
 #include "YUVTexture.h"
 #include "core/utils/Log.h"
+#include "core/utils/UniqueID.h"
 #include "gpu/GPU.h"
 
 namespace tgfx {
@@ -57,6 +58,38 @@ static void SubmitYUVTexture(Context* context, const YUVData* yuvData,
   }
 }
 
+static ScratchKey ComputeYUVTextureScratchKey(int width, int height, YUVFormat yuvFormat) {
+  static const uint32_t YUVTextureType = UniqueID::Next();
+  BytesKey bytesKey(4);
+  bytesKey.write(YUVTextureType);
+  bytesKey.write(width);
+  bytesKey.write(height);
+  bytesKey.write(static_cast<uint32_t>(yuvFormat));
+  return bytesKey;
+}
+
+std::shared_ptr<YUVTexture> YUVTexture::Make(Context* context, const YUVData* yuvData,
+                                             YUVFormat yuvFormat, YUVColorSpace colorSpace,
+                                             const PixelFormat* formats) {
+  // Video frames of the same size and format usually arrive continuously, so the planes of the
+  // previous frame are recycled from the cache and only receive a sub-image update.
+  auto scratchKey = ComputeYUVTextureScratchKey(yuvData->width(), yuvData->height(), yuvFormat);
+  auto texture = Resource::Find<YUVTexture>(context, scratchKey);
+  if (texture != nullptr) {
+    texture->_colorSpace = colorSpace;
+  } else {
+    auto texturePlanes = MakeTexturePlanes(context, yuvData, formats);
+    if (texturePlanes.empty()) {
+      return nullptr;
+    }
+    auto yuvTexture = new YUVTexture(std::move(texturePlanes), yuvData->width(),
+                                     yuvData->height(), yuvFormat, colorSpace);
+    texture = Resource::AddToCache(context, yuvTexture, scratchKey);
+  }
+  SubmitYUVTexture(context, yuvData, texture->samplers.data());
+  return texture;
+}
+
 std::shared_ptr<Texture> Texture::MakeI420(Context* context, const YUVData* yuvData,
                                            YUVColorSpace colorSpace) {
   if (context == nullptr || yuvData == nullptr ||
@@ -65,15 +98,7 @@ std::shared_ptr<Texture> Texture::MakeI420(Context* context, const YUVData* yuvD
   }
   PixelFormat yuvFormats[YUVData::I420_PLANE_COUNT] = {PixelFormat::GRAY_8, PixelFormat::GRAY_8,
                                                        PixelFormat::GRAY_8};
-  auto texturePlanes = MakeTexturePlanes(context, yuvData, yuvFormats);
-  if (texturePlanes.empty()) {
-    return nullptr;
-  }
-  auto yuvTexture = new YUVTexture(std::move(texturePlanes), yuvData->width(), yuvData->height(),
-                                   YUVFormat::I420, colorSpace);
-  auto texture = std::static_pointer_cast<YUVTexture>(Resource::AddToCache(context, yuvTexture));
-  SubmitYUVTexture(context, yuvData, texture->samplers.data());
-  return texture;
+  return YUVTexture::Make(context, yuvData, YUVFormat::I420, colorSpace, yuvFormats);
 }
 
 std::shared_ptr<Texture> Texture::MakeNV12(Context* context, const YUVData* yuvData,
@@ -83,15 +108,7 @@ std::shared_ptr<Texture> Texture::MakeNV12(Context* context, const YUVData* yuvD
     return nullptr;
   }
   PixelFormat yuvFormats[YUVData::NV12_PLANE_COUNT] = {PixelFormat::GRAY_8, PixelFormat::RG_88};
-  auto texturePlanes = MakeTexturePlanes(context, yuvData, yuvFormats);
-  if (texturePlanes.empty()) {
-    return nullptr;
-  }
-  auto yuvTexture = new YUVTexture(std::move(texturePlanes), yuvData->width(), yuvData->height(),
-                                   YUVFormat::NV12, colorSpace);
-  auto texture = std::static_pointer_cast<YUVTexture>(Resource::AddToCache(context, yuvTexture));
-  SubmitYUVTexture(context, yuvData, texture->samplers.data());
-  return texture;
+  return YUVTexture::Make(context, yuvData, YUVFormat::NV12, colorSpace, yuvFormats);
 }
 
 YUVTexture::YUVTexture(std::vector<std::unique_ptr<TextureSampler>> yuvSamplers, int width,
@@ -79,6 +79,14 @@ class YUVTexture : public Texture {
   }
 
  protected:
+  /**
+   * Creates a YUVTexture with the pixels in the yuvData, reusing the planes of a purgeable
+   * YUVTexture with the same size and format from the cache if available.
+   */
+  static std::shared_ptr<YUVTexture> Make(Context* context, const YUVData* yuvData,
+                                          YUVFormat yuvFormat, YUVColorSpace colorSpace,
+                                          const PixelFormat* formats);
+
   YUVTexture(std::vector<std::unique_ptr<TextureSampler>> yuvSamplers, int width, int height,
              YUVFormat yuvFormat, YUVColorSpace colorSpace);
 
@@ -18,6 +18,7 @@
 
 #include "GLCaps.h"
 #include "GLUtil.h"
+#include "core/utils/PixelFormatUtil.h"
 
 namespace tgfx {
 static GLStandard GetGLStandard(const char* versionString) {
@@ -207,12 +208,18 @@ bool GLCaps::isFormatRenderable(PixelFormat pixelFormat) const {
         return true;
       }
       break;
+    case PixelFormat::RGBA_16F:
+      return pixelFormatMap.count(pixelFormat) > 0;
     default:
       break;
   }
   return false;
 }
 
+bool GLCaps::isCompressedFormatSupported(PixelFormat pixelFormat) const {
+  return IsCompressedPixelFormat(pixelFormat) && pixelFormatMap.count(pixelFormat) > 0;
+}
+
 int GLCaps::getSampleCount(int requestedCount, PixelFormat pixelFormat) const {
   if (requestedCount <= 1) {
     return 1;
@@ -251,6 +258,8 @@ void GLCaps::initGLSupport(const GLInfo& info) {
                             info.hasExtension("GL_NV_texture_barrier");
   }
   semaphoreSupport = version >= GL_VER(3, 2) || info.hasExtension("GL_ARB_sync");
+  asyncReadbackSupport = semaphoreSupport && (version >= GL_VER(3, 0) ||
+                                              info.hasExtension("GL_ARB_map_buffer_range"));
   if (version < GL_VER(1, 3) && !info.hasExtension("GL_ARB_texture_border_clamp")) {
     clampToBorderSupport = false;
   }
@@ -284,6 +293,7 @@ void GLCaps::initGLESSupport(const GLInfo& info) {
     frameBufferFetchRequiresEnablePerSample = true;
   }
   semaphoreSupport = version >= GL_VER(3, 0) || info.hasExtension("GL_APPLE_sync");
+  asyncReadbackSupport = version >= GL_VER(3, 0);
   if (version < GL_VER(3, 2) && !info.hasExtension("GL_EXT_texture_border_clamp") &&
       !info.hasExtension("GL_NV_texture_border_clamp") &&
       !info.hasExtension("GL_OES_texture_border_clamp")) {
@@ -305,6 +315,8 @@ void GLCaps::initWebGLSupport(const GLInfo& info) {
   textureBarrierSupport = false;
   frameBufferFetchSupport = false;
   semaphoreSupport = version >= GL_VER(2, 0);
+  // WebGL has no way to map buffers, getBufferSubData() would block just like readPixels().
+  asyncReadbackSupport = false;
   clampToBorderSupport = false;
   npotTextureTileSupport = version >= GL_VER(2, 0);
   mipmapSupport = npotTextureTileSupport;
@@ -343,6 +355,7 @@ void GLCaps::initFormatMap(const GLInfo& info) {
     pixelFormatMap[PixelFormat::RG_88].format.externalFormat = GL_LUMINANCE_ALPHA;
     pixelFormatMap[PixelFormat::RG_88].readSwizzle = Swizzle::RARA();
   }
+  initHalfFloatFormat(info);
   // ES 2.0 requires that the internal/external formats match.
   bool useSizedTexFormats =
       (standard == GLStandard::GL || (standard == GLStandard::GLES && version >= GL_VER(3, 0)) ||
@@ -359,9 +372,94 @@ void GLCaps::initFormatMap(const GLInfo& info) {
       info.hasExtension("GL_EXT_texture_format_BGRA8888")) {
     pixelFormatMap[PixelFormat::BGRA_8888].format.internalFormatTexImage = GL_RGBA;
   }
+  initCompressedFormats(info);
   initColorSampleCount(info);
 }
 
+void GLCaps::initHalfFloatFormat(const GLInfo& info) {
+  bool halfFloatSupport = false;
+  unsigned halfFloatType = GL_HALF_FLOAT;
+  switch (standard) {
+    case GLStandard::GL:
+      halfFloatSupport = version >= GL_VER(3, 0) || info.hasExtension("GL_ARB_texture_float");
+      break;
+    case GLStandard::GLES:
+      if (version >= GL_VER(3, 0)) {
+        halfFloatSupport = version >= GL_VER(3, 2) ||
+                           info.hasExtension("GL_EXT_color_buffer_half_float") ||
+                           info.hasExtension("GL_EXT_color_buffer_float");
+      } else {
+        // ES 2.0 only accepts the OES half float type with the unsized RGBA format.
+        halfFloatSupport = info.hasExtension("GL_OES_texture_half_float") &&
+                           info.hasExtension("GL_EXT_color_buffer_half_float");
+        halfFloatType = GL_HALF_FLOAT_OES;
+      }
+      break;
+    case GLStandard::WebGL:
+      halfFloatSupport = version >= GL_VER(2, 0) &&
+                         (info.hasExtension("EXT_color_buffer_float") ||
+                          info.hasExtension("GL_EXT_color_buffer_float"));
+      break;
+    default:
+      break;
+  }
+  if (!halfFloatSupport) {
+    return;
+  }
+  auto& configInfo = pixelFormatMap[PixelFormat::RGBA_16F];
+  configInfo.format.sizedFormat = GL_RGBA16F;
+  configInfo.format.externalFormat = GL_RGBA;
+  configInfo.format.externalType = halfFloatType;
+  configInfo.readSwizzle = Swizzle::RGBA();
+}
+
+void GLCaps::initCompressedFormats(const GLInfo& info) {
+  bool etc2Support = false;
+  bool astcSupport = false;
+  bool s3tcSupport = false;
+  switch (standard) {
+    case GLStandard::GL:
+      etc2Support = version >= GL_VER(4, 3) || info.hasExtension("GL_ARB_ES3_compatibility");
+      astcSupport = info.hasExtension("GL_KHR_texture_compression_astc_ldr");
+      s3tcSupport = info.hasExtension("GL_EXT_texture_compression_s3tc");
+      break;
+    case GLStandard::GLES:
+      etc2Support = version >= GL_VER(3, 0);
+      astcSupport = info.hasExtension("GL_KHR_texture_compression_astc_ldr");
+      s3tcSupport = info.hasExtension("GL_EXT_texture_compression_s3tc");
+      break;
+    case GLStandard::WebGL:
+      etc2Support = info.hasExtension("WEBGL_compressed_texture_etc") ||
+                    info.hasExtension("GL_WEBGL_compressed_texture_etc");
+      astcSupport = info.hasExtension("WEBGL_compressed_texture_astc") ||
+                    info.hasExtension("GL_WEBGL_compressed_texture_astc");
+      s3tcSupport = info.hasExtension("WEBGL_compressed_texture_s3tc") ||
+                    info.hasExtension("GL_WEBGL_compressed_texture_s3tc");
+      break;
+    default:
+      break;
+  }
+  std::vector<std::pair<PixelFormat, unsigned>> compressedFormats = {};
+  if (etc2Support) {
+    compressedFormats.emplace_back(PixelFormat::ETC2_RGB8, GL_COMPRESSED_RGB8_ETC2);
+    compressedFormats.emplace_back(PixelFormat::ETC2_RGBA8, GL_COMPRESSED_RGBA8_ETC2);
+  }
+  if (astcSupport) {
+    compressedFormats.emplace_back(PixelFormat::ASTC_4x4, GL_COMPRESSED_RGBA_ASTC_4x4);
+  }
+  if (s3tcSupport) {
+    compressedFormats.emplace_back(PixelFormat::BC1_RGBA, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+    compressedFormats.emplace_back(PixelFormat::BC3_RGBA, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+  }
+  for (auto& [pixelFormat, glFormat] : compressedFormats) {
+    auto& configInfo = pixelFormatMap[pixelFormat];
+    // Compressed formats have no external format, they are always uploaded with the sized format.
+    configInfo.format.sizedFormat = glFormat;
+    configInfo.format.internalFormatTexImage = glFormat;
+    configInfo.readSwizzle = Swizzle::RGBA();
+  }
+}
+
 static bool UsesInternalformatQuery(GLStandard standard, const GLInfo& glInterface,
                                     uint32_t version) {
   return (standard == GLStandard::GL &&
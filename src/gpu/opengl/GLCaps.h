@@ -39,6 +39,7 @@ struct TextureFormat {
   unsigned internalFormatTexImage = 0;
   unsigned internalFormatRenderBuffer = 0;
   unsigned externalFormat = 0;
+  unsigned externalType = GL_UNSIGNED_BYTE;
 };
 
 struct ConfigInfo {
@@ -116,6 +117,10 @@ class GLCaps : public Caps {
   bool packRowLengthSupport = false;
   bool unpackRowLengthSupport = false;
   bool textureRedSupport = false;
+  /**
+   * Can pixels be read into a pixel pack buffer and mapped later after a fence signals?
+   */
+  bool asyncReadbackSupport = false;
   MSFBOType msFBOType = MSFBOType::None;
   bool blitRectsMustMatchForMSAASrc = false;
   bool frameBufferFetchRequiresEnablePerSample = false;
@@ -135,6 +140,8 @@ class GLCaps : public Caps {
 
   bool isFormatRenderable(PixelFormat pixelFormat) const override;
 
+  bool isCompressedFormatSupported(PixelFormat pixelFormat) const override;
+
   int getSampleCount(int requestedCount, PixelFormat pixelFormat) const override;
 
   int getMaxMipmapLevel(int width, int height) const override;
@@ -154,6 +161,8 @@ class GLCaps : public Caps {
   std::unordered_map<PixelFormat, ConfigInfo, EnumHasher> pixelFormatMap = {};
 
   void initFormatMap(const GLInfo& info);
+  void initHalfFloatFormat(const GLInfo& info);
+  void initCompressedFormats(const GLInfo& info);
   void initColorSampleCount(const GLInfo& info);
   void initGLSupport(const GLInfo& info);
   void initGLESSupport(const GLInfo& info);
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLGPU.h"
+#include <algorithm>
 #include "GLUtil.h"
 #include "core/utils/PixelFormatUtil.h"
 #include "gpu/opengl/GLRenderTarget.h"
@@ -95,17 +96,26 @@ void GLGPU::bindTexture(int unitIndex, const TextureSampler* sampler, SamplerSta
   gl->texParameteri(target, GL_TEXTURE_MAG_FILTER, FilterToGLMagFilter(samplerState.filterMode));
 }
 
-void GLGPU::copyRenderTargetToTexture(const RenderTarget* renderTarget, Texture* texture, int srcX,
-                                      int srcY) {
-  auto width = std::min(texture->width(), renderTarget->width() - srcX);
-  auto height = std::min(texture->height(), renderTarget->height() - srcY);
+void GLGPU::copyRenderTargetToTexture(const RenderTarget* renderTarget, Texture* texture,
+                                      const Rect& srcRect, const Point& dstPoint) {
+  auto srcX = static_cast<int>(srcRect.left);
+  auto srcY = static_cast<int>(srcRect.top);
+  auto dstX = static_cast<int>(dstPoint.x);
+  auto dstY = static_cast<int>(dstPoint.y);
+  auto width = std::min({static_cast<int>(srcRect.width()), texture->width() - dstX,
+                         renderTarget->width() - srcX});
+  auto height = std::min({static_cast<int>(srcRect.height()), texture->height() - dstY,
+                          renderTarget->height() - srcY});
+  if (width <= 0 || height <= 0) {
+    return;
+  }
   auto gl = GLFunctions::Get(context);
   auto glRenderTarget = static_cast<const GLRenderTarget*>(renderTarget);
   gl->bindFramebuffer(GL_FRAMEBUFFER, glRenderTarget->readFrameBufferID());
   auto glSampler = static_cast<const GLTextureSampler*>(texture->getSampler());
   auto target = glSampler->target();
   gl->bindTexture(target, glSampler->id());
-  gl->copyTexSubImage2D(target, 0, 0, 0, srcX, srcY, width, height);
+  gl->copyTexSubImage2D(target, 0, dstX, dstY, srcX, srcY, width, height);
 }
 
 void GLGPU::resolveRenderTarget(RenderTarget* renderTarget, const Rect& bounds) {
@@ -28,8 +28,8 @@ class GLGPU : public GPU {
 
   void bindTexture(int unitIndex, const TextureSampler* sampler, SamplerState samplerState = {});
 
-  void copyRenderTargetToTexture(const RenderTarget* renderTarget, Texture* texture, int srcX,
-                                 int srcY) override;
+  void copyRenderTargetToTexture(const RenderTarget* renderTarget, Texture* texture,
+                                 const Rect& srcRect, const Point& dstPoint) override;
 
   void resolveRenderTarget(RenderTarget* renderTarget, const Rect& bounds) override;
 
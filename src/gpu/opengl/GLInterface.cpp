@@ -109,6 +109,8 @@ std::unique_ptr<const GLInterface> GLInterface::MakeNativeInterface(const GLProc
       reinterpret_cast<GLBufferSubData*>(getter->getProcAddress("glBufferSubData"));
   functions->checkFramebufferStatus = reinterpret_cast<GLCheckFramebufferStatus*>(
       getter->getProcAddress("glCheckFramebufferStatus"));
+  functions->clientWaitSync =
+      reinterpret_cast<GLClientWaitSync*>(getter->getProcAddress("glClientWaitSync"));
   functions->clear = reinterpret_cast<GLClear*>(getter->getProcAddress("glClear"));
   functions->clearColor = reinterpret_cast<GLClearColor*>(getter->getProcAddress("glClearColor"));
   functions->clearDepthf =
@@ -209,6 +211,8 @@ std::unique_ptr<const GLInterface> GLInterface::MakeNativeInterface(const GLProc
   functions->lineWidth = reinterpret_cast<GLLineWidth*>(getter->getProcAddress("glLineWidth"));
   functions->linkProgram =
       reinterpret_cast<GLLinkProgram*>(getter->getProcAddress("glLinkProgram"));
+  functions->mapBufferRange =
+      reinterpret_cast<GLMapBufferRange*>(getter->getProcAddress("glMapBufferRange"));
   functions->pixelStorei =
       reinterpret_cast<GLPixelStorei*>(getter->getProcAddress("glPixelStorei"));
   functions->readPixels = reinterpret_cast<GLReadPixels*>(getter->getProcAddress("glReadPixels"));
@@ -263,6 +267,8 @@ std::unique_ptr<const GLInterface> GLInterface::MakeNativeInterface(const GLProc
       reinterpret_cast<GLUniformMatrix3fv*>(getter->getProcAddress("glUniformMatrix3fv"));
   functions->uniformMatrix4fv =
       reinterpret_cast<GLUniformMatrix4fv*>(getter->getProcAddress("glUniformMatrix4fv"));
+  functions->unmapBuffer =
+      reinterpret_cast<GLUnmapBuffer*>(getter->getProcAddress("glUnmapBuffer"));
   functions->useProgram = reinterpret_cast<GLUseProgram*>(getter->getProcAddress("glUseProgram"));
   functions->vertexAttrib1f =
       reinterpret_cast<GLVertexAttrib1f*>(getter->getProcAddress("glVertexAttrib1f"));
@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLReadbackBuffer.h"
+#include "GLUtil.h"
+#include "core/utils/UniqueID.h"
+
+namespace tgfx {
+// One second, the fence is polled repeatedly until it signals or the wait fails.
+static constexpr uint64_t FENCE_WAIT_TIMEOUT_NS = 1000000000;
+
+static ScratchKey ComputeReadbackBufferScratchKey(size_t byteSize) {
+  static const uint32_t ReadbackBufferType = UniqueID::Next();
+  BytesKey bytesKey(3);
+  bytesKey.write(ReadbackBufferType);
+  auto size = static_cast<uint64_t>(byteSize);
+  bytesKey.write(static_cast<uint32_t>(size & 0xFFFFFFFF));
+  bytesKey.write(static_cast<uint32_t>(size >> 32));
+  return bytesKey;
+}
+
+std::shared_ptr<ReadbackBuffer> ReadbackBuffer::Make(Context* context, size_t byteSize) {
+  if (context == nullptr || byteSize == 0 || !GLCaps::Get(context)->asyncReadbackSupport) {
+    return nullptr;
+  }
+  auto scratchKey = ComputeReadbackBufferScratchKey(byteSize);
+  if (auto buffer = Resource::Find<GLReadbackBuffer>(context, scratchKey)) {
+    return buffer;
+  }
+  // Clear the GL errors generated by the previous operations.
+  ClearGLError(context);
+  auto gl = GLFunctions::Get(context);
+  unsigned bufferID = 0;
+  gl->genBuffers(1, &bufferID);
+  if (bufferID == 0) {
+    return nullptr;
+  }
+  auto buffer = Resource::AddToCache(context, new GLReadbackBuffer(byteSize, bufferID), scratchKey);
+  gl->bindBuffer(GL_PIXEL_PACK_BUFFER, bufferID);
+  gl->bufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(byteSize), nullptr,
+                 GL_STREAM_READ);
+  gl->bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  if (!CheckGLError(context)) {
+    return nullptr;
+  }
+  return buffer;
+}
+
+void GLReadbackBuffer::insertFence() {
+  deleteFence();
+  auto gl = GLFunctions::Get(context);
+  glSync = gl->fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  // Make sure the transfer is submitted, otherwise polling the fence may never succeed.
+  gl->flush();
+}
+
+bool GLReadbackBuffer::isFinished() {
+  if (glSync == nullptr) {
+    return true;
+  }
+  auto gl = GLFunctions::Get(context);
+  auto result = gl->clientWaitSync(glSync, 0, 0);
+  if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+    deleteFence();
+    return true;
+  }
+  return false;
+}
+
+const void* GLReadbackBuffer::map() {
+  auto gl = GLFunctions::Get(context);
+  if (glSync != nullptr) {
+    unsigned result = GL_TIMEOUT_EXPIRED;
+    while (result == GL_TIMEOUT_EXPIRED) {
+      result = gl->clientWaitSync(glSync, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_TIMEOUT_NS);
+    }
+    deleteFence();
+    if (result == GL_WAIT_FAILED) {
+      return nullptr;
+    }
+  }
+  gl->bindBuffer(GL_PIXEL_PACK_BUFFER, _bufferID);
+  auto pixels = gl->mapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(_size),
+                                   GL_MAP_READ_BIT);
+  if (pixels == nullptr) {
+    gl->bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  }
+  return pixels;
+}
+
+void GLReadbackBuffer::unmap() {
+  auto gl = GLFunctions::Get(context);
+  gl->bindBuffer(GL_PIXEL_PACK_BUFFER, _bufferID);
+  gl->unmapBuffer(GL_PIXEL_PACK_BUFFER);
+  gl->bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void GLReadbackBuffer::deleteFence() {
+  if (glSync != nullptr) {
+    auto gl = GLFunctions::Get(context);
+    gl->deleteSync(glSync);
+    glSync = nullptr;
+  }
+}
+
+void GLReadbackBuffer::onReleaseGPU() {
+  deleteFence();
+  if (_bufferID > 0) {
+    auto gl = GLFunctions::Get(context);
+    gl->deleteBuffers(1, &_bufferID);
+    _bufferID = 0;
+  }
+}
+}  // namespace tgfx
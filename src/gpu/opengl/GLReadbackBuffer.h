@@ -0,0 +1,59 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/ReadbackBuffer.h"
+
+namespace tgfx {
+/**
+ * A ReadbackBuffer backed by an OpenGL pixel pack buffer and guarded by a fence sync object.
+ */
+class GLReadbackBuffer : public ReadbackBuffer {
+ public:
+  unsigned bufferID() const {
+    return _bufferID;
+  }
+
+  /**
+   * Inserts a fence after the pending pixel transfer into this buffer. Any previous fence is
+   * discarded.
+   */
+  void insertFence();
+
+  bool isFinished() override;
+
+  const void* map() override;
+
+  void unmap() override;
+
+ protected:
+  void onReleaseGPU() override;
+
+ private:
+  unsigned _bufferID = 0;
+  void* glSync = nullptr;
+
+  GLReadbackBuffer(size_t size, unsigned bufferID) : ReadbackBuffer(size), _bufferID(bufferID) {
+  }
+
+  void deleteFence();
+
+  friend class ReadbackBuffer;
+};
+}  // namespace tgfx
@@ -194,17 +194,17 @@ void GLRenderPass::onClear(const Rect& scissor, Color color) {
   gl->clear(GL_COLOR_BUFFER_BIT);
 }
 
-void GLRenderPass::onCopyToTexture(Texture* texture, int srcX, int srcY) {
+void GLRenderPass::onCopyToTexture(Texture* texture, const Rect& srcRect,
+                                   const Point& dstPoint) {
   auto gpu = context->gpu();
   if (_renderTarget->sampleCount() > 1) {
-    if (copyAsBlit(texture, srcX, srcY)) {
+    if (copyAsBlit(texture, srcRect, dstPoint)) {
       texture->getSampler()->regenerateMipmapLevels(context);
       return;
     }
-    auto bounds = Rect::MakeXYWH(srcX, srcY, texture->width(), texture->height());
-    gpu->resolveRenderTarget(_renderTarget.get(), bounds);
+    gpu->resolveRenderTarget(_renderTarget.get(), srcRect);
   }
-  gpu->copyRenderTargetToTexture(_renderTarget.get(), texture, srcX, srcY);
+  gpu->copyRenderTargetToTexture(_renderTarget.get(), texture, srcRect, dstPoint);
   texture->getSampler()->regenerateMipmapLevels(context);
   // Reset the render target after the copy operation.
   auto gl = GLFunctions::Get(context);
@@ -212,12 +212,13 @@ void GLRenderPass::onCopyToTexture(Texture* texture, int srcX, int srcY) {
                       static_cast<GLRenderTarget*>(_renderTarget.get())->drawFrameBufferID());
 }
 
-bool GLRenderPass::copyAsBlit(Texture* texture, int srcX, int srcY) {
+bool GLRenderPass::copyAsBlit(Texture* texture, const Rect& srcRect, const Point& dstPoint) {
   auto caps = GLCaps::Get(context);
   if (!caps->usesMSAARenderBuffers() || caps->msFBOType == MSFBOType::ES_Apple) {
     return false;
   }
-  if (caps->blitRectsMustMatchForMSAASrc && (srcX != 0 || srcY != 0)) {
+  if (caps->blitRectsMustMatchForMSAASrc &&
+      (srcRect.left != dstPoint.x || srcRect.top != dstPoint.y)) {
     return false;
   }
   auto glSampler = static_cast<const GLTextureSampler*>(texture->getSampler());
@@ -246,10 +247,14 @@ bool GLRenderPass::copyAsBlit(Texture* texture, int srcX, int srcY) {
   gl->bindFramebuffer(GL_READ_FRAMEBUFFER, sourceFrameBufferID);
   gl->bindFramebuffer(GL_DRAW_FRAMEBUFFER, frameBuffer->id());
   gl->disable(GL_SCISSOR_TEST);
-  auto right = srcX + texture->width();
-  auto bottom = srcY + texture->height();
-  gl->blitFramebuffer(srcX, srcY, right, bottom, 0, 0, texture->width(), texture->height(),
-                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  auto srcX = static_cast<int>(srcRect.left);
+  auto srcY = static_cast<int>(srcRect.top);
+  auto dstX = static_cast<int>(dstPoint.x);
+  auto dstY = static_cast<int>(dstPoint.y);
+  auto width = std::min(static_cast<int>(srcRect.width()), texture->width() - dstX);
+  auto height = std::min(static_cast<int>(srcRect.height()), texture->height() - dstY);
+  gl->blitFramebuffer(srcX, srcY, srcX + width, srcY + height, dstX, dstY, dstX + width,
+                      dstY + height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
   if (!CheckGLError(context)) {
     gl->bindFramebuffer(GL_FRAMEBUFFER, sourceFrameBufferID);
     return false;
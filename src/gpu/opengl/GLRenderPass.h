@@ -38,12 +38,12 @@ class GLRenderPass : public RenderPass {
   void onDraw(PrimitiveType primitiveType, size_t baseVertex, size_t count,
               bool drawIndexed) override;
   void onClear(const Rect& scissor, Color color) override;
-  void onCopyToTexture(Texture* texture, int srcX, int srcY) override;
+  void onCopyToTexture(Texture* texture, const Rect& srcRect, const Point& dstPoint) override;
 
  private:
   std::shared_ptr<GLVertexArray> vertexArray = nullptr;
   std::shared_ptr<GLFrameBuffer> frameBuffer = nullptr;
 
-  bool copyAsBlit(Texture* texture, int srcX, int srcY);
+  bool copyAsBlit(Texture* texture, const Rect& srcRect, const Point& dstPoint);
 };
 }  // namespace tgfx
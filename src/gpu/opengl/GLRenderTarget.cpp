@@ -18,7 +18,9 @@
 
 #include "GLRenderTarget.h"
 #include "core/utils/PixelFormatUtil.h"
+#include "gpu/opengl/GLReadbackBuffer.h"
 #include "gpu/opengl/GLUtil.h"
+#include "skcms.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Pixmap.h"
 
@@ -36,6 +38,29 @@ static bool CanReadDirectly(Context* context, ImageOrigin origin, const ImageInf
   return true;
 }
 
+/**
+ * Returns the pixel type used to read back the currently bound framebuffer. GLES and WebGL only
+ * guarantee GL_FLOAT for half float color buffers, so the half float type is used only if the
+ * implementation reports it as the preferred read type.
+ */
+static unsigned GetReadPixelType(const GLFunctions* gl, const GLCaps* caps,
+                                 const TextureFormat& textureFormat) {
+  auto pixelType = textureFormat.externalType;
+  if (caps->standard == GLStandard::GL ||
+      (pixelType != GL_HALF_FLOAT && pixelType != GL_HALF_FLOAT_OES)) {
+    return pixelType;
+  }
+  int readFormat = 0;
+  int readType = 0;
+  gl->getIntegerv(GL_IMPLEMENTATION_COLOR_READ_FORMAT, &readFormat);
+  gl->getIntegerv(GL_IMPLEMENTATION_COLOR_READ_TYPE, &readType);
+  if (static_cast<unsigned>(readFormat) == GL_RGBA &&
+      static_cast<unsigned>(readType) == pixelType) {
+    return pixelType;
+  }
+  return GL_FLOAT;
+}
+
 static void CopyPixels(const ImageInfo& srcInfo, const void* srcPixels, const ImageInfo& dstInfo,
                        void* dstPixels, bool flipY) {
   auto pixels = srcPixels;
@@ -75,6 +100,8 @@ bool GLRenderTarget::readPixels(const ImageInfo& dstInfo, void* dstPixels, int s
   auto caps = GLCaps::Get(context);
   const auto& textureFormat = caps->getTextureFormat(format());
   gl->bindFramebuffer(GL_FRAMEBUFFER, readFrameBufferID());
+  auto pixelType = GetReadPixelType(gl, caps, textureFormat);
+  auto readAsFloat = pixelType != textureFormat.externalType;
 
   auto colorType = PixelFormatToColorType(format());
   auto srcInfo =
@@ -82,7 +109,7 @@ bool GLRenderTarget::readPixels(const ImageInfo& dstInfo, void* dstPixels, int s
   void* pixels = nullptr;
   Buffer tempBuffer = {};
   auto restoreGLRowLength = false;
-  if (CanReadDirectly(context, origin(), srcInfo, outInfo)) {
+  if (!readAsFloat && CanReadDirectly(context, origin(), srcInfo, outInfo)) {
     pixels = dstPixels;
     if (outInfo.rowBytes() != outInfo.minRowBytes()) {
       gl->pixelStorei(GL_PACK_ROW_LENGTH,
@@ -101,8 +128,25 @@ bool GLRenderTarget::readPixels(const ImageInfo& dstInfo, void* dstPixels, int s
   if (flipY) {
     readY = height() - readY - outInfo.height();
   }
-  gl->readPixels(readX, readY, outInfo.width(), outInfo.height(), textureFormat.externalFormat,
-                 GL_UNSIGNED_BYTE, pixels);
+  if (readAsFloat) {
+    // Reads the pixels as floats, then converts them into half floats.
+    auto pixelCount = static_cast<size_t>(outInfo.width()) * static_cast<size_t>(outInfo.height());
+    Buffer floatBuffer(pixelCount * 4 * sizeof(float));
+    if (floatBuffer.isEmpty()) {
+      return false;
+    }
+    gl->readPixels(readX, readY, outInfo.width(), outInfo.height(), textureFormat.externalFormat,
+                   GL_FLOAT, floatBuffer.data());
+    if (!gfx::skcms_Transform(floatBuffer.data(), gfx::skcms_PixelFormat_RGBA_ffff,
+                              gfx::skcms_AlphaFormat_PremulAsEncoded, nullptr, pixels,
+                              gfx::skcms_PixelFormat_RGBA_hhhh,
+                              gfx::skcms_AlphaFormat_PremulAsEncoded, nullptr, pixelCount)) {
+      return false;
+    }
+  } else {
+    gl->readPixels(readX, readY, outInfo.width(), outInfo.height(), textureFormat.externalFormat,
+                   textureFormat.externalType, pixels);
+  }
   if (restoreGLRowLength) {
     gl->pixelStorei(GL_PACK_ROW_LENGTH, 0);
   }
@@ -112,4 +156,40 @@ bool GLRenderTarget::readPixels(const ImageInfo& dstInfo, void* dstPixels, int s
   return true;
 }
 
+std::shared_ptr<ReadbackBuffer> GLRenderTarget::readPixelsAsync(int srcX, int srcY, int width,
+                                                                int height) const {
+  auto context = getContext();
+  auto colorType = PixelFormatToColorType(format());
+  auto info = ImageInfo::Make(width, height, colorType, AlphaType::Premultiplied);
+  if (info.isEmpty()) {
+    return nullptr;
+  }
+  auto buffer = ReadbackBuffer::Make(context, info.byteSize());
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  auto gl = GLFunctions::Get(context);
+  auto caps = GLCaps::Get(context);
+  const auto& textureFormat = caps->getTextureFormat(format());
+  auto glBuffer = std::static_pointer_cast<GLReadbackBuffer>(buffer);
+  gl->bindFramebuffer(GL_FRAMEBUFFER, readFrameBufferID());
+  if (GetReadPixelType(gl, caps, textureFormat) != textureFormat.externalType) {
+    // The buffer is consumed in the render target's own pixel format, which can't be read back
+    // directly here.
+    return nullptr;
+  }
+  gl->bindBuffer(GL_PIXEL_PACK_BUFFER, glBuffer->bufferID());
+  auto alignment = format() == PixelFormat::ALPHA_8 ? 1 : 4;
+  gl->pixelStorei(GL_PACK_ALIGNMENT, alignment);
+  auto readY = srcY;
+  if (origin() == ImageOrigin::BottomLeft) {
+    readY = this->height() - srcY - height;
+  }
+  // With a pixel pack buffer bound, the last argument is an offset into the buffer.
+  gl->readPixels(srcX, readY, width, height, textureFormat.externalFormat,
+                 textureFormat.externalType, nullptr);
+  gl->bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  glBuffer->insertFence();
+  return buffer;
+}
 }  // namespace tgfx
@@ -42,5 +42,8 @@ class GLRenderTarget : public RenderTarget {
 
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels, int srcX = 0,
                   int srcY = 0) const override;
+
+  std::shared_ptr<ReadbackBuffer> readPixelsAsync(int srcX, int srcY, int width,
+                                                  int height) const override;
 };
 }  // namespace tgfx
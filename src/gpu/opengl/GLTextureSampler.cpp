@@ -84,8 +84,56 @@ std::unique_ptr<TextureSampler> TextureSampler::Make(Context* context, int width
     const int currentWidth = std::max(1, width / twoToTheMipLevel);
     const int currentHeight = std::max(1, height / twoToTheMipLevel);
     gl->texImage2D(target, level, static_cast<int>(textureFormat.internalFormatTexImage),
-                   currentWidth, currentHeight, 0, textureFormat.externalFormat, GL_UNSIGNED_BYTE,
-                   nullptr);
+                   currentWidth, currentHeight, 0, textureFormat.externalFormat,
+                   textureFormat.externalType, nullptr);
+    success = CheckGLError(context);
+  }
+  if (!success) {
+    gl->deleteTextures(1, &samplerID);
+    return nullptr;
+  }
+  return std::make_unique<GLTextureSampler>(samplerID, target, format, maxMipmapLevel);
+}
+
+std::unique_ptr<TextureSampler> TextureSampler::MakeCompressed(
+    Context* context, int width, int height, PixelFormat format,
+    const std::vector<std::shared_ptr<Data>>& levels) {
+  auto caps = GLCaps::Get(context);
+  if (levels.empty() || !caps->isCompressedFormatSupported(format)) {
+    return nullptr;
+  }
+  int maxMipmapLevel = 0;
+  if (caps->mipmapSupport &&
+      static_cast<int>(levels.size()) == caps->getMaxMipmapLevel(width, height) + 1) {
+    maxMipmapLevel = static_cast<int>(levels.size()) - 1;
+  }
+  ClearGLError(context);
+  auto gl = GLFunctions::Get(context);
+  unsigned target = GL_TEXTURE_2D;
+  unsigned samplerID = 0;
+  gl->genTextures(1, &samplerID);
+  if (samplerID == 0) {
+    return nullptr;
+  }
+  gl->bindTexture(target, samplerID);
+  gl->texParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  gl->texParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  gl->texParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  gl->texParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  const auto& textureFormat = caps->getTextureFormat(format);
+  bool success = true;
+  for (int level = 0; level <= maxMipmapLevel && success; level++) {
+    const int twoToTheMipLevel = 1 << level;
+    const int currentWidth = std::max(1, width / twoToTheMipLevel);
+    const int currentHeight = std::max(1, height / twoToTheMipLevel);
+    auto byteSize = CompressedDataSize(format, currentWidth, currentHeight);
+    auto& data = levels[static_cast<size_t>(level)];
+    if (data == nullptr || data->size() < byteSize) {
+      success = false;
+      break;
+    }
+    gl->compressedTexImage2D(target, level, textureFormat.internalFormatTexImage, currentWidth,
+                             currentHeight, 0, static_cast<int>(byteSize), data->data());
     success = CheckGLError(context);
   }
   if (!success) {
@@ -121,6 +169,10 @@ void GLTextureSampler::writePixels(Context* context, const Rect& rect, const voi
   if (context == nullptr || rect.isEmpty()) {
     return;
   }
+  if (IsCompressedPixelFormat(_format)) {
+    LOGE("GLTextureSampler::writePixels() Compressed textures can not be written.");
+    return;
+  }
   auto gl = GLFunctions::Get(context);
   // https://skia-review.googlesource.com/c/skia/+/571418
   // HUAWEI nova9 pro(Adreno 642L), iqoo neo5(Adreno 650), Redmi K30pro(Adreno 650),
@@ -139,17 +191,18 @@ void GLTextureSampler::writePixels(Context* context, const Rect& rect, const voi
     // the number of pixels, not bytes
     gl->pixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<int>(rowBytes / bytesPerPixel));
     gl->texSubImage2D(_target, 0, x, y, width, height, textureFormat.externalFormat,
-                      GL_UNSIGNED_BYTE, pixels);
+                      textureFormat.externalType, pixels);
     gl->pixelStorei(GL_UNPACK_ROW_LENGTH, 0);
   } else {
     if (static_cast<size_t>(width) * bytesPerPixel == rowBytes) {
       gl->texSubImage2D(_target, 0, x, y, width, height, textureFormat.externalFormat,
-                        GL_UNSIGNED_BYTE, pixels);
+                        textureFormat.externalType, pixels);
     } else {
       auto data = reinterpret_cast<const uint8_t*>(pixels);
       for (int row = 0; row < height; ++row) {
         gl->texSubImage2D(_target, 0, x, y + row, width, 1, textureFormat.externalFormat,
-                          GL_UNSIGNED_BYTE, data + (static_cast<size_t>(row) * rowBytes));
+                          textureFormat.externalType,
+                          data + (static_cast<size_t>(row) * rowBytes));
       }
     }
   }
@@ -157,7 +210,8 @@ void GLTextureSampler::writePixels(Context* context, const Rect& rect, const voi
 
 void GLTextureSampler::regenerateMipmapLevels(Context* context) {
   DEBUG_ASSERT(context != nullptr);
-  if (_maxMipmapLevel <= 0 || _target != GL_TEXTURE_2D) {
+  // Compressed textures carry their own mipmap levels and can't be rendered to.
+  if (_maxMipmapLevel <= 0 || _target != GL_TEXTURE_2D || IsCompressedPixelFormat(_format)) {
     return;
   }
   auto gl = GLFunctions::Get(context);
@@ -36,6 +36,18 @@ PixelFormat GLSizeFormatToPixelFormat(unsigned sizeFormat) {
     case GL_RG8:
     case GL_RG:
       return PixelFormat::RG_88;
+    case GL_RGBA16F:
+      return PixelFormat::RGBA_16F;
+    case GL_COMPRESSED_RGB8_ETC2:
+      return PixelFormat::ETC2_RGB8;
+    case GL_COMPRESSED_RGBA8_ETC2:
+      return PixelFormat::ETC2_RGBA8;
+    case GL_COMPRESSED_RGBA_ASTC_4x4:
+      return PixelFormat::ASTC_4x4;
+    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+      return PixelFormat::BC1_RGBA;
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+      return PixelFormat::BC3_RGBA;
     default:
       break;
   }
@@ -52,6 +64,18 @@ unsigned PixelFormatToGLSizeFormat(PixelFormat pixelFormat) {
       return GL_RG8;
     case PixelFormat::BGRA_8888:
       return GL_BGRA8;
+    case PixelFormat::RGBA_16F:
+      return GL_RGBA16F;
+    case PixelFormat::ETC2_RGB8:
+      return GL_COMPRESSED_RGB8_ETC2;
+    case PixelFormat::ETC2_RGBA8:
+      return GL_COMPRESSED_RGBA8_ETC2;
+    case PixelFormat::ASTC_4x4:
+      return GL_COMPRESSED_RGBA_ASTC_4x4;
+    case PixelFormat::BC1_RGBA:
+      return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case PixelFormat::BC3_RGBA:
+      return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
     default:
       break;
   }
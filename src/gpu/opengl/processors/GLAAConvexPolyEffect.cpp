@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLAAConvexPolyEffect.h"
+#include "core/utils/MathExtra.h"
+
+namespace tgfx {
+static float Cross(const Point& a, const Point& b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+PlacementPtr<AAConvexPolyEffect> AAConvexPolyEffect::Make(BlockBuffer* buffer,
+                                                          const std::vector<Point>& points) {
+  auto count = points.size();
+  if (count < 3 || count > MaxEdges) {
+    return nullptr;
+  }
+  float area = 0.0f;
+  for (size_t i = 0; i < count; i++) {
+    area += Cross(points[i], points[(i + 1) % count]);
+  }
+  if (FloatNearlyZero(area)) {
+    return nullptr;
+  }
+  // Flip the normals of clockwise polygons so they always point inwards.
+  auto sign = area > 0 ? 1.0f : -1.0f;
+  float edges[3 * MaxEdges] = {};
+  for (size_t i = 0; i < count; i++) {
+    auto& start = points[i];
+    auto& end = points[(i + 1) % count];
+    auto dx = end.x - start.x;
+    auto dy = end.y - start.y;
+    auto length = sqrtf(dx * dx + dy * dy);
+    if (FloatNearlyZero(length)) {
+      return nullptr;
+    }
+    auto a = -dy * sign / length;
+    auto b = dx * sign / length;
+    edges[3 * i] = a;
+    edges[3 * i + 1] = b;
+    edges[3 * i + 2] = -(a * start.x + b * start.y);
+  }
+  // A polygon is convex if none of its vertices lies outside any edge, which also rejects
+  // self-intersecting ones such as pentagrams.
+  for (size_t i = 0; i < count; i++) {
+    for (auto& point : points) {
+      if (edges[3 * i] * point.x + edges[3 * i + 1] * point.y + edges[3 * i + 2] < -0.01f) {
+        return nullptr;
+      }
+    }
+  }
+  return buffer->make<GLAAConvexPolyEffect>(count, edges);
+}
+
+GLAAConvexPolyEffect::GLAAConvexPolyEffect(size_t edgeCount, const float edges[])
+    : AAConvexPolyEffect(edgeCount, edges) {
+}
+
+void GLAAConvexPolyEffect::emitCode(EmitArgs& args) const {
+  auto* fragBuilder = args.fragBuilder;
+  auto* uniformHandler = args.uniformHandler;
+
+  fragBuilder->codeAppend("float coverage = 1.0;");
+  for (size_t i = 0; i < edgeCount; i++) {
+    auto edgeName = uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float3,
+                                               "Edge" + std::to_string(i));
+    fragBuilder->codeAppendf("coverage *= clamp(dot(%s, vec3(gl_FragCoord.xy, 1.0)), 0.0, 1.0);",
+                             edgeName.c_str());
+  }
+  fragBuilder->codeAppendf("%s = %s * coverage;", args.outputColor.c_str(),
+                           args.inputColor.c_str());
+}
+
+void GLAAConvexPolyEffect::onSetData(UniformBuffer* uniformBuffer) const {
+  for (size_t i = 0; i < edgeCount; i++) {
+    // Offset each edge by half a pixel, so the coverage goes from 0 at a half pixel outside the
+    // edge to 1 at a half pixel inside.
+    float edge[3] = {edges[3 * i], edges[3 * i + 1], edges[3 * i + 2] + 0.5f};
+    uniformBuffer->setData("Edge" + std::to_string(i), edge);
+  }
+}
+}  // namespace tgfx
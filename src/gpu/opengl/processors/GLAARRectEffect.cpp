@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLAARRectEffect.h"
+
+namespace tgfx {
+// Below half a pixel the squared inverse radii lose too much precision in the shader.
+static constexpr float MinRadius = 0.5f;
+
+PlacementPtr<AARRectEffect> AARRectEffect::Make(BlockBuffer* buffer, const RRect& rRect) {
+  if (rRect.radii.x < MinRadius || rRect.radii.y < MinRadius) {
+    return nullptr;
+  }
+  return buffer->make<GLAARRectEffect>(rRect);
+}
+
+GLAARRectEffect::GLAARRectEffect(const RRect& rRect) : AARRectEffect(rRect) {
+}
+
+void GLAARRectEffect::emitCode(EmitArgs& args) const {
+  auto* fragBuilder = args.fragBuilder;
+  auto* uniformHandler = args.uniformHandler;
+
+  auto innerRectName =
+      uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float4, "InnerRect");
+  auto invRadiiName =
+      uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float2, "InvRadiiSqd");
+  // Outside the inner rect, the distance to the corner ellipse is approximated by the implicit
+  // function divided by the length of its gradient. The straight edges fall out of the same math.
+  fragBuilder->codeAppendf("vec2 dxy0 = %s.xy - gl_FragCoord.xy;", innerRectName.c_str());
+  fragBuilder->codeAppendf("vec2 dxy1 = gl_FragCoord.xy - %s.zw;", innerRectName.c_str());
+  fragBuilder->codeAppend("vec2 dxy = max(max(dxy0, dxy1), 0.0);");
+  fragBuilder->codeAppendf("vec2 Z = dxy * %s;", invRadiiName.c_str());
+  fragBuilder->codeAppend("float implicit = dot(Z, dxy) - 1.0;");
+  fragBuilder->codeAppend("float gradDot = max(4.0 * dot(Z, Z), 1.0e-4);");
+  fragBuilder->codeAppend("float approxDist = implicit * inversesqrt(gradDot);");
+  fragBuilder->codeAppend("float coverage = clamp(0.5 - approxDist, 0.0, 1.0);");
+  fragBuilder->codeAppendf("%s = %s * coverage;", args.outputColor.c_str(),
+                           args.inputColor.c_str());
+}
+
+void GLAARRectEffect::onSetData(UniformBuffer* uniformBuffer) const {
+  auto innerRect = rRect.rect.makeInset(rRect.radii.x, rRect.radii.y);
+  uniformBuffer->setData("InnerRect", innerRect);
+  auto invRadiiSqd = Point::Make(1.0f / (rRect.radii.x * rRect.radii.x),
+                                 1.0f / (rRect.radii.y * rRect.radii.y));
+  uniformBuffer->setData("InvRadiiSqd", invRadiiSqd);
+}
+}  // namespace tgfx
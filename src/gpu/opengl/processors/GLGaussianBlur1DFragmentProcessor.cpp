@@ -22,7 +22,7 @@ namespace tgfx {
 
 PlacementPtr<FragmentProcessor> GaussianBlur1DFragmentProcessor::Make(
     BlockBuffer* buffer, PlacementPtr<FragmentProcessor> processor, float sigma,
-    GaussianBlurDirection direction, float stepLength, int maxSigma) {
+    GaussianBlurDirection direction, float stepLength, int maxSigma, bool mergeTaps) {
   if (!processor) {
     return nullptr;
   }
@@ -34,14 +34,15 @@ PlacementPtr<FragmentProcessor> GaussianBlur1DFragmentProcessor::Make(
   }
 
   return buffer->make<GLGaussianBlur1DFragmentProcessor>(
-      std::move(processor), sigma, direction, stepLength, static_cast<int>(ceil(maxSigma)));
+      std::move(processor), sigma, direction, stepLength, static_cast<int>(ceil(maxSigma)),
+      mergeTaps);
 }
 
 GLGaussianBlur1DFragmentProcessor::GLGaussianBlur1DFragmentProcessor(
     PlacementPtr<FragmentProcessor> processor, float sigma, GaussianBlurDirection direction,
-    float stepLength, int maxSigma)
-    : GaussianBlur1DFragmentProcessor(std::move(processor), sigma, direction, stepLength,
-                                      maxSigma) {
+    float stepLength, int maxSigma, bool mergeTaps)
+    : GaussianBlur1DFragmentProcessor(std::move(processor), sigma, direction, stepLength, maxSigma,
+                                      mergeTaps) {
 }
 
 void GLGaussianBlur1DFragmentProcessor::emitCode(EmitArgs& args) const {
@@ -59,18 +60,35 @@ void GLGaussianBlur1DFragmentProcessor::emitCode(EmitArgs& args) const {
   fragBuilder->codeAppend("vec4 sum = vec4(0.0);");
   fragBuilder->codeAppend("float total = 0.0;");
 
-  fragBuilder->codeAppendf("for (int j = 0; j <= %d; ++j) {", 4 * maxSigma);
-  fragBuilder->codeAppend("int i = j - radius;");
-  fragBuilder->codeAppend("float weight = exp(-float(i*i) / (2.0*sigma*sigma));");
+  if (mergeTaps) {
+    // Adjacent taps are merged into one bilinear fetch placed between them in proportion to their
+    // weights, which halves the number of texture samples.
+    fragBuilder->codeAppendf("for (int j = 0; j <= %d; ++j) {", 2 * maxSigma);
+    fragBuilder->codeAppend("float i = float(2 * j) - float(radius);");
+    fragBuilder->codeAppend("float weight0 = exp(-(i*i) / (2.0*sigma*sigma));");
+    fragBuilder->codeAppend(
+        "float weight1 = i < float(radius) ? exp(-((i+1.0)*(i+1.0)) / (2.0*sigma*sigma)) : 0.0;");
+    fragBuilder->codeAppend("float weight = weight0 + weight1;");
+    fragBuilder->codeAppend("float tapOffset = i + weight1 / weight;");
+  } else {
+    fragBuilder->codeAppendf("for (int j = 0; j <= %d; ++j) {", 4 * maxSigma);
+    fragBuilder->codeAppend("float i = float(j - radius);");
+    fragBuilder->codeAppend("float weight = exp(-(i*i) / (2.0*sigma*sigma));");
+    fragBuilder->codeAppend("float tapOffset = i;");
+  }
   fragBuilder->codeAppend("total += weight;");
 
   std::string tempColor = "tempColor";
   emitChild(0, &tempColor, args, [](std::string_view coord) {
-    return "(" + std::string(coord) + " + offset * float(i))";
+    return "(" + std::string(coord) + " + offset * tapOffset)";
   });
 
   fragBuilder->codeAppendf("sum += %s * weight;", tempColor.c_str());
-  fragBuilder->codeAppend("if (i == radius) { break; }");
+  if (mergeTaps) {
+    fragBuilder->codeAppend("if (i + 1.0 >= float(radius)) { break; }");
+  } else {
+    fragBuilder->codeAppend("if (i >= float(radius)) { break; }");
+  }
   fragBuilder->codeAppend("}");
   fragBuilder->codeAppendf("%s = sum / total;", args.outputColor.c_str());
 }
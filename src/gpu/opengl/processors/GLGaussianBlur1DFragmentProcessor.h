@@ -25,8 +25,8 @@ namespace tgfx {
 class GLGaussianBlur1DFragmentProcessor : public GaussianBlur1DFragmentProcessor {
  public:
   GLGaussianBlur1DFragmentProcessor(PlacementPtr<FragmentProcessor> processor, float sigma,
-                                    GaussianBlurDirection direction, float stepLength,
-                                    int maxSigma);
+                                    GaussianBlurDirection direction, float stepLength, int maxSigma,
+                                    bool mergeTaps);
 
   void emitCode(EmitArgs& args) const override;
 
@@ -0,0 +1,39 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLSRGBToLinearEffect.h"
+
+namespace tgfx {
+PlacementPtr<SRGBToLinearEffect> SRGBToLinearEffect::Make(BlockBuffer* buffer) {
+  return buffer->make<GLSRGBToLinearEffect>();
+}
+
+void GLSRGBToLinearEffect::emitCode(EmitArgs& args) const {
+  auto* fragBuilder = args.fragBuilder;
+  fragBuilder->codeAppendf("vec4 srgbColor = %s;", args.inputColor.c_str());
+  fragBuilder->codeAppend("float srgbAlpha = srgbColor.a;");
+  // The transfer function applies to unpremultiplied values.
+  fragBuilder->codeAppend(
+      "vec3 srgb = srgbAlpha > 0.0 ? clamp(srgbColor.rgb / srgbAlpha, 0.0, 1.0) : vec3(0.0);");
+  fragBuilder->codeAppend("vec3 linearLow = srgb / 12.92;");
+  fragBuilder->codeAppend("vec3 linearHigh = pow((srgb + 0.055) / 1.055, vec3(2.4));");
+  fragBuilder->codeAppend("vec3 linearRGB = mix(linearLow, linearHigh, step(0.04045, srgb));");
+  fragBuilder->codeAppendf("%s = vec4(linearRGB * srgbAlpha, srgbAlpha);",
+                           args.outputColor.c_str());
+}
+}  // namespace tgfx
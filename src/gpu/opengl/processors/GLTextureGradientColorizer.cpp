@@ -20,22 +20,31 @@
 
 namespace tgfx {
 PlacementPtr<TextureGradientColorizer> TextureGradientColorizer::Make(
-    BlockBuffer* buffer, std::shared_ptr<TextureProxy> gradient) {
+    BlockBuffer* buffer, std::shared_ptr<TextureProxy> gradient, int row) {
   if (gradient == nullptr) {
     return nullptr;
   }
-  return buffer->make<GLTextureGradientColorizer>(std::move(gradient));
+  return buffer->make<GLTextureGradientColorizer>(std::move(gradient), row);
 }
 
-GLTextureGradientColorizer::GLTextureGradientColorizer(std::shared_ptr<TextureProxy> gradient)
-    : TextureGradientColorizer(std::move(gradient)) {
+GLTextureGradientColorizer::GLTextureGradientColorizer(std::shared_ptr<TextureProxy> gradient,
+                                                       int row)
+    : TextureGradientColorizer(std::move(gradient), row) {
 }
 
 void GLTextureGradientColorizer::emitCode(EmitArgs& args) const {
   auto* fragBuilder = args.fragBuilder;
-  fragBuilder->codeAppendf("vec2 coord = vec2(%s.x, 0.5);", args.inputColor.c_str());
+  auto rowName = args.uniformHandler->addUniform(ShaderFlags::Fragment, SLType::Float, "Row");
+  fragBuilder->codeAppendf("vec2 coord = vec2(%s.x, %s);", args.inputColor.c_str(),
+                           rowName.c_str());
   fragBuilder->codeAppendf("%s = ", args.outputColor.c_str());
   fragBuilder->appendTextureLookup((*args.textureSamplers)[0], "coord");
   fragBuilder->codeAppend(";");
 }
+
+void GLTextureGradientColorizer::onSetData(UniformBuffer* uniformBuffer) const {
+  // Samples the center of the row, so neighboring rows never bleed in.
+  auto rowCoord = (static_cast<float>(row) + 0.5f) / static_cast<float>(gradient->height());
+  uniformBuffer->setData("Row", rowCoord);
+}
 }  // namespace tgfx
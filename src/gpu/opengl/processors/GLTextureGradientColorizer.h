@@ -23,8 +23,11 @@
 namespace tgfx {
 class GLTextureGradientColorizer : public TextureGradientColorizer {
  public:
-  explicit GLTextureGradientColorizer(std::shared_ptr<TextureProxy> gradient);
+  GLTextureGradientColorizer(std::shared_ptr<TextureProxy> gradient, int row);
 
   void emitCode(EmitArgs& args) const override;
+
+ private:
+  void onSetData(UniformBuffer* uniformBuffer) const override;
 };
 }  // namespace tgfx
@@ -22,26 +22,21 @@
 #include "gpu/RenderPass.h"
 
 namespace tgfx {
-PlacementPtr<DstTextureCopyOp> DstTextureCopyOp::Make(std::shared_ptr<TextureProxy> textureProxy,
-                                                      int srcX, int srcY) {
-  if (textureProxy == nullptr) {
+PlacementPtr<DstTextureCopyOp> DstTextureCopyOp::Make(Context* context, const Rect& srcRect) {
+  if (srcRect.isEmpty()) {
     return nullptr;
   }
-  auto drawingBuffer = textureProxy->getContext()->drawingBuffer();
-  return drawingBuffer->make<DstTextureCopyOp>(std::move(textureProxy), srcX, srcY);
-}
-
-DstTextureCopyOp::DstTextureCopyOp(std::shared_ptr<TextureProxy> textureProxy, int srcX, int srcY)
-    : textureProxy(std::move(textureProxy)), srcX(srcX), srcY(srcY) {
+  return context->drawingBuffer()->make<DstTextureCopyOp>(srcRect);
 }
 
 void DstTextureCopyOp::execute(RenderPass* renderPass) {
-  auto texture = textureProxy->getTexture();
+  auto texture = textureProxy ? textureProxy->getTexture() : nullptr;
   if (texture == nullptr) {
     LOGE("CopyOp::execute() Failed to get the dest texture!");
     return;
   }
-  renderPass->copyToTexture(texture.get(), srcX, srcY);
+  auto dstPoint = Point::Make(_srcRect.left - textureOffset.x, _srcRect.top - textureOffset.y);
+  renderPass->copyToTexture(texture.get(), _srcRect, dstPoint);
 }
 
 }  // namespace tgfx
@@ -23,21 +23,46 @@
 
 namespace tgfx {
 /**
- * DstTextureCopyOp is an operation that copies a portion of a render target to the given texture.
+ * DstTextureCopyOp is an operation that copies a portion of a render target to a texture. The
+ * texture is assigned after the op is created, once the area it needs to cover is known.
  */
 class DstTextureCopyOp : public Op {
  public:
-  static PlacementPtr<DstTextureCopyOp> Make(std::shared_ptr<TextureProxy> textureProxy, int srcX,
-                                             int srcY);
+  static PlacementPtr<DstTextureCopyOp> Make(Context* context, const Rect& srcRect);
+
+  /**
+   * Returns the area of the render target to copy.
+   */
+  const Rect& srcRect() const {
+    return _srcRect;
+  }
+
+  /**
+   * Expands the area to copy so that it also covers the given rect. This allows multiple draws
+   * reading back from the render target to share a single copy.
+   */
+  void addRect(const Rect& rect) {
+    _srcRect.join(rect);
+  }
+
+  /**
+   * Sets the texture to copy into. The texture covers the area of the render target starting at
+   * the given offset.
+   */
+  void setTexture(std::shared_ptr<TextureProxy> proxy, const Point& offset) {
+    textureProxy = std::move(proxy);
+    textureOffset = offset;
+  }
 
   void execute(RenderPass* renderPass) override;
 
  private:
   std::shared_ptr<TextureProxy> textureProxy = nullptr;
-  int srcX = 0;
-  int srcY = 0;
+  Point textureOffset = {};
+  Rect _srcRect = {};
 
-  DstTextureCopyOp(std::shared_ptr<TextureProxy> textureProxy, int srcX, int srcY);
+  explicit DstTextureCopyOp(const Rect& srcRect) : _srcRect(srcRect) {
+  }
 
   friend class BlockBuffer;
 };
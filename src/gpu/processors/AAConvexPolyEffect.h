@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/processors/FragmentProcessor.h"
+
+namespace tgfx {
+/**
+ * AAConvexPolyEffect computes the antialiased coverage of a small convex polygon in device space
+ * analytically, by multiplying the coverage of each edge.
+ */
+class AAConvexPolyEffect : public FragmentProcessor {
+ public:
+  static constexpr size_t MaxEdges = 8;
+
+  /**
+   * Creates an AAConvexPolyEffect for the polygon formed by the given points in device space, in
+   * either winding order. Returns nullptr if the points do not form a convex polygon with at most
+   * MaxEdges edges.
+   */
+  static PlacementPtr<AAConvexPolyEffect> Make(BlockBuffer* buffer,
+                                               const std::vector<Point>& points);
+
+  std::string name() const override {
+    return "AAConvexPolyEffect";
+  }
+
+  void onComputeProcessorKey(BytesKey* bytesKey) const override;
+
+ protected:
+  DEFINE_PROCESSOR_CLASS_ID
+
+  AAConvexPolyEffect(size_t edgeCount, const float edges[]);
+
+  size_t edgeCount = 0;
+  // The line equations (a, b, c) of the edges, where a * x + b * y + c is the signed distance to
+  // the edge and is positive inside the polygon.
+  float edges[3 * MaxEdges] = {};
+};
+}  // namespace tgfx
@@ -0,0 +1,49 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/processors/FragmentProcessor.h"
+#include "tgfx/core/RRect.h"
+
+namespace tgfx {
+/**
+ * AARRectEffect computes the antialiased coverage of a rounded rect or an oval in device space
+ * analytically, so the clip needs no mask texture.
+ */
+class AARRectEffect : public FragmentProcessor {
+ public:
+  /**
+   * Creates an AARRectEffect for the given rounded rect in device space. Returns nullptr if the
+   * radii are too small to be evaluated precisely.
+   */
+  static PlacementPtr<AARRectEffect> Make(BlockBuffer* buffer, const RRect& rRect);
+
+  std::string name() const override {
+    return "AARRectEffect";
+  }
+
+ protected:
+  DEFINE_PROCESSOR_CLASS_ID
+
+  explicit AARRectEffect(const RRect& rRect) : FragmentProcessor(ClassID()), rRect(rRect) {
+  }
+
+  RRect rRect = {};
+};
+}  // namespace tgfx
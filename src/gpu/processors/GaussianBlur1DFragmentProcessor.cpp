@@ -22,14 +22,15 @@ namespace tgfx {
 
 GaussianBlur1DFragmentProcessor::GaussianBlur1DFragmentProcessor(
     PlacementPtr<FragmentProcessor> processor, float sigma, GaussianBlurDirection direction,
-    float stepLength, int maxSigma)
+    float stepLength, int maxSigma, bool mergeTaps)
     : FragmentProcessor(ClassID()), sigma(sigma), direction(direction), stepLength(stepLength),
-      maxSigma(maxSigma) {
+      maxSigma(maxSigma), mergeTaps(mergeTaps) {
   registerChildProcessor(std::move(processor));
 }
 
 void GaussianBlur1DFragmentProcessor::onComputeProcessorKey(BytesKey* key) const {
   key->write(maxSigma);
+  key->write(static_cast<uint32_t>(mergeTaps));
 }
 
 }  // namespace tgfx
\ No newline at end of file
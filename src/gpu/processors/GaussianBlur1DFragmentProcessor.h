@@ -29,7 +29,8 @@ class GaussianBlur1DFragmentProcessor : public FragmentProcessor {
   static PlacementPtr<FragmentProcessor> Make(BlockBuffer* buffer,
                                               PlacementPtr<FragmentProcessor> processor,
                                               float sigma, GaussianBlurDirection direction,
-                                              float stepLength, int maxSigma);
+                                              float stepLength, int maxSigma,
+                                              bool mergeTaps);
 
   std::string name() const override {
     return "GaussianBlur1DFragmentProcessor";
@@ -39,7 +40,8 @@ class GaussianBlur1DFragmentProcessor : public FragmentProcessor {
   DEFINE_PROCESSOR_CLASS_ID
 
   GaussianBlur1DFragmentProcessor(PlacementPtr<FragmentProcessor> processor, float sigma,
-                                  GaussianBlurDirection direction, float stepLength, int maxSigma);
+                                  GaussianBlurDirection direction, float stepLength, int maxSigma,
+                                  bool mergeTaps);
 
   void onComputeProcessorKey(BytesKey*) const override;
 
@@ -47,5 +49,8 @@ class GaussianBlur1DFragmentProcessor : public FragmentProcessor {
   GaussianBlurDirection direction = GaussianBlurDirection::Horizontal;
   float stepLength = 1.f;
   int maxSigma = 10;
+  // Whether adjacent taps are merged into one bilinear fetch, which is only exact when each step
+  // moves by exactly one texel of the child.
+  bool mergeTaps = false;
 };
 }  // namespace tgfx
\ No newline at end of file
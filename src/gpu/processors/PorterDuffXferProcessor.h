@@ -34,6 +34,14 @@ class PorterDuffXferProcessor : public XferProcessor {
 
   const Texture* dstTexture() const override;
 
+  /**
+   * Replaces the dst texture info. This is used to bind a dst copy texture that is created after
+   * the processor.
+   */
+  void setDstTextureInfo(DstTextureInfo info) {
+    dstTextureInfo = std::move(info);
+  }
+
   bool requiresBarrier() const override {
     return dstTextureInfo.requiresBarrier;
   }
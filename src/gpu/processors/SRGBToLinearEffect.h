@@ -0,0 +1,42 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/processors/FragmentProcessor.h"
+
+namespace tgfx {
+/**
+ * SRGBToLinearEffect converts its premultiplied input color from the sRGB-encoded space into the
+ * linear-light space, using the sRGB transfer function.
+ */
+class SRGBToLinearEffect : public FragmentProcessor {
+ public:
+  static PlacementPtr<SRGBToLinearEffect> Make(BlockBuffer* buffer);
+
+  std::string name() const override {
+    return "SRGBToLinearEffect";
+  }
+
+ protected:
+  DEFINE_PROCESSOR_CLASS_ID
+
+  SRGBToLinearEffect() : FragmentProcessor(ClassID()) {
+  }
+};
+}  // namespace tgfx
@@ -24,8 +24,12 @@
 namespace tgfx {
 class TextureGradientColorizer : public FragmentProcessor {
  public:
+  /**
+   * Creates a colorizer that samples the gradient from the specified row of the texture.
+   */
   static PlacementPtr<TextureGradientColorizer> Make(BlockBuffer* buffer,
-                                                     std::shared_ptr<TextureProxy> gradient);
+                                                     std::shared_ptr<TextureProxy> gradient,
+                                                     int row = 0);
 
   std::string name() const override {
     return "TextureGradientColorizer";
@@ -34,8 +38,8 @@ class TextureGradientColorizer : public FragmentProcessor {
  protected:
   DEFINE_PROCESSOR_CLASS_ID
 
-  explicit TextureGradientColorizer(std::shared_ptr<TextureProxy> gradient)
-      : FragmentProcessor(ClassID()), gradient(std::move(gradient)) {
+  TextureGradientColorizer(std::shared_ptr<TextureProxy> gradient, int row)
+      : FragmentProcessor(ClassID()), gradient(std::move(gradient)), row(row) {
   }
 
   size_t onCountTextureSamplers() const override {
@@ -48,5 +52,6 @@ class TextureGradientColorizer : public FragmentProcessor {
   }
 
   std::shared_ptr<TextureProxy> gradient;
+  int row = 0;
 };
 }  // namespace tgfx
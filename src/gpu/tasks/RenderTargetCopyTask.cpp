@@ -38,7 +38,9 @@ bool RenderTargetCopyTask::execute(RenderPass* renderPass) {
   DEBUG_ASSERT(renderTarget->width() == texture->width() &&
                renderTarget->height() == texture->height());
   auto context = renderPass->getContext();
-  context->gpu()->copyRenderTargetToTexture(renderTarget.get(), texture.get(), 0, 0);
+  auto srcRect = Rect::MakeWH(texture->width(), texture->height());
+  context->gpu()->copyRenderTargetToTexture(renderTarget.get(), texture.get(), srcRect,
+                                            Point::Zero());
   texture->getSampler()->regenerateMipmapLevels(context);
   return true;
 }
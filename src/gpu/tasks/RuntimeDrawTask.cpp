@@ -26,64 +26,109 @@
 #include "gpu/RuntimeProgramWrapper.h"
 #include "gpu/processors/DefaultGeometryProcessor.h"
 #include "gpu/processors/TextureEffect.h"
+#include "gpu/tasks/TextureResolveTask.h"
 #include "tgfx/core/RenderFlags.h"
 
 namespace tgfx {
 RuntimeDrawTask::RuntimeDrawTask(std::shared_ptr<RenderTargetProxy> target,
                                  std::vector<std::shared_ptr<TextureProxy>> inputs,
                                  std::shared_ptr<RuntimeEffect> effect, const Point& offset)
-    : RenderTask(std::move(target)), inputTextures(std::move(inputs)), effect(std::move(effect)),
-      offset(offset) {
-  auto context = renderTargetProxy->getContext();
-  inputVertexBuffers.reserve(inputTextures.size());
-  for (auto& input : inputTextures) {
-    if (input != nullptr) {
-      auto maskRect = Rect::MakeWH(input->width(), input->height());
-      auto maskVertexProvider =
-          RectsVertexProvider::MakeFrom(context->drawingBuffer(), maskRect, AAType::None);
-      auto maskBuffer = context->proxyProvider()->createVertexBuffer(std::move(maskVertexProvider),
-                                                                     RenderFlags::DisableAsyncTask);
-      inputVertexBuffers.push_back(std::move(maskBuffer));
-    } else {
-      inputVertexBuffers.push_back(nullptr);
-    }
+    : RenderTask(target) {
+  addRun(std::move(target), std::move(inputs), std::move(effect), offset);
+}
+
+bool RuntimeDrawTask::addRun(std::shared_ptr<RenderTargetProxy> target,
+                             std::vector<std::shared_ptr<TextureProxy>> inputs,
+                             std::shared_ptr<RuntimeEffect> effect, const Point& offset) {
+  if (!runs.empty() && runs.front().effect->programID() != effect->programID()) {
+    return false;
+  }
+  auto context = target->getContext();
+  RuntimeRun run = {};
+  run.inputIndices.reserve(inputs.size());
+  for (auto& input : inputs) {
+    run.inputIndices.push_back(addInput(context, std::move(input)));
   }
+  auto textureProxy = target->asTextureProxy();
+  run.needsResolve = textureProxy != nullptr &&
+                     (target->sampleCount() > 1 || textureProxy->hasMipmaps());
+  run.target = std::move(target);
+  run.effect = std::move(effect);
+  run.offset = offset;
+  runs.push_back(std::move(run));
+  return true;
 }
 
-bool RuntimeDrawTask::execute(RenderPass* renderPass) {
-  std::vector<std::shared_ptr<Texture>> textures = {};
-  textures.reserve(inputTextures.size());
-  for (size_t i = 0; i < inputTextures.size(); i++) {
-    std::shared_ptr<Texture> texture;
-    if (auto inputProxy = inputTextures[i]) {
-      texture = GetFlatTexture(renderPass, std::move(inputProxy), inputVertexBuffers[i]);
-    }
-    if (texture == nullptr) {
-      LOGE("RuntimeDrawTask::execute() Failed to get the input %d texture!", i);
-      return false;
+size_t RuntimeDrawTask::addInput(Context* context, std::shared_ptr<TextureProxy> input) {
+  if (input != nullptr) {
+    // Runs that share the same input, e.g. a lookup table in extraInputs, reuse its vertex buffer
+    // and its flattened texture.
+    for (size_t i = 0; i < inputTextures.size(); i++) {
+      if (inputTextures[i] == input) {
+        return i;
+      }
     }
-    textures.push_back(texture);
   }
-
-  auto renderTarget = renderTargetProxy->getRenderTarget();
-  if (renderTarget == nullptr) {
-    LOGE("RuntimeDrawTask::execute() Failed to get the render target!");
-    return false;
+  std::shared_ptr<VertexBufferProxy> vertexBuffer = nullptr;
+  if (input != nullptr) {
+    auto maskRect = Rect::MakeWH(input->width(), input->height());
+    auto maskVertexProvider =
+        RectsVertexProvider::MakeFrom(context->drawingBuffer(), maskRect, AAType::None);
+    vertexBuffer = context->proxyProvider()->createVertexBuffer(std::move(maskVertexProvider),
+                                                                RenderFlags::DisableAsyncTask);
   }
+  inputTextures.push_back(std::move(input));
+  inputVertexBuffers.push_back(std::move(vertexBuffer));
+  return inputTextures.size() - 1;
+}
+
+bool RuntimeDrawTask::execute(RenderPass* renderPass) {
   auto context = renderPass->getContext();
-  RuntimeProgramCreator programCreator(effect);
+  // All runs share the same program, so it is looked up only once for the whole batch.
+  RuntimeProgramCreator programCreator(runs.front().effect);
   auto program = context->globalCache()->getProgram(&programCreator);
   if (program == nullptr) {
     LOGE("RuntimeDrawTask::execute() Failed to create the runtime program!");
     return false;
   }
-  std::vector<BackendTexture> backendTextures = {};
-  backendTextures.reserve(textures.size());
-  for (auto& texture : textures) {
-    backendTextures.push_back(texture->getBackendTexture());
+  auto runtimeProgram = RuntimeProgramWrapper::Unwrap(program.get());
+  std::vector<std::shared_ptr<Texture>> flatTextures(inputTextures.size());
+  bool success = true;
+  for (auto& run : runs) {
+    std::vector<BackendTexture> backendTextures = {};
+    backendTextures.reserve(run.inputIndices.size());
+    for (auto index : run.inputIndices) {
+      auto& texture = flatTextures[index];
+      if (texture == nullptr && inputTextures[index] != nullptr) {
+        texture = GetFlatTexture(renderPass, inputTextures[index], inputVertexBuffers[index]);
+      }
+      if (texture == nullptr) {
+        LOGE("RuntimeDrawTask::execute() Failed to get the input %d texture!", index);
+        break;
+      }
+      backendTextures.push_back(texture->getBackendTexture());
+    }
+    if (backendTextures.size() != run.inputIndices.size()) {
+      success = false;
+      continue;
+    }
+    auto renderTarget = run.target->getRenderTarget();
+    if (renderTarget == nullptr) {
+      LOGE("RuntimeDrawTask::execute() Failed to get the render target!");
+      success = false;
+      continue;
+    }
+    if (!run.effect->onDraw(runtimeProgram, backendTextures,
+                            renderTarget->getBackendRenderTarget(), run.offset)) {
+      success = false;
+      continue;
+    }
+    // Resolve the target right away, since later runs in this task may sample from it.
+    if (run.needsResolve && !TextureResolveTask::Resolve(renderPass, run.target.get())) {
+      success = false;
+    }
   }
-  return effect->onDraw(RuntimeProgramWrapper::Unwrap(program.get()), backendTextures,
-                        renderTarget->getBackendRenderTarget(), offset);
+  return success;
 }
 
 std::shared_ptr<Texture> RuntimeDrawTask::GetFlatTexture(
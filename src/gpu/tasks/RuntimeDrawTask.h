@@ -29,13 +29,33 @@ class RuntimeDrawTask : public RenderTask {
                   std::vector<std::shared_ptr<TextureProxy>> inputs,
                   std::shared_ptr<RuntimeEffect> effect, const Point& offset);
 
+  /**
+   * Appends another run of a RuntimeEffect to this task. Returns false if the effect does not share
+   * the same program with the effects already in this task. Runs are executed in the order they are
+   * added, and each target is resolved right after its run, so the inputs of a later run may be the
+   * outputs of an earlier one.
+   */
+  bool addRun(std::shared_ptr<RenderTargetProxy> target,
+              std::vector<std::shared_ptr<TextureProxy>> inputs,
+              std::shared_ptr<RuntimeEffect> effect, const Point& offset);
+
   bool execute(RenderPass* renderPass) override;
 
  private:
+  struct RuntimeRun {
+    std::shared_ptr<RenderTargetProxy> target = nullptr;
+    std::vector<size_t> inputIndices = {};
+    std::shared_ptr<RuntimeEffect> effect = nullptr;
+    Point offset = {};
+    bool needsResolve = false;
+  };
+
+  std::vector<RuntimeRun> runs = {};
+  // The input textures shared by all runs, each of them is flattened at most once.
   std::vector<std::shared_ptr<TextureProxy>> inputTextures = {};
   std::vector<std::shared_ptr<VertexBufferProxy>> inputVertexBuffers = {};
-  std::shared_ptr<RuntimeEffect> effect = nullptr;
-  Point offset = {};
+
+  size_t addInput(Context* context, std::shared_ptr<TextureProxy> input);
 
   static std::shared_ptr<Texture> GetFlatTexture(RenderPass* renderPass,
                                                  std::shared_ptr<TextureProxy> textureProxy,
@@ -24,10 +24,11 @@ TextureResolveTask::TextureResolveTask(std::shared_ptr<RenderTargetProxy> render
     : RenderTask(std::move(renderTargetProxy)) {
 }
 
-bool TextureResolveTask::execute(RenderPass* renderPass) {
+bool TextureResolveTask::Resolve(RenderPass* renderPass,
+                                 const RenderTargetProxy* renderTargetProxy) {
   auto renderTarget = renderTargetProxy->getRenderTarget();
   if (renderTarget == nullptr) {
-    LOGE("TextureResolveTask::execute() Failed to get render target!");
+    LOGE("TextureResolveTask::Resolve() Failed to get render target!");
     return false;
   }
   auto context = renderPass->getContext();
@@ -40,4 +41,8 @@ bool TextureResolveTask::execute(RenderPass* renderPass) {
   }
   return true;
 }
+
+bool TextureResolveTask::execute(RenderPass* renderPass) {
+  return Resolve(renderPass, renderTargetProxy.get());
+}
 }  // namespace tgfx
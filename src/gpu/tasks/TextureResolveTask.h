@@ -23,6 +23,11 @@
 namespace tgfx {
 class TextureResolveTask : public RenderTask {
  public:
+  /**
+   * Resolves the MSAA samples and regenerates the mipmap levels of the render target if needed.
+   */
+  static bool Resolve(RenderPass* renderPass, const RenderTargetProxy* renderTargetProxy);
+
   explicit TextureResolveTask(std::shared_ptr<RenderTargetProxy> renderTargetProxy);
 
   bool execute(RenderPass* renderPass) override;
@@ -23,6 +23,8 @@
 #include "layers/DrawArgs.h"
 #include "layers/RootLayer.h"
 #include "layers/TileCache.h"
+#include "tgfx/core/Recorder.h"
+#include "tgfx/core/Task.h"
 
 #ifdef TGFX_USE_INSPECTOR
 #include "layers/LayerViewerManager.h"
@@ -214,6 +216,14 @@ void DisplayList::setMaxTileCount(int count) {
   resetCaches();
 }
 
+int DisplayList::maxDirtyRegions() const {
+  return static_cast<int>(_root->maxDirtyRegions());
+}
+
+void DisplayList::setMaxDirtyRegions(int count) {
+  _root->setMaxDirtyRegions(static_cast<size_t>(std::max(count, 1)));
+}
+
 void DisplayList::showDirtyRegions(bool show) {
   if (_showDirtyRegions == show) {
     return;
@@ -225,7 +235,8 @@ void DisplayList::showDirtyRegions(bool show) {
 }
 
 bool DisplayList::hasContentChanged() const {
-  if (_hasContentChanged || hasZoomBlurTiles || _root->bitFields.dirtyDescendents) {
+  if (_hasContentChanged || hasZoomBlurTiles || hasPrefetchTiles || !scaledCacheBounds.empty() ||
+      _root->bitFields.dirtyDescendents) {
     return true;
   }
   if (!_showDirtyRegions) {
@@ -247,7 +258,19 @@ void DisplayList::render(Surface* surface, bool autoClear) {
   LayerViewerManager::Get().RenderImageAndSend(surface->getContext());
 #endif
   _hasContentChanged = false;
-  auto dirtyRegions = _root->updateDirtyRegions();
+  // Zero is reserved for drawing outside of a DisplayList.
+  if (++renderFrame == 0) {
+    renderFrame = 1;
+  }
+  // Layers drawn from a rasterized cache of another scale in the last frame are redrawn now, the
+  // exact scale is rasterized unless it keeps changing.
+  for (auto& rect : scaledCacheBounds) {
+    _root->invalidateRect(rect);
+  }
+  scaledCacheBounds.clear();
+  auto occlusionScale =
+      _zoomScaleInt == 0 ? 0.0f : ToZoomScaleFloat(_zoomScaleInt, _zoomScalePrecision);
+  auto dirtyRegions = _root->updateDirtyRegions(occlusionScale, _allowParallelContentUpdate);
   if (_zoomScaleInt == 0) {
     if (autoClear) {
       auto canvas = surface->getCanvas();
@@ -353,10 +376,15 @@ std::vector<Rect> DisplayList::renderTiled(Surface* surface, bool autoClear,
   if (screenTasks.empty()) {
     return renderDirect(surface, autoClear);
   }
+  collectPrefetchTasks(surface, &tileTasks);
   std::vector<Rect> dirtyRects = {};
   auto surfaceRect = Rect::MakeWH(surface->width(), surface->height());
+  if (!drawTileTasksInParallel(tileTasks)) {
+    for (auto& task : tileTasks) {
+      drawTileTask(task);
+    }
+  }
   for (auto& task : tileTasks) {
-    drawTileTask(task);
     auto dirtyRect = task.tileRect();
     dirtyRect.offset(roundf(_contentOffset.x), roundf(_contentOffset.y));
     if (dirtyRect.intersect(surfaceRect)) {
@@ -451,6 +479,8 @@ void DisplayList::invalidateCurrentTileCache(const TileCache* tileCache,
 std::vector<DrawTask> DisplayList::collectScreenTasks(const Surface* surface,
                                                       std::vector<DrawTask>* tileTasks) {
   auto maxRefinedCount = _maxTilesRefinedPerFrame;
+  isZooming = lastZoomScaleInt != _zoomScaleInt;
+  contentVelocity = isZooming ? Point::Zero() : _contentOffset - lastContentOffset;
   if (lastContentOffset != _contentOffset || lastZoomScaleInt != _zoomScaleInt) {
     lastContentOffset = _contentOffset;
     lastZoomScaleInt = _zoomScaleInt;
@@ -538,6 +568,114 @@ std::vector<DrawTask> DisplayList::collectScreenTasks(const Surface* surface,
   return screenTasks;
 }
 
+void DisplayList::collectPrefetchTasks(const Surface* surface, std::vector<DrawTask>* tileTasks) {
+  hasPrefetchTiles = false;
+  if (_prefetchMargin <= 0 || _maxTilesPrefetchedPerFrame <= 0 || isZooming) {
+    return;
+  }
+  auto result = tileCaches.find(_zoomScaleInt);
+  if (result == tileCaches.end()) {
+    return;
+  }
+  auto tileCache = result->second;
+  auto renderRect = Rect::MakeWH(surface->width(), surface->height());
+  renderRect.offset(-_contentOffset.x, -_contentOffset.y);
+  int startX = static_cast<int>(floorf(renderRect.left / static_cast<float>(_tileSize)));
+  int startY = static_cast<int>(floorf(renderRect.top / static_cast<float>(_tileSize)));
+  int endX = static_cast<int>(ceilf(renderRect.right / static_cast<float>(_tileSize)));
+  int endY = static_cast<int>(ceilf(renderRect.bottom / static_cast<float>(_tileSize)));
+  auto prefetchStartX = startX - _prefetchMargin;
+  auto prefetchStartY = startY - _prefetchMargin;
+  auto prefetchEndX = endX + _prefetchMargin;
+  auto prefetchEndY = endY + _prefetchMargin;
+  if (contentVelocity.x != 0.0f || contentVelocity.y != 0.0f) {
+    // The viewport moves opposite to the content offset, only prefetch on the side it is heading.
+    prefetchStartX = contentVelocity.x > 0.0f ? prefetchStartX : startX;
+    prefetchEndX = contentVelocity.x < 0.0f ? prefetchEndX : endX;
+    prefetchStartY = contentVelocity.y > 0.0f ? prefetchStartY : startY;
+    prefetchEndY = contentVelocity.y < 0.0f ? prefetchEndY : endY;
+  }
+  std::vector<std::pair<int, int>> prefetchGrids = {};
+  for (int tileY = prefetchStartY; tileY < prefetchEndY; ++tileY) {
+    for (int tileX = prefetchStartX; tileX < prefetchEndX; ++tileX) {
+      if (tileX >= startX && tileX < endX && tileY >= startY && tileY < endY) {
+        continue;
+      }
+      if (tileCache->getTile(tileX, tileY) == nullptr) {
+        prefetchGrids.emplace_back(tileX, tileY);
+      }
+    }
+  }
+  if (prefetchGrids.empty()) {
+    return;
+  }
+  auto budget = _maxTilesPrefetchedPerFrame - static_cast<int>(tileTasks->size());
+  if (budget <= 0) {
+    // The visible tiles used up the budget of this frame, the next one picks up prefetching.
+    hasPrefetchTiles = true;
+    return;
+  }
+  // Tiles closest to the viewport are the first to be scrolled in.
+  auto centerX = static_cast<float>(startX + endX) * 0.5f;
+  auto centerY = static_cast<float>(startY + endY) * 0.5f;
+  auto distance = [centerX, centerY](const std::pair<int, int>& grid) {
+    auto dx = static_cast<float>(grid.first) + 0.5f - centerX;
+    auto dy = static_cast<float>(grid.second) + 0.5f - centerY;
+    return dx * dx + dy * dy;
+  };
+  std::stable_sort(prefetchGrids.begin(), prefetchGrids.end(),
+                   [&distance](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                     return distance(a) < distance(b);
+                   });
+  auto tileCount = std::min(static_cast<size_t>(budget), prefetchGrids.size());
+  auto tiles = getPrefetchTiles(surface, tileCount, tileCache, prefetchStartX, prefetchStartY,
+                                prefetchEndX, prefetchEndY);
+  for (size_t i = 0; i < tiles.size(); i++) {
+    auto& tile = tiles[i];
+    tile->tileX = prefetchGrids[i].first;
+    tile->tileY = prefetchGrids[i].second;
+    tileCache->addTile(tile);
+    tileTasks->emplace_back(tile, _tileSize);
+  }
+  // Keep requesting frames only if there is room left for the remaining tiles.
+  hasPrefetchTiles = tiles.size() == tileCount && prefetchGrids.size() > tileCount;
+}
+
+std::vector<std::shared_ptr<Tile>> DisplayList::getPrefetchTiles(const Surface* surface,
+                                                                 size_t tileCount,
+                                                                 TileCache* tileCache, int startX,
+                                                                 int startY, int endX, int endY) {
+  while (emptyTiles.size() < tileCount) {
+    if (!createEmptyTiles(surface)) {
+      break;
+    }
+  }
+  if (emptyTiles.size() < tileCount) {
+    // Reuse the tiles left behind by the motion, farthest from the viewport first. Tiles in the
+    // prefetch range are kept, otherwise prefetching would evict its own results.
+    auto centerX = static_cast<float>(surface->width()) * 0.5f - _contentOffset.x;
+    auto centerY = static_cast<float>(surface->height()) * 0.5f - _contentOffset.y;
+    auto reusableTiles = tileCache->getReusableTiles(centerX, centerY);
+    for (auto it = reusableTiles.rbegin(); it != reusableTiles.rend(); ++it) {
+      auto& tile = *it;
+      if (tile->tileX >= startX && tile->tileX < endX && tile->tileY >= startY &&
+          tile->tileY < endY) {
+        continue;
+      }
+      tileCache->removeTile(tile->tileX, tile->tileY);
+      emptyTiles.push_back(std::move(tile));
+      if (emptyTiles.size() >= tileCount) {
+        break;
+      }
+    }
+  }
+  auto count = std::min(tileCount, emptyTiles.size());
+  std::vector<std::shared_ptr<Tile>> tiles(emptyTiles.end() - static_cast<int>(count),
+                                           emptyTiles.end());
+  emptyTiles.resize(emptyTiles.size() - count);
+  return tiles;
+}
+
 static float ScaleRatio(float scaleA, float zoomScale) {
   auto ratio = fabsf(scaleA / zoomScale);
   if (ratio < 1.0f) {
@@ -736,11 +874,8 @@ int DisplayList::getMaxTileCountPerAtlas(Context* context) const {
   return (maxTextureSize / _tileSize) * (maxTextureSize / _tileSize);
 }
 
-void DisplayList::drawTileTask(const DrawTask& task) const {
-  auto surface = surfaceCaches[task.sourceIndex()].get();
-  DEBUG_ASSERT(surface != nullptr);
-  auto canvas = surface->getCanvas();
-  AutoCanvasRestore autoRestore(canvas);
+Matrix DisplayList::getTileMatrix(const DrawTask& task, Rect* clipRect) const {
+  DEBUG_ASSERT(clipRect != nullptr);
   auto currentZoomScale = ToZoomScaleFloat(_zoomScaleInt, _zoomScalePrecision);
   DEBUG_ASSERT(currentZoomScale != 0.0f);
   auto viewMatrix = Matrix::MakeScale(currentZoomScale);
@@ -749,11 +884,68 @@ void DisplayList::drawTileTask(const DrawTask& task) const {
   auto offsetX = sourceRect.left - tileRect.left;
   auto offsetY = sourceRect.top - tileRect.top;
   viewMatrix.postTranslate(offsetX, offsetY);
-  auto clipRect = tileRect;
-  clipRect.offset(offsetX, offsetY);
+  *clipRect = tileRect;
+  clipRect->offset(offsetX, offsetY);
+  return viewMatrix;
+}
+
+void DisplayList::drawTileTask(const DrawTask& task) const {
+  auto surface = surfaceCaches[task.sourceIndex()].get();
+  DEBUG_ASSERT(surface != nullptr);
+  Rect clipRect = {};
+  auto viewMatrix = getTileMatrix(task, &clipRect);
   drawRootLayer(surface, clipRect, viewMatrix, true);
 }
 
+bool DisplayList::drawTileTasksInParallel(const std::vector<DrawTask>& tileTasks) const {
+  if (!_allowParallelRecording || tileTasks.size() < 2) {
+    return false;
+  }
+  // Background styles read back what has already been drawn to the surface, which is only
+  // available on the render thread.
+  if (_root->hasBackgroundStyle()) {
+    return false;
+  }
+  // Contents and bounds were already updated by updateDirtyRegions(), and masks read the cached
+  // global matrices, so those are computed here before any background thread starts recording.
+  // The calling thread records the first tile while the others run on background threads.
+  _root->prepareMaskMatrices();
+  std::vector<std::shared_ptr<Picture>> pictures(tileTasks.size());
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (size_t i = 1; i < tileTasks.size(); i++) {
+    tasks.push_back(Task::Run([&, i]() { pictures[i] = recordTileTask(tileTasks[i]); }));
+  }
+  pictures[0] = recordTileTask(tileTasks[0]);
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  for (size_t i = 0; i < tileTasks.size(); i++) {
+    auto& task = tileTasks[i];
+    auto surface = surfaceCaches[task.sourceIndex()].get();
+    DEBUG_ASSERT(surface != nullptr);
+    auto canvas = surface->getCanvas();
+    AutoCanvasRestore autoRestore(canvas);
+    Rect clipRect = {};
+    getTileMatrix(task, &clipRect);
+    canvas->clipRect(clipRect);
+    canvas->clear();
+    if (pictures[i]) {
+      canvas->drawPicture(pictures[i]);
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<Picture> DisplayList::recordTileTask(const DrawTask& task) const {
+  Rect clipRect = {};
+  auto viewMatrix = getTileMatrix(task, &clipRect);
+  Recorder recorder = {};
+  auto canvas = recorder.beginRecording();
+  // The GPU context is not passed to the background threads, so rasterized caches are skipped.
+  drawRootLayer(canvas, nullptr, clipRect, viewMatrix);
+  return recorder.finishRecordingAsPicture();
+}
+
 void DisplayList::drawScreenTasks(std::vector<DrawTask> screenTasks, Surface* surface,
                                   bool autoClear) const {
   // Sort tasks by surface index to ensure they are drawn in batches.
@@ -828,6 +1020,12 @@ void DisplayList::drawRootLayer(Surface* surface, const Rect& drawRect, const Ma
   if (autoClear) {
     canvas->clear();
   }
+  drawRootLayer(canvas, context, drawRect, viewMatrix);
+}
+
+void DisplayList::drawRootLayer(Canvas* canvas, Context* context, const Rect& drawRect,
+                                const Matrix& viewMatrix) const {
+  DEBUG_ASSERT(canvas != nullptr);
   canvas->setMatrix(viewMatrix);
   DrawArgs args(context);
   DEBUG_ASSERT(viewMatrix.invertible());
@@ -836,6 +1034,9 @@ void DisplayList::drawRootLayer(Surface* surface, const Rect& drawRect, const Ma
   auto renderRect = inverse.mapRect(drawRect);
   renderRect.roundOut();
   args.renderRect = &renderRect;
+  args.cullOccluded = true;
+  args.scaledCacheBounds = &scaledCacheBounds;
+  args.renderFrame = renderFrame;
   auto backgroundRect = _root->getBackgroundRect(drawRect, viewMatrix.getMaxScale());
   if (backgroundRect) {
     args.backgroundContext = BackgroundContext::Make(context, *backgroundRect, viewMatrix);
@@ -44,6 +44,15 @@ class DrawArgs {
   DrawMode drawMode = DrawMode::Normal;
   // The rectangle area to be drawn. This is used for clipping the drawing area.
   Rect* renderRect = nullptr;
+  // Whether to skip the child layers that the root layer's last occlusion pass found fully covered
+  // by opaque layers above them. Only valid while drawing the root layer of a DisplayList.
+  bool cullOccluded = false;
+  // Collects the render bounds of layers drawn from a rasterized cache of a different scale, so
+  // they can be redrawn at the exact scale in the next frame. Note: this could be nullptr.
+  std::vector<Rect>* scaledCacheBounds = nullptr;
+  // Identifies the DisplayList render pass in progress, or zero if the layer is drawn outside of a
+  // DisplayList.
+  uint32_t renderFrame = 0;
 
   // The background context to be used during the drawing process. Note: this could be nullptr.
   std::shared_ptr<BackgroundContext> backgroundContext = nullptr;
@@ -43,4 +43,11 @@ void ImageLayer::onUpdateContent(LayerRecorder* recorder) {
   auto canvas = recorder->getCanvas();
   canvas->drawImage(_image, _sampling);
 }
+
+Rect ImageLayer::getOpaqueBounds() const {
+  if (_image == nullptr || !_image->isOpaque()) {
+    return Rect::MakeEmpty();
+  }
+  return Rect::MakeWH(_image->width(), _image->height());
+}
 }  // namespace tgfx
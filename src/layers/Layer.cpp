@@ -34,6 +34,8 @@
 namespace tgfx {
 static std::atomic_bool AllowsEdgeAntialiasing = true;
 static std::atomic_bool AllowsGroupOpacity = false;
+// The number of rasterized versions at other scales that are kept for each layer.
+static constexpr size_t MAX_SCALED_RASTERIZED_CONTENTS = 4;
 
 struct LayerStyleSource {
   float contentScale = 1.0f;
@@ -43,6 +45,50 @@ struct LayerStyleSource {
   Point contourOffset = {};
 };
 
+// Identifies the arguments a layer style source or background image was recorded with.
+struct SourceKey {
+  float contentScale = 0.0f;
+  DrawMode drawMode = DrawMode::Normal;
+  bool excludeEffects = false;
+  bool hasRenderRect = false;
+  Rect renderRect = {};
+
+  SourceKey() = default;
+
+  SourceKey(const DrawArgs& args, float contentScale)
+      : contentScale(contentScale), drawMode(args.drawMode), excludeEffects(args.excludeEffects),
+        hasRenderRect(args.renderRect != nullptr),
+        renderRect(args.renderRect ? *args.renderRect : Rect::MakeEmpty()) {
+  }
+
+  bool operator==(const SourceKey& other) const {
+    return contentScale == other.contentScale && drawMode == other.drawMode &&
+           excludeEffects == other.excludeEffects && hasRenderRect == other.hasRenderRect &&
+           renderRect == other.renderRect;
+  }
+};
+
+// Keeps the images a layer records for its styles, so that drawing the layer, the backgrounds of
+// its descendants, and its rasterized or offscreen versions within a frame only record them once.
+// It is cleared together with the rasterized contents by the dirty flags.
+struct LayerSourceCache {
+  SourceKey styleSourceKey = {};
+  std::shared_ptr<LayerStyleSource> styleSource = nullptr;
+  SourceKey backgroundKey = {};
+  std::shared_ptr<Image> background = nullptr;
+  Point backgroundOffset = {};
+};
+
+// An image that a later draw takes from the cache belongs to an unchanged layer. Rasterizing it
+// gives the filters of the layer styles a stable source key, so their outputs can be cached too.
+static std::shared_ptr<Image> MakeStableImage(std::shared_ptr<Image> image) {
+  if (image == nullptr) {
+    return nullptr;
+  }
+  auto rasterImage = image->makeRasterized();
+  return rasterImage ? rasterImage : image;
+}
+
 static std::shared_ptr<Picture> RecordPicture(float contentScale,
                                               const std::function<void(Canvas*)>& drawFunction) {
   if (drawFunction == nullptr) {
@@ -134,6 +180,7 @@ void Layer::setPosition(const Point& value) {
   }
   _matrix.setTranslateX(value.x);
   _matrix.setTranslateY(value.y);
+  invalidateGlobalMatrix();
   invalidateTransform();
 }
 
@@ -142,6 +189,7 @@ void Layer::setMatrix(const Matrix& value) {
     return;
   }
   _matrix = value;
+  invalidateGlobalMatrix();
   invalidateTransform();
 }
 
@@ -196,7 +244,7 @@ void Layer::setFilters(std::vector<std::shared_ptr<LayerFilter>> value) {
   for (const auto& filter : _filters) {
     filter->attachToLayer(this);
   }
-  rasterizedContent = nullptr;
+  clearCachedContents();
   invalidateTransform();
 }
 
@@ -241,6 +289,7 @@ void Layer::setScrollRect(const Rect& rect) {
   } else {
     _scrollRect = std::make_unique<Rect>(rect);
   }
+  invalidateGlobalMatrix();
   invalidateTransform();
 }
 
@@ -260,7 +309,7 @@ void Layer::setLayerStyles(std::vector<std::shared_ptr<LayerStyle>> value) {
   for (const auto& layerStyle : _layerStyles) {
     layerStyle->attachToLayer(this);
   }
-  rasterizedContent = nullptr;
+  clearCachedContents();
   invalidateTransform();
 }
 
@@ -303,6 +352,7 @@ bool Layer::addChildAt(std::shared_ptr<Layer> child, int index) {
   child->removeFromParent();
   _children.insert(_children.begin() + index, child);
   child->_parent = this;
+  child->invalidateGlobalMatrix();
   child->onAttachToRoot(_root);
   child->invalidateTransform();
   invalidateDescendents();
@@ -328,7 +378,11 @@ int Layer::getChildIndex(std::shared_ptr<Layer> child) const {
 
 std::vector<std::shared_ptr<Layer>> Layer::getLayersUnderPoint(float x, float y) {
   std::vector<std::shared_ptr<Layer>> results;
-  getLayersUnderPointInternal(x, y, &results);
+  auto candidates = getCandidateLayers(x, y);
+  if (candidates && candidates->count(this) == 0) {
+    return results;
+  }
+  getLayersUnderPointInternal(x, y, &results, candidates ? &*candidates : nullptr);
   return results;
 }
 
@@ -346,6 +400,8 @@ std::shared_ptr<Layer> Layer::removeChildAt(int index) {
   }
   auto child = _children[static_cast<size_t>(index)];
   child->_parent = nullptr;
+  // The child becomes a top-level layer, which changes the global matrices of its subtree.
+  child->invalidateGlobalMatrix();
   child->onDetachFromRoot();
   _children.erase(_children.begin() + index);
   if (_root) {
@@ -464,20 +520,40 @@ Rect Layer::getBoundsInternal(const Matrix& coordinateMatrix, bool computeTightB
 }
 
 Point Layer::globalToLocal(const Point& globalPoint) const {
-  auto globalMatrix = getGlobalMatrix();
-  Matrix inverseMatrix = {};
-  if (!globalMatrix.invert(&inverseMatrix)) {
+  auto inverseMatrix = getGlobalInverseMatrix();
+  if (inverseMatrix == nullptr) {
     return Point::Make(0, 0);
   }
-  return inverseMatrix.mapXY(globalPoint.x, globalPoint.y);
+  return inverseMatrix->mapXY(globalPoint.x, globalPoint.y);
 }
 
 Point Layer::localToGlobal(const Point& localPoint) const {
-  auto globalMatrix = getGlobalMatrix();
-  return globalMatrix.mapXY(localPoint.x, localPoint.y);
+  return getGlobalMatrix().mapXY(localPoint.x, localPoint.y);
 }
 
 bool Layer::hitTestPoint(float x, float y, bool shapeHitTest) {
+  auto candidates = getCandidateLayers(x, y);
+  if (candidates && candidates->count(this) == 0) {
+    return false;
+  }
+  return hitTestPointInternal(x, y, shapeHitTest, candidates ? &*candidates : nullptr);
+}
+
+std::optional<std::unordered_set<const Layer*>> Layer::getCandidateLayers(float x, float y) const {
+  if (_root == nullptr || !_root->isSpatialTreeValid()) {
+    return std::nullopt;
+  }
+  // The bounds of layers under a hidden ancestor are not kept up to date.
+  for (auto layer = this; layer != _root; layer = layer->_parent) {
+    if (!layer->bitFields.visible || layer->_alpha <= 0) {
+      return std::nullopt;
+    }
+  }
+  return _root->getCandidateLayers(Point::Make(x, y));
+}
+
+bool Layer::hitTestPointInternal(float x, float y, bool shapeHitTest,
+                                 const std::unordered_set<const Layer*>* candidates) {
   if (auto content = getContent()) {
     Point localPoint = globalToLocal(Point::Make(x, y));
     if (content->hitTestPoint(localPoint.x, localPoint.y, shapeHitTest)) {
@@ -490,6 +566,10 @@ bool Layer::hitTestPoint(float x, float y, bool shapeHitTest) {
       continue;
     }
 
+    if (candidates && candidates->count(childLayer.get()) == 0) {
+      continue;
+    }
+
     if (nullptr != childLayer->_scrollRect) {
       auto pointInChildSpace = childLayer->globalToLocal(Point::Make(x, y));
       if (!childLayer->_scrollRect->contains(pointInChildSpace.x, pointInChildSpace.y)) {
@@ -503,7 +583,7 @@ bool Layer::hitTestPoint(float x, float y, bool shapeHitTest) {
       }
     }
 
-    if (childLayer->hitTestPoint(x, y, shapeHitTest)) {
+    if (childLayer->hitTestPointInternal(x, y, shapeHitTest, candidates)) {
       return true;
     }
   }
@@ -529,10 +609,10 @@ void Layer::draw(Canvas* canvas, float alpha, BlendMode blendMode) {
     auto scale = canvas->getMatrix().getMaxScale();
     auto bounds = getBounds();
     bounds.scale(scale, scale);
-    auto globalMatrix = getGlobalMatrix();
-    globalMatrix.preScale(1 / scale, 1 / scale);
+    auto backgroundMatrix = getGlobalMatrix();
+    backgroundMatrix.preScale(1 / scale, 1 / scale);
     auto invert = Matrix::I();
-    if (globalMatrix.invert(&invert)) {
+    if (backgroundMatrix.invert(&invert)) {
       auto backgroundContext = BackgroundContext::Make(context, bounds, invert);
       if (backgroundContext) {
         auto backgroundCanvas = backgroundContext->getCanvas();
@@ -572,7 +652,7 @@ void Layer::invalidateDescendents() {
     return;
   }
   bitFields.dirtyDescendents = true;
-  rasterizedContent = nullptr;
+  clearCachedContents();
   invalidate();
 }
 
@@ -588,6 +668,10 @@ void Layer::invalidate() {
 void Layer::onUpdateContent(LayerRecorder*) {
 }
 
+Rect Layer::getOpaqueBounds() const {
+  return Rect::MakeEmpty();
+}
+
 void Layer::attachProperty(LayerProperty* property) {
   if (property) {
     property->attachToLayer(this);
@@ -608,6 +692,10 @@ void Layer::onAttachToRoot(RootLayer* rootLayer) {
 }
 
 void Layer::onDetachFromRoot() {
+  if (_root) {
+    _root->removeSpatialBounds(this);
+    _root->removeOccluder(this);
+  }
   _root = nullptr;
   for (auto& child : _children) {
     child->onDetachFromRoot();
@@ -636,17 +724,44 @@ bool Layer::doContains(const Layer* child) const {
   return false;
 }
 
-Matrix Layer::getGlobalMatrix() const {
+const Matrix& Layer::getGlobalMatrix() const {
   // The global matrix transforms the layer's local coordinate space to the coordinate space of its
   // top-level parent layer. This means the top-level parent layer's own matrix is not included in
   // the global matrix.
-  Matrix matrix = {};
-  auto layer = this;
-  while (layer->_parent) {
-    matrix.postConcat(layer->getMatrixWithScrollRect());
-    layer = layer->_parent;
+  if (globalMatrixValid) {
+    return globalMatrix;
+  }
+  if (_parent) {
+    // The parent caches its own global matrix, so the ancestors are only computed once no matter
+    // how many descendants are queried.
+    globalMatrix = getMatrixWithScrollRect();
+    globalMatrix.postConcat(_parent->getGlobalMatrix());
+  } else {
+    globalMatrix = Matrix::I();
+  }
+  globalMatrixValid = true;
+  return globalMatrix;
+}
+
+const Matrix* Layer::getGlobalInverseMatrix() const {
+  if (!globalInverseValid) {
+    globalInvertible = getGlobalMatrix().invert(&globalInverseMatrix);
+    globalInverseValid = true;
+  }
+  return globalInvertible ? &globalInverseMatrix : nullptr;
+}
+
+void Layer::invalidateGlobalMatrix() {
+  // A valid global matrix is always computed from the valid global matrix of the parent, so the
+  // descendants of a layer whose cache is already invalid are invalid too.
+  if (!globalMatrixValid) {
+    return;
+  }
+  globalMatrixValid = false;
+  globalInverseValid = false;
+  for (auto& child : _children) {
+    child->invalidateGlobalMatrix();
   }
-  return matrix;
 }
 
 Matrix Layer::getMatrixWithScrollRect() const {
@@ -667,6 +782,22 @@ LayerContent* Layer::getContent() {
   return layerContent.get();
 }
 
+void Layer::collectDirtyContents(std::vector<Layer*>* layers) {
+  if (!bitFields.dirtyDescendents) {
+    return;
+  }
+  if (bitFields.dirtyContent) {
+    layers->push_back(this);
+  }
+  for (auto& child : _children) {
+    // Hidden layers are skipped by updateRenderBounds() as well, their contents are updated lazily.
+    if (!child->bitFields.visible || child->_alpha <= 0) {
+      continue;
+    }
+    child->collectDirtyContents(layers);
+  }
+}
+
 std::shared_ptr<ImageFilter> Layer::getImageFilter(float contentScale) {
   if (_filters.empty()) {
     return nullptr;
@@ -690,9 +821,91 @@ RasterizedContent* Layer::getRasterizedCache(const DrawArgs& args, const Matrix&
   auto content = rasterizedContent.get();
   float contentScale =
       _rasterizationScale == 0.0f ? renderMatrix.getMaxScale() : _rasterizationScale;
+  if (args.renderFrame == 0 || args.renderFrame != rasterizedFrame) {
+    previousRasterizedScale = lastRasterizedScale;
+    lastRasterizedScale = contentScale;
+    rasterizedFrame = args.renderFrame;
+    scaledCacheBoundsAdded = false;
+  }
   if (content && content->contextID() == contextID && content->contentScale() == contentScale) {
     return content;
   }
+  // While the scale keeps changing between frames, e.g. during a zoom animation, draw the closest
+  // cached version instead and rasterize at the exact scale once it settles.
+  auto scaleChanging = _rasterizationScale == 0.0f && content != nullptr &&
+                       content->contextID() == contextID && contentScale != previousRasterizedScale;
+  if (scaleChanging) {
+    if (auto scaledContent = getScaledRasterizedCache(args, contentScale)) {
+      if (args.scaledCacheBounds && !scaledCacheBoundsAdded) {
+        args.scaledCacheBounds->push_back(renderBounds);
+        scaledCacheBoundsAdded = true;
+      }
+      return scaledContent;
+    }
+  }
+  auto newContent = makeRasterizedContent(args, contentScale);
+  if (newContent == nullptr) {
+    return nullptr;
+  }
+  rasterizedContent = std::move(newContent);
+  return rasterizedContent.get();
+}
+
+static float RasterizedBucketScale(float contentScale) {
+  // Rounds up to a power of √2, so the bucket is never blurrier than the requested scale.
+  auto level = static_cast<int>(ceilf(log2f(contentScale) * 2.0f - FLOAT_NEARLY_ZERO));
+  auto exponent = level >= 0 ? level / 2 : (level - 1) / 2;
+  return std::ldexp(level - exponent * 2 == 1 ? FLOAT_SQRT2 : 1.0f, exponent);
+}
+
+static float ScaleRatio(float scaleA, float scaleB) {
+  return scaleA > scaleB ? scaleA / scaleB : scaleB / scaleA;
+}
+
+RasterizedContent* Layer::getScaledRasterizedCache(const DrawArgs& args, float contentScale) {
+  if (FloatNearlyZero(contentScale)) {
+    return nullptr;
+  }
+  auto contextID = args.context->uniqueID();
+  RasterizedContent* closestContent = nullptr;
+  auto closestRatio = FLOAT_SQRT2;
+  auto checkContent = [&](RasterizedContent* content) {
+    if (content == nullptr || content->contextID() != contextID) {
+      return;
+    }
+    auto ratio = ScaleRatio(content->contentScale(), contentScale);
+    if (ratio <= closestRatio) {
+      closestContent = content;
+      closestRatio = ratio;
+    }
+  };
+  checkContent(rasterizedContent.get());
+  for (auto& content : scaledRasterizedContents) {
+    checkContent(content.get());
+  }
+  if (closestContent) {
+    return closestContent;
+  }
+  auto content = makeRasterizedContent(args, RasterizedBucketScale(contentScale));
+  if (content == nullptr) {
+    return nullptr;
+  }
+  if (scaledRasterizedContents.size() >= MAX_SCALED_RASTERIZED_CONTENTS) {
+    auto farthest = std::max_element(
+        scaledRasterizedContents.begin(), scaledRasterizedContents.end(),
+        [contentScale](const std::unique_ptr<RasterizedContent>& a,
+                       const std::unique_ptr<RasterizedContent>& b) {
+          return ScaleRatio(a->contentScale(), contentScale) <
+                 ScaleRatio(b->contentScale(), contentScale);
+        });
+    scaledRasterizedContents.erase(farthest);
+  }
+  scaledRasterizedContents.push_back(std::move(content));
+  return scaledRasterizedContents.back().get();
+}
+
+std::unique_ptr<RasterizedContent> Layer::makeRasterizedContent(const DrawArgs& args,
+                                                                float contentScale) {
   Matrix drawingMatrix = {};
   auto image = getRasterizedImage(args, contentScale, &drawingMatrix);
   if (image == nullptr) {
@@ -702,9 +915,14 @@ RasterizedContent* Layer::getRasterizedCache(const DrawArgs& args, const Matrix&
   if (image == nullptr) {
     return nullptr;
   }
-  rasterizedContent =
-      std::make_unique<RasterizedContent>(contextID, contentScale, std::move(image), drawingMatrix);
-  return rasterizedContent.get();
+  return std::make_unique<RasterizedContent>(args.context->uniqueID(), contentScale,
+                                             std::move(image), drawingMatrix);
+}
+
+void Layer::clearCachedContents() {
+  rasterizedContent = nullptr;
+  scaledRasterizedContents.clear();
+  sourceCache = nullptr;
 }
 
 std::shared_ptr<Image> Layer::getRasterizedImage(const DrawArgs& args, float contentScale,
@@ -716,6 +934,8 @@ std::shared_ptr<Image> Layer::getRasterizedImage(const DrawArgs& args, float con
   auto drawArgs = args;
   drawArgs.renderRect = nullptr;
   drawArgs.backgroundContext = nullptr;
+  // The rasterized image outlives the current frame, it must not depend on what covers it now.
+  drawArgs.cullOccluded = false;
   auto picture =
       RecordPicture(contentScale, [&](Canvas* canvas) { drawDirectly(drawArgs, canvas, 1.0f); });
   if (!picture) {
@@ -769,13 +989,12 @@ Matrix Layer::getRelativeMatrix(const Layer* targetCoordinateSpace) const {
   if (targetCoordinateSpace == nullptr || targetCoordinateSpace == this) {
     return {};
   }
-  auto targetLayerMatrix = targetCoordinateSpace->getGlobalMatrix();
-  Matrix targetLayerInverseMatrix = {};
-  if (!targetLayerMatrix.invert(&targetLayerInverseMatrix)) {
+  auto targetLayerInverseMatrix = targetCoordinateSpace->getGlobalInverseMatrix();
+  if (targetLayerInverseMatrix == nullptr) {
     return {};
   }
   Matrix relativeMatrix = getGlobalMatrix();
-  relativeMatrix.postConcat(targetLayerInverseMatrix);
+  relativeMatrix.postConcat(*targetLayerInverseMatrix);
   return relativeMatrix;
 }
 
@@ -784,6 +1003,7 @@ std::shared_ptr<MaskFilter> Layer::getMaskFilter(const DrawArgs& args, float sca
   auto maskType = static_cast<LayerMaskType>(bitFields.maskType);
   maskArgs.drawMode = maskType != LayerMaskType::Contour ? DrawMode::Normal : DrawMode::Contour;
   maskArgs.backgroundContext = nullptr;
+  maskArgs.cullOccluded = false;
   auto maskPicture = RecordPicture(scale, [&](Canvas* canvas) {
     _mask->drawLayer(maskArgs, canvas, _mask->_alpha, BlendMode::SrcOver);
   });
@@ -836,6 +1056,10 @@ void Layer::drawOffscreen(const DrawArgs& args, Canvas* canvas, float alpha, Ble
                                   : nullptr;
   auto offscreenArgs = args;
   offscreenArgs.backgroundContext = subBackgroundContext;
+  if (!_filters.empty() || !_layerStyles.empty()) {
+    // Filters and layer styles can spread the children's pixels outside an occluder.
+    offscreenArgs.cullOccluded = false;
+  }
   auto picture = RecordPicture(contentScale,
                                [&](Canvas* canvas) { drawDirectly(offscreenArgs, canvas, 1.0f); });
   if (picture == nullptr) {
@@ -920,6 +1144,9 @@ bool Layer::drawChildren(const DrawArgs& args, Canvas* canvas, float alpha,
     if (!child->visible() || child->_alpha <= 0) {
       continue;
     }
+    if (args.cullOccluded && _root->isOccluded(child.get())) {
+      continue;
+    }
 
     AutoCanvasRestore autoRestore(canvas);
     auto backgroundCanvas = args.backgroundContext ? args.backgroundContext->getCanvas() : nullptr;
@@ -958,7 +1185,7 @@ float Layer::drawBackgroundLayers(const DrawArgs& args, Canvas* canvas) {
   return currentAlpha * _alpha;
 }
 
-std::unique_ptr<LayerStyleSource> Layer::getLayerStyleSource(const DrawArgs& args,
+std::shared_ptr<LayerStyleSource> Layer::getLayerStyleSource(const DrawArgs& args,
                                                              const Matrix& matrix) {
   if (_layerStyles.empty() || args.excludeEffects) {
     return nullptr;
@@ -971,6 +1198,16 @@ std::unique_ptr<LayerStyleSource> Layer::getLayerStyleSource(const DrawArgs& arg
   DrawArgs drawArgs = args;
   drawArgs.backgroundContext = nullptr;
   drawArgs.excludeEffects = bitFields.excludeChildEffectsInLayerStyle;
+  drawArgs.cullOccluded = false;
+  // The cache is only used on the render thread, which is the one holding the GPU context.
+  auto useCache = args.context != nullptr;
+  SourceKey key(drawArgs, contentScale);
+  if (useCache && sourceCache && sourceCache->styleSource && sourceCache->styleSourceKey == key) {
+    auto& source = sourceCache->styleSource;
+    source->content = MakeStableImage(std::move(source->content));
+    source->contour = MakeStableImage(std::move(source->contour));
+    return source;
+  }
   auto contentPicture =
       RecordPicture(contentScale, [&](Canvas* canvas) { drawContents(drawArgs, canvas, 1.0f); });
   Point contentOffset = {};
@@ -978,7 +1215,7 @@ std::unique_ptr<LayerStyleSource> Layer::getLayerStyleSource(const DrawArgs& arg
   if (content == nullptr) {
     return nullptr;
   }
-  auto source = std::make_unique<LayerStyleSource>();
+  auto source = std::make_shared<LayerStyleSource>();
   source->contentScale = contentScale;
   source->content = std::move(content);
   source->contentOffset = contentOffset;
@@ -995,6 +1232,13 @@ std::unique_ptr<LayerStyleSource> Layer::getLayerStyleSource(const DrawArgs& arg
         RecordPicture(contentScale, [&](Canvas* canvas) { drawContents(drawArgs, canvas, 1.0f); });
     source->contour = ToImageWithOffset(std::move(contourPicture), &source->contourOffset);
   }
+  if (useCache) {
+    if (sourceCache == nullptr) {
+      sourceCache = std::make_unique<LayerSourceCache>();
+    }
+    sourceCache->styleSourceKey = key;
+    sourceCache->styleSource = source;
+  }
   return source;
 }
 
@@ -1003,18 +1247,26 @@ std::shared_ptr<Image> Layer::getBackgroundImage(const DrawArgs& args, float con
   if (args.drawMode == DrawMode::Background) {
     return nullptr;
   }
+  // Walking the layers below is only needed without a background context, and is cached on the
+  // render thread since every background style of the layer needs the same image.
+  auto useCache = args.context != nullptr && args.backgroundContext == nullptr;
+  SourceKey key(args, contentScale);
+  if (useCache && sourceCache && sourceCache->background && sourceCache->backgroundKey == key) {
+    *offset = sourceCache->backgroundOffset;
+    sourceCache->background = MakeStableImage(std::move(sourceCache->background));
+    return sourceCache->background;
+  }
   Recorder recorder = {};
   auto canvas = recorder.beginRecording();
   auto bounds = getBounds();
   bounds.scale(contentScale, contentScale);
   canvas->clipRect(bounds);
   canvas->scale(contentScale, contentScale);
-  auto globalMatrix = getGlobalMatrix();
-  Matrix invertMatrix = {};
-  if (!globalMatrix.invert(&invertMatrix)) {
+  auto invertMatrix = getGlobalInverseMatrix();
+  if (invertMatrix == nullptr) {
     return nullptr;
   }
-  canvas->concat(invertMatrix);
+  canvas->concat(*invertMatrix);
   if (args.backgroundContext) {
     canvas->concat(args.backgroundContext->backgroundMatrix());
     canvas->drawImage(args.backgroundContext->getBackgroundImage());
@@ -1023,6 +1275,7 @@ std::shared_ptr<Image> Layer::getBackgroundImage(const DrawArgs& args, float con
     drawArgs.excludeEffects = false;
     // Set the draw mode to Background to avoid drawing the layer styles that require background.
     drawArgs.drawMode = DrawMode::Background;
+    drawArgs.cullOccluded = false;
     auto backgroundRect = renderBounds;
     if (drawArgs.renderRect) {
       backgroundRect.intersect(*args.renderRect);
@@ -1037,7 +1290,16 @@ std::shared_ptr<Image> Layer::getBackgroundImage(const DrawArgs& args, float con
     }
   }
   auto backgroundPicture = recorder.finishRecordingAsPicture();
-  return ToImageWithOffset(std::move(backgroundPicture), offset, &bounds);
+  auto background = ToImageWithOffset(std::move(backgroundPicture), offset, &bounds);
+  if (useCache && background) {
+    if (sourceCache == nullptr) {
+      sourceCache = std::make_unique<LayerSourceCache>();
+    }
+    sourceCache->backgroundKey = key;
+    sourceCache->background = background;
+    sourceCache->backgroundOffset = *offset;
+  }
+  return background;
 }
 
 void Layer::drawLayerStyles(const DrawArgs& args, Canvas* canvas, float alpha,
@@ -1093,7 +1355,8 @@ void Layer::drawLayerStyles(const DrawArgs& args, Canvas* canvas, float alpha,
 }
 
 bool Layer::getLayersUnderPointInternal(float x, float y,
-                                        std::vector<std::shared_ptr<Layer>>* results) {
+                                        std::vector<std::shared_ptr<Layer>>* results,
+                                        const std::unordered_set<const Layer*>* candidates) {
   bool hasLayerUnderPoint = false;
   for (auto item = _children.rbegin(); item != _children.rend(); ++item) {
     const auto& childLayer = *item;
@@ -1101,6 +1364,13 @@ bool Layer::getLayersUnderPointInternal(float x, float y,
       continue;
     }
 
+    // Transparent layers are still hit, but the bounds of their descendants are not kept up to
+    // date in the spatial tree.
+    auto childCandidates = childLayer->_alpha > 0 ? candidates : nullptr;
+    if (childCandidates && childCandidates->count(childLayer.get()) == 0) {
+      continue;
+    }
+
     if (nullptr != childLayer->_scrollRect) {
       auto pointInChildSpace = childLayer->globalToLocal(Point::Make(x, y));
       if (!childLayer->_scrollRect->contains(pointInChildSpace.x, pointInChildSpace.y)) {
@@ -1114,7 +1384,7 @@ bool Layer::getLayersUnderPointInternal(float x, float y,
       }
     }
 
-    if (childLayer->getLayersUnderPointInternal(x, y, results)) {
+    if (childLayer->getLayersUnderPointInternal(x, y, results, childCandidates)) {
       hasLayerUnderPoint = true;
     }
   }
@@ -1140,6 +1410,18 @@ bool Layer::hasValidMask() const {
   return _mask && _mask->root() == root() && _mask->bitFields.visible;
 }
 
+void Layer::prepareMaskMatrices() {
+  if (hasValidMask()) {
+    _mask->getGlobalMatrix();
+    getGlobalInverseMatrix();
+  }
+  for (auto& child : _children) {
+    if (child->bitFields.visible && child->_alpha > 0) {
+      child->prepareMaskMatrices();
+    }
+  }
+}
+
 void Layer::updateRenderBounds(const Matrix& renderMatrix,
                                std::shared_ptr<RegionTransformer> transformer, bool forceDirty) {
   if (!forceDirty && !bitFields.dirtyDescendents) {
@@ -1162,18 +1444,22 @@ void Layer::updateRenderBounds(const Matrix& renderMatrix,
   auto content = getContent();
   if (bitFields.dirtyContentBounds || (forceDirty && content)) {
     if (contentBounds) {
-      _root->invalidateRect(*contentBounds);
+      _root->invalidateContentRect(this, *contentBounds, true);
     } else {
       contentBounds = new Rect();
     }
     if (content) {
       *contentBounds = renderMatrix.mapRect(content->getBounds());
+      // Hit testing works with the untransformed content bounds, since filters may move the drawn
+      // area away from the content.
+      _root->updateSpatialBounds(this, *contentBounds);
       if (transformer) {
         transformer->transform(contentBounds);
       }
-      _root->invalidateRect(*contentBounds);
+      _root->invalidateContentRect(this, *contentBounds, false);
     } else {
       contentBounds->setEmpty();
+      _root->removeSpatialBounds(this);
     }
     bitFields.dirtyContentBounds = false;
   }
@@ -1248,7 +1534,7 @@ void Layer::updateBackgroundBounds(const Matrix& renderMatrix) {
   if (backgroundChanged) {
     auto layer = this;
     while (layer && !layer->bitFields.dirtyDescendents) {
-      layer->rasterizedContent = nullptr;
+      layer->clearCachedContents();
       if (layer->maskOwner) {
         break;
       }
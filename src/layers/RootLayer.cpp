@@ -17,11 +17,17 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "RootLayer.h"
+#include <algorithm>
 #include <limits>
 #include "core/utils/DecomposeRects.h"
 #include "core/utils/Log.h"
+#include "core/utils/MathExtra.h"
+#include "tgfx/core/Task.h"
 
 namespace tgfx {
+// The number of dirty layers updated by each task when the contents are updated in parallel.
+static constexpr size_t LayersPerTask = 16;
+
 static float UnionArea(const Rect& rect1, const Rect& rect2) {
   auto left = rect1.left < rect2.left ? rect1.left : rect2.left;
   auto right = rect1.right > rect2.right ? rect1.right : rect2.right;
@@ -44,10 +50,50 @@ void RootLayer::invalidateRect(const Rect& rect) {
   if (rect.isEmpty()) {
     return;
   }
-  DEBUG_ASSERT(dirtyRects.size() <= MAX_DIRTY_REGIONS);
+  DEBUG_ASSERT(dirtyRects.size() <= _maxDirtyRegions);
+  // A rect inside an existing dirty rect would be merged into it anyway, skipping it avoids the
+  // quadratic merge below.
+  for (auto& dirtyRect : dirtyRects) {
+    if (dirtyRect.contains(rect)) {
+      return;
+    }
+  }
   dirtyRects.push_back(rect);
   dirtyAreas.push_back(rect.area());
-  mergeDirtyList(dirtyRects.size() == MAX_DIRTY_REGIONS + 1);
+  mergeDirtyList(dirtyRects.size() > _maxDirtyRegions);
+}
+
+void RootLayer::invalidateContentRect(const Layer* layer, const Rect& rect, bool previous) {
+  if (occluders.empty() || rect.isEmpty()) {
+    invalidateRect(rect);
+    return;
+  }
+  for (auto& item : occluders) {
+    if (item.layer == layer) {
+      changedOccluders.insert(layer);
+      break;
+    }
+  }
+  const Layer* occluder = nullptr;
+  if (previous) {
+    occluder = findOccluder(layer);
+    if (occluder == nullptr) {
+      invalidateRect(rect);
+      return;
+    }
+  }
+  pendingRects.push_back({layer, occluder, rect});
+}
+
+void RootLayer::setMaxDirtyRegions(size_t count) {
+  count = std::clamp(count, static_cast<size_t>(1), MAX_DIRTY_REGIONS_LIMIT);
+  if (_maxDirtyRegions == count) {
+    return;
+  }
+  _maxDirtyRegions = count;
+  while (dirtyRects.size() > _maxDirtyRegions) {
+    mergeDirtyList(true);
+  }
 }
 
 bool RootLayer::mergeDirtyList(bool forceMerge) {
@@ -102,8 +148,13 @@ bool RootLayer::invalidateBackground(const Rect& drawRect, LayerStyle* layerStyl
   return !dirtyBackgrounds.empty();
 }
 
-std::vector<Rect> RootLayer::updateDirtyRegions() {
+std::vector<Rect> RootLayer::updateDirtyRegions(float occlusionScale, bool parallelContentUpdate) {
+  if (parallelContentUpdate) {
+    updateDirtyContents();
+  }
+  auto treeChanged = bitFields.dirtyDescendents;
   updateRenderBounds();
+  updateOcclusion(occlusionScale, treeChanged);
   while (mergeDirtyList(false)) {
   }
   dirtyAreas.clear();
@@ -111,10 +162,203 @@ std::vector<Rect> RootLayer::updateDirtyRegions() {
   return std::move(dirtyRects);
 }
 
+void RootLayer::updateDirtyContents() {
+  std::vector<Layer*> layers = {};
+  collectDirtyContents(&layers);
+  if (layers.size() <= LayersPerTask) {
+    // Too few to be worth the threads, updateRenderBounds() records them on the current thread.
+    return;
+  }
+  // Each layer only records its own content, so the layers can be updated independently. The
+  // bounds and dirty regions are still computed by updateRenderBounds() afterwards, in tree order.
+  auto updateContents = [&layers](size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      layers[i]->getContent();
+    }
+  };
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  for (size_t start = LayersPerTask; start < layers.size(); start += LayersPerTask) {
+    auto end = std::min(start + LayersPerTask, layers.size());
+    tasks.push_back(Task::Run([=]() { updateContents(start, end); }));
+  }
+  updateContents(0, LayersPerTask);
+  for (auto& task : tasks) {
+    task->wait();
+  }
+}
+
+void RootLayer::updateOcclusion(float occlusionScale, bool treeChanged) {
+  // The occluders of the last pass stay valid until a layer or the zoom scale changes.
+  if (!treeChanged && occlusionScale == lastOcclusionScale && pendingRects.empty()) {
+    return;
+  }
+  lastOcclusionScale = occlusionScale;
+  auto lastOccluders = std::move(occluders);
+  occluders.clear();
+  occlusionFrame++;
+  // Background styles read the pixels under them, including the ones of the covered layers.
+  if (occlusionScale > 0 && backgroundOutset <= 0) {
+    // Pixels on the edges of an occluder may be partially covered, so its rect is inset by one
+    // device pixel.
+    auto hasEffects = !_filters.empty() || !_layerStyles.empty();
+    auto canOcclude = !hasEffects && !bitFields.shouldRasterize;
+    collectOccluders(this, Matrix::I(), canOcclude, !hasEffects, 1.0f / occlusionScale);
+  }
+  // A content rect only needs no redrawing if its pixels belong to the same unchanged occluder in
+  // both the last frame and the current one.
+  for (auto& pending : pendingRects) {
+    auto occluder = pending.occluder ? pending.occluder : findOccluder(pending.layer);
+    if (!isStableOccluder(occluder, lastOccluders, pending.rect)) {
+      invalidateRect(pending.rect);
+    }
+  }
+  pendingRects.clear();
+  changedOccluders.clear();
+}
+
+void RootLayer::collectOccluders(Layer* layer, const Matrix& matrix, bool canOcclude,
+                                 bool canBeOccluded, float margin) {
+  // Children are visited from top to bottom, so all occluders collected so far are drawn above the
+  // current child.
+  for (auto i = layer->_children.rbegin(); i != layer->_children.rend(); ++i) {
+    auto child = i->get();
+    if (child->maskOwner || !child->bitFields.visible || child->_alpha <= 0) {
+      continue;
+    }
+    child->occlusionFrame = occlusionFrame;
+    child->occluder = nullptr;
+    for (auto& item : occluders) {
+      if (canBeOccluded && item.rect.contains(child->renderBounds)) {
+        child->occluder = item.layer;
+        break;
+      }
+    }
+    if (child->occluder) {
+      // The descendants are covered as well, findOccluder() resolves them to the same occluder.
+      continue;
+    }
+    auto childMatrix = child->getMatrixWithScrollRect();
+    childMatrix.postConcat(matrix);
+    auto childCanOcclude =
+        canOcclude && child->_alpha >= 1.0f &&
+        static_cast<BlendMode>(child->bitFields.blendMode) == BlendMode::SrcOver &&
+        child->_filters.empty() && !child->_scrollRect && !child->hasValidMask();
+    auto rasterized = child->bitFields.shouldRasterize;
+    // Filters and layer styles may spread the pixels of the descendants beyond their own bounds, so
+    // the descendants can't be skipped by their bounds alone.
+    auto hasEffects = !child->_filters.empty() || !child->_layerStyles.empty();
+    // The layer styles drawn above the children depend on them, so a change below a descendant
+    // occluder may still show up on top of it. The descendants of a rasterized layer are drawn
+    // through its cache.
+    collectOccluders(child, childMatrix,
+                     childCanOcclude && !rasterized && child->_layerStyles.empty(),
+                     canBeOccluded && !hasEffects, margin);
+    if (childCanOcclude && childMatrix.rectStaysRect()) {
+      auto rect = childMatrix.mapRect(child->getOpaqueBounds());
+      auto inset = margin;
+      if (rasterized) {
+        // The rasterized cache may be drawn at up to √2 times a lower scale while zooming, or at
+        // a fixed rasterization scale, so one of its texels can cover more than a device pixel.
+        auto texelSize = child->_rasterizationScale > 0.0f
+                             ? childMatrix.getMaxScale() / child->_rasterizationScale
+                             : margin * FLOAT_SQRT2;
+        inset = std::max(inset, texelSize);
+      }
+      rect.inset(inset, inset);
+      addOccluder(child, rect);
+    }
+  }
+}
+
+void RootLayer::addOccluder(const Layer* layer, const Rect& rect) {
+  if (rect.isEmpty()) {
+    return;
+  }
+  if (occluders.size() < MAX_OCCLUDERS) {
+    occluders.push_back({layer, rect});
+    return;
+  }
+  auto smallest = std::min_element(occluders.begin(), occluders.end(),
+                                   [](const Occluder& a, const Occluder& b) {
+                                     return a.rect.area() < b.rect.area();
+                                   });
+  if (smallest->rect.area() < rect.area()) {
+    *smallest = {layer, rect};
+  }
+}
+
+const Layer* RootLayer::findOccluder(const Layer* layer) const {
+  // The pass skips the descendants of a covered layer, they share the occluder of the closest
+  // ancestor it visited.
+  for (auto current = layer; current != nullptr; current = current->_parent) {
+    if (current->occlusionFrame == occlusionFrame) {
+      return current->occluder;
+    }
+  }
+  return nullptr;
+}
+
+bool RootLayer::isStableOccluder(const Layer* occluder, const std::vector<Occluder>& lastOccluders,
+                                 const Rect& rect) const {
+  if (occluder == nullptr || changedOccluders.count(occluder) > 0) {
+    return false;
+  }
+  auto findRect = [occluder](const std::vector<Occluder>& list) -> const Rect* {
+    for (auto& item : list) {
+      if (item.layer == occluder) {
+        return &item.rect;
+      }
+    }
+    return nullptr;
+  };
+  auto lastRect = findRect(lastOccluders);
+  auto currentRect = findRect(occluders);
+  return lastRect && currentRect && *lastRect == *currentRect && currentRect->contains(rect);
+}
+
+void RootLayer::removeOccluder(const Layer* layer) {
+  occluders.erase(std::remove_if(occluders.begin(), occluders.end(),
+                                 [layer](const Occluder& item) { return item.layer == layer; }),
+                  occluders.end());
+}
+
 std::optional<Rect> RootLayer::getBackgroundRect(const Rect& drawRect, float contentScale) const {
   if (backgroundOutset <= 0.f) {
     return std::nullopt;
   }
   return drawRect.makeOutset(backgroundOutset * contentScale, backgroundOutset * contentScale);
 }
+
+void RootLayer::updateSpatialBounds(Layer* layer, const Rect& bounds) {
+  if (bounds.isEmpty()) {
+    removeSpatialBounds(layer);
+    return;
+  }
+  if (layer->spatialLeafID < 0) {
+    layer->spatialLeafID = spatialTree.insert(layer, bounds);
+  } else {
+    spatialTree.update(layer->spatialLeafID, bounds);
+  }
+}
+
+void RootLayer::removeSpatialBounds(Layer* layer) {
+  if (layer->spatialLeafID < 0) {
+    return;
+  }
+  spatialTree.remove(layer->spatialLeafID);
+  layer->spatialLeafID = -1;
+}
+
+std::unordered_set<const Layer*> RootLayer::getCandidateLayers(const Point& point) const {
+  std::vector<Layer*> leaves = {};
+  spatialTree.query(point, &leaves);
+  std::unordered_set<const Layer*> candidates = {};
+  for (auto layer : leaves) {
+    const Layer* current = layer;
+    while (current && candidates.insert(current).second) {
+      current = current->_parent;
+    }
+  }
+  return candidates;
+}
 }  // namespace tgfx
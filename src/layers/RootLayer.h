@@ -19,11 +19,17 @@
 #pragma once
 
 #include <optional>
+#include <unordered_set>
+#include "layers/SpatialTree.h"
 #include "tgfx/layers/Layer.h"
 
 namespace tgfx {
-// Maximum number of dirty regions that can be tracked in the root layer.
-static constexpr size_t MAX_DIRTY_REGIONS = 3;
+// Default maximum number of dirty regions that can be tracked in the root layer.
+static constexpr size_t DEFAULT_MAX_DIRTY_REGIONS = 3;
+// Upper limit of the maximum number of dirty regions, merging costs O(n^2) per invalidation.
+static constexpr size_t MAX_DIRTY_REGIONS_LIMIT = 64;
+// Maximum number of opaque rectangles kept by the occlusion pass, the largest ones are preferred.
+static constexpr size_t MAX_OCCLUDERS = 8;
 
 /**
  * The RootLayer class represents the root layer of a display list. It is the top-level layer that
@@ -46,6 +52,27 @@ class RootLayer : public Layer {
    */
   void invalidateRect(const Rect& rect);
 
+  /**
+   * Invalidates the content bounds of the given layer. If the occlusion pass is active, the
+   * rectangle is held back until the pass of the current frame finishes, and dropped if it stays
+   * hidden behind an unchanged opaque layer in both frames. Set previous to true for the bounds
+   * the layer had in the last frame.
+   */
+  void invalidateContentRect(const Layer* layer, const Rect& rect, bool previous);
+
+  /**
+   * Returns the maximum number of dirty rectangles tracked before the closest pair is merged.
+   */
+  size_t maxDirtyRegions() const {
+    return _maxDirtyRegions;
+  }
+
+  /**
+   * Sets the maximum number of dirty rectangles tracked before the closest pair is merged. The
+   * value is clamped to [1, MAX_DIRTY_REGIONS_LIMIT].
+   */
+  void setMaxDirtyRegions(size_t count);
+
   /**
    * Returns true if any existing dirty rectangle overlaps the given drawRect for the specified
    * LayerStyle, and applies LayerStyle::filterBackground() to the dirty rectangles.
@@ -60,9 +87,25 @@ class RootLayer : public Layer {
   }
 
   /**
-   * Resets the dirty regions of the root layer and returns the list of dirty rectangles.
+   * Resets the dirty regions of the root layer and returns the list of dirty rectangles. If
+   * parallelContentUpdate is true, the dirty contents of the layers may be updated on background
+   * threads first.
    */
-  std::vector<Rect> updateDirtyRegions();
+  std::vector<Rect> updateDirtyRegions(float occlusionScale = 0.0f,
+                                       bool parallelContentUpdate = false);
+
+  /**
+   * Returns true if the last occlusion pass found the layer fully covered by the opaque layers
+   * drawn above it, in which case it can be skipped while drawing the current frame.
+   */
+  bool isOccluded(const Layer* layer) const {
+    return layer->occlusionFrame == occlusionFrame && layer->occluder != nullptr;
+  }
+
+  /**
+   * Removes the layer from the opaque rectangles of the last occlusion pass.
+   */
+  void removeOccluder(const Layer* layer);
 
   /**
    * Returns the background rectangle for the given drawRect and contentScale. If the background
@@ -70,14 +113,73 @@ class RootLayer : public Layer {
    */
   std::optional<Rect> getBackgroundRect(const Rect& drawRect, float contentScale) const;
 
+  /**
+   * Updates the content bounds of the layer in the spatial tree. The bounds are in the coordinate
+   * space of the root layer. Empty bounds remove the layer from the tree.
+   */
+  void updateSpatialBounds(Layer* layer, const Rect& bounds);
+
+  /**
+   * Removes the layer from the spatial tree if it has been added.
+   */
+  void removeSpatialBounds(Layer* layer);
+
+  /**
+   * Returns true if the bounds in the spatial tree are up to date, which means no layer has
+   * changed since the last call to updateRenderBounds().
+   */
+  bool isSpatialTreeValid() const {
+    return !bitFields.dirtyDescendents;
+  }
+
+  /**
+   * Returns the layers whose content bounds may contain the given point, together with all their
+   * ancestors. Any layer not in the returned set has nothing under the point in its subtree.
+   */
+  std::unordered_set<const Layer*> getCandidateLayers(const Point& point) const;
+
  private:
   std::vector<Rect> dirtyRects = {};
   std::vector<float> dirtyAreas = {};
+  size_t _maxDirtyRegions = DEFAULT_MAX_DIRTY_REGIONS;
+  SpatialTree spatialTree = {};
+
+  struct Occluder {
+    const Layer* layer = nullptr;
+    Rect rect = {};  // in root coordinates, already inset by the occlusion margin
+  };
+
+  struct PendingRect {
+    const Layer* layer = nullptr;
+    // The occluder from the last frame, or nullptr if it is resolved by the current frame.
+    const Layer* occluder = nullptr;
+    Rect rect = {};
+  };
+
+  std::vector<Occluder> occluders = {};
+  std::vector<PendingRect> pendingRects = {};
+  std::unordered_set<const Layer*> changedOccluders = {};
+  uint32_t occlusionFrame = 0;
+  float lastOcclusionScale = 0.0f;
 
   RootLayer() = default;
 
   bool mergeDirtyList(bool forceMerge);
 
+  void updateDirtyContents();
+
+  void updateOcclusion(float occlusionScale, bool treeChanged);
+
+  void collectOccluders(Layer* layer, const Matrix& matrix, bool canOcclude, bool canBeOccluded,
+                        float margin);
+
+  void addOccluder(const Layer* layer, const Rect& rect);
+
+  const Layer* findOccluder(const Layer* layer) const;
+
+  bool isStableOccluder(const Layer* occluder, const std::vector<Occluder>& lastOccluders,
+                        const Rect& rect) const;
+
   friend class DisplayList;
 };
 }  // namespace tgfx
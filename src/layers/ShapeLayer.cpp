@@ -37,6 +37,7 @@ void ShapeLayer::setPath(Path path) {
     return;
   }
   _shape = Shape::MakeFrom(std::move(path));
+  resetStrokeShapes(StrokeStage::Trim);
   invalidateContent();
 }
 
@@ -45,6 +46,7 @@ void ShapeLayer::setShape(std::shared_ptr<Shape> value) {
     return;
   }
   _shape = std::move(value);
+  resetStrokeShapes(StrokeStage::Trim);
   invalidateContent();
 }
 
@@ -139,6 +141,7 @@ void ShapeLayer::setLineCap(LineCap cap) {
     return;
   }
   stroke.cap = cap;
+  resetStrokeShapes(StrokeStage::Stroke);
   invalidateContent();
 }
 
@@ -147,6 +150,7 @@ void ShapeLayer::setLineJoin(LineJoin join) {
     return;
   }
   stroke.join = join;
+  resetStrokeShapes(StrokeStage::Stroke);
   invalidateContent();
 }
 
@@ -155,6 +159,7 @@ void ShapeLayer::setMiterLimit(float limit) {
     return;
   }
   stroke.miterLimit = limit;
+  resetStrokeShapes(StrokeStage::Stroke);
   invalidateContent();
 }
 
@@ -163,6 +168,7 @@ void ShapeLayer::setLineWidth(float width) {
     return;
   }
   stroke.width = width;
+  resetStrokeShapes(StrokeStage::Stroke);
   invalidateContent();
 }
 
@@ -172,6 +178,7 @@ void ShapeLayer::setLineDashPattern(const std::vector<float>& pattern) {
     return;
   }
   _lineDashPattern = pattern;
+  resetStrokeShapes(StrokeStage::Dash);
   invalidateContent();
 }
 
@@ -180,6 +187,7 @@ void ShapeLayer::setLineDashPhase(float phase) {
     return;
   }
   _lineDashPhase = phase;
+  resetStrokeShapes(StrokeStage::Dash);
   invalidateContent();
 }
 
@@ -188,6 +196,7 @@ void ShapeLayer::setLineDashAdaptive(bool adaptive) {
     return;
   }
   shapeBitFields.lineDashAdaptive = adaptive;
+  resetStrokeShapes(StrokeStage::Dash);
   invalidateContent();
 }
 
@@ -202,6 +211,7 @@ void ShapeLayer::setStrokeStart(float start) {
     return;
   }
   _strokeStart = start;
+  resetStrokeShapes(StrokeStage::Trim);
   invalidateContent();
 }
 
@@ -216,6 +226,7 @@ void ShapeLayer::setStrokeEnd(float end) {
     return;
   }
   _strokeEnd = end;
+  resetStrokeShapes(StrokeStage::Trim);
   invalidateContent();
 }
 
@@ -225,6 +236,7 @@ void ShapeLayer::setStrokeAlign(StrokeAlign align) {
     return;
   }
   shapeBitFields.strokeAlign = alignment;
+  resetStrokeShapes(StrokeStage::Stroke);
   invalidateContent();
 }
 
@@ -274,7 +286,7 @@ void ShapeLayer::onUpdateContent(LayerRecorder* recorder) {
   }
   auto fillPaints = createShapePaints(_fillStyles);
   auto strokePaints = stroke.width > 0 ? createShapePaints(_strokeStyles) : std::vector<Paint>();
-  auto strokeShape = strokePaints.empty() ? nullptr : createStrokeShape();
+  auto strokeShape = strokePaints.empty() ? nullptr : getStrokeShape();
   auto canvas = recorder->getCanvas(LayerContentType::Default);
   for (auto& paint : fillPaints) {
     canvas->drawShape(_shape, paint);
@@ -309,35 +321,56 @@ std::vector<Paint> ShapeLayer::createShapePaints(
   return paintList;
 }
 
-std::shared_ptr<Shape> ShapeLayer::createStrokeShape() const {
-  auto strokeShape = _shape;
-  if ((_strokeStart != 0 || _strokeEnd != 1)) {
-    auto pathEffect = PathEffect::MakeTrim(_strokeStart, _strokeEnd);
-    strokeShape = Shape::ApplyEffect(std::move(strokeShape), std::move(pathEffect));
-  }
-  if (!_lineDashPattern.empty()) {
-    auto dashes = _lineDashPattern;
-    if (_lineDashPattern.size() % 2 != 0) {
-      dashes.insert(dashes.end(), _lineDashPattern.begin(), _lineDashPattern.end());
+std::shared_ptr<Shape> ShapeLayer::getStrokeShape() {
+  if (strokedShape != nullptr) {
+    return strokedShape;
+  }
+  if (trimmedShape == nullptr) {
+    trimmedShape = _shape;
+    if ((_strokeStart != 0 || _strokeEnd != 1)) {
+      auto pathEffect = PathEffect::MakeTrim(_strokeStart, _strokeEnd);
+      trimmedShape = Shape::ApplyEffect(std::move(trimmedShape), std::move(pathEffect));
+    }
+  }
+  if (dashedShape == nullptr) {
+    dashedShape = trimmedShape;
+    if (!_lineDashPattern.empty()) {
+      auto dashes = _lineDashPattern;
+      if (_lineDashPattern.size() % 2 != 0) {
+        dashes.insert(dashes.end(), _lineDashPattern.begin(), _lineDashPattern.end());
+      }
+      auto dash = PathEffect::MakeDash(dashes.data(), static_cast<int>(dashes.size()),
+                                       _lineDashPhase, shapeBitFields.lineDashAdaptive);
+      dashedShape = Shape::ApplyEffect(std::move(dashedShape), std::move(dash));
     }
-    auto dash = PathEffect::MakeDash(dashes.data(), static_cast<int>(dashes.size()), _lineDashPhase,
-                                     shapeBitFields.lineDashAdaptive);
-
-    strokeShape = Shape::ApplyEffect(std::move(strokeShape), std::move(dash));
   }
   auto strokeAlign = static_cast<StrokeAlign>(shapeBitFields.strokeAlign);
   if (strokeAlign != StrokeAlign::Center) {
     auto tempStroke = stroke;
     tempStroke.width *= 2;
-    strokeShape = Shape::ApplyStroke(std::move(strokeShape), &tempStroke);
+    strokedShape = Shape::ApplyStroke(dashedShape, &tempStroke);
     if (strokeAlign == StrokeAlign::Inside) {
-      strokeShape = Shape::Merge(std::move(strokeShape), _shape, PathOp::Intersect);
+      strokedShape = Shape::Merge(std::move(strokedShape), _shape, PathOp::Intersect);
     } else {
-      strokeShape = Shape::Merge(std::move(strokeShape), _shape, PathOp::Difference);
+      strokedShape = Shape::Merge(std::move(strokedShape), _shape, PathOp::Difference);
     }
   } else {
-    strokeShape = Shape::ApplyStroke(std::move(strokeShape), &stroke);
+    strokedShape = Shape::ApplyStroke(dashedShape, &stroke);
+  }
+  return strokedShape;
+}
+
+void ShapeLayer::resetStrokeShapes(StrokeStage stage) {
+  switch (stage) {
+    case StrokeStage::Trim:
+      trimmedShape = nullptr;
+    // fallthrough
+    case StrokeStage::Dash:
+      dashedShape = nullptr;
+    // fallthrough
+    case StrokeStage::Stroke:
+      strokedShape = nullptr;
+      break;
   }
-  return strokeShape;
 }
 }  // namespace tgfx
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/layers/SolidLayer.h"
+#include "core/utils/MathExtra.h"
 
 namespace tgfx {
 std::shared_ptr<SolidLayer> SolidLayer::Make() {
@@ -81,4 +82,16 @@ void SolidLayer::onUpdateContent(LayerRecorder* recorder) {
   canvas->drawRRect(rRect, paint);
 }
 
+Rect SolidLayer::getOpaqueBounds() const {
+  if (_width == 0 || _height == 0 || !_color.isOpaque()) {
+    return Rect::MakeEmpty();
+  }
+  // The rectangle through the 45-degree points of the corner arcs lies inside the rounded rect.
+  auto radiusX = std::clamp(_radiusX, 0.0f, _width * 0.5f);
+  auto radiusY = std::clamp(_radiusY, 0.0f, _height * 0.5f);
+  auto bounds = Rect::MakeWH(_width, _height);
+  bounds.inset(radiusX * (1.0f - 1.0f / FLOAT_SQRT2), radiusY * (1.0f - 1.0f / FLOAT_SQRT2));
+  return bounds;
+}
+
 }  // namespace tgfx
\ No newline at end of file
@@ -0,0 +1,257 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SpatialTree.h"
+#include <algorithm>
+#include "core/utils/Log.h"
+
+namespace tgfx {
+// The margin added to the bounds of leaves, which allows layers to move slightly without
+// restructuring the tree.
+static constexpr float LEAF_MARGIN = 2.0f;
+
+static Rect Union(const Rect& a, const Rect& b) {
+  return Rect::MakeLTRB(std::min(a.left, b.left), std::min(a.top, b.top),
+                        std::max(a.right, b.right), std::max(a.bottom, b.bottom));
+}
+
+static float Perimeter(const Rect& rect) {
+  return 2.0f * (rect.width() + rect.height());
+}
+
+int SpatialTree::insert(Layer* layer, const Rect& bounds) {
+  auto leafID = allocateNode();
+  auto& leaf = nodes[static_cast<size_t>(leafID)];
+  leaf.bounds = bounds.makeOutset(LEAF_MARGIN, LEAF_MARGIN);
+  leaf.layer = layer;
+  leaf.height = 0;
+  insertLeaf(leafID);
+  _leafCount++;
+  return leafID;
+}
+
+void SpatialTree::remove(int leafID) {
+  DEBUG_ASSERT(leafID >= 0 && static_cast<size_t>(leafID) < nodes.size());
+  DEBUG_ASSERT(nodes[static_cast<size_t>(leafID)].isLeaf());
+  removeLeaf(leafID);
+  freeNode(leafID);
+  _leafCount--;
+}
+
+void SpatialTree::update(int leafID, const Rect& bounds) {
+  DEBUG_ASSERT(leafID >= 0 && static_cast<size_t>(leafID) < nodes.size());
+  auto& leaf = nodes[static_cast<size_t>(leafID)];
+  auto enlargedBounds = bounds.makeOutset(LEAF_MARGIN, LEAF_MARGIN);
+  // Keep the leaf if it still contains the bounds and is not much larger than them.
+  if (leaf.bounds.contains(bounds) && enlargedBounds.contains(leaf.bounds)) {
+    return;
+  }
+  removeLeaf(leafID);
+  nodes[static_cast<size_t>(leafID)].bounds = enlargedBounds;
+  insertLeaf(leafID);
+}
+
+void SpatialTree::query(const Point& point, std::vector<Layer*>* results) const {
+  if (rootID == -1) {
+    return;
+  }
+  std::vector<int> stack = {rootID};
+  while (!stack.empty()) {
+    auto& node = nodes[static_cast<size_t>(stack.back())];
+    stack.pop_back();
+    if (!node.bounds.contains(point.x, point.y)) {
+      continue;
+    }
+    if (node.isLeaf()) {
+      results->push_back(node.layer);
+    } else {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+int SpatialTree::allocateNode() {
+  if (freeList == -1) {
+    nodes.emplace_back();
+    return static_cast<int>(nodes.size()) - 1;
+  }
+  auto nodeID = freeList;
+  auto& node = nodes[static_cast<size_t>(nodeID)];
+  freeList = node.parent;
+  node = {};
+  return nodeID;
+}
+
+void SpatialTree::freeNode(int nodeID) {
+  auto& node = nodes[static_cast<size_t>(nodeID)];
+  node.layer = nullptr;
+  node.child1 = -1;
+  node.child2 = -1;
+  node.height = -1;
+  node.parent = freeList;
+  freeList = nodeID;
+}
+
+void SpatialTree::insertLeaf(int leafID) {
+  if (rootID == -1) {
+    rootID = leafID;
+    nodes[static_cast<size_t>(leafID)].parent = -1;
+    return;
+  }
+  // Find the best sibling for the leaf, using the perimeter of the bounds as the cost.
+  auto leafBounds = nodes[static_cast<size_t>(leafID)].bounds;
+  auto index = rootID;
+  while (!nodes[static_cast<size_t>(index)].isLeaf()) {
+    auto& node = nodes[static_cast<size_t>(index)];
+    auto perimeter = Perimeter(node.bounds);
+    auto combinedPerimeter = Perimeter(Union(node.bounds, leafBounds));
+    // The cost of creating a new parent for this node and the new leaf.
+    auto cost = 2.0f * combinedPerimeter;
+    // The minimum cost of pushing the leaf further down the tree.
+    auto inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+    float childCosts[2] = {};
+    int children[2] = {node.child1, node.child2};
+    for (int i = 0; i < 2; i++) {
+      auto& child = nodes[static_cast<size_t>(children[i])];
+      childCosts[i] = Perimeter(Union(child.bounds, leafBounds)) + inheritanceCost;
+      if (!child.isLeaf()) {
+        childCosts[i] -= Perimeter(child.bounds);
+      }
+    }
+    if (cost < childCosts[0] && cost < childCosts[1]) {
+      break;
+    }
+    index = childCosts[0] < childCosts[1] ? children[0] : children[1];
+  }
+  auto siblingID = index;
+  auto oldParentID = nodes[static_cast<size_t>(siblingID)].parent;
+  auto newParentID = allocateNode();
+  auto& newParent = nodes[static_cast<size_t>(newParentID)];
+  auto& sibling = nodes[static_cast<size_t>(siblingID)];
+  newParent.parent = oldParentID;
+  newParent.bounds = Union(leafBounds, sibling.bounds);
+  newParent.height = sibling.height + 1;
+  newParent.child1 = siblingID;
+  newParent.child2 = leafID;
+  sibling.parent = newParentID;
+  nodes[static_cast<size_t>(leafID)].parent = newParentID;
+  if (oldParentID == -1) {
+    rootID = newParentID;
+  } else {
+    auto& oldParent = nodes[static_cast<size_t>(oldParentID)];
+    if (oldParent.child1 == siblingID) {
+      oldParent.child1 = newParentID;
+    } else {
+      oldParent.child2 = newParentID;
+    }
+  }
+  refit(newParentID);
+}
+
+void SpatialTree::removeLeaf(int leafID) {
+  if (leafID == rootID) {
+    rootID = -1;
+    return;
+  }
+  auto parentID = nodes[static_cast<size_t>(leafID)].parent;
+  auto& parent = nodes[static_cast<size_t>(parentID)];
+  auto grandParentID = parent.parent;
+  auto siblingID = parent.child1 == leafID ? parent.child2 : parent.child1;
+  nodes[static_cast<size_t>(siblingID)].parent = grandParentID;
+  freeNode(parentID);
+  if (grandParentID == -1) {
+    rootID = siblingID;
+    return;
+  }
+  auto& grandParent = nodes[static_cast<size_t>(grandParentID)];
+  if (grandParent.child1 == parentID) {
+    grandParent.child1 = siblingID;
+  } else {
+    grandParent.child2 = siblingID;
+  }
+  refit(grandParentID);
+}
+
+void SpatialTree::refit(int nodeID) {
+  // Walk back up the tree fixing the heights and bounds, and rebalancing along the way.
+  auto index = nodeID;
+  while (index != -1) {
+    index = balance(index);
+    auto& node = nodes[static_cast<size_t>(index)];
+    auto& child1 = nodes[static_cast<size_t>(node.child1)];
+    auto& child2 = nodes[static_cast<size_t>(node.child2)];
+    node.height = 1 + std::max(child1.height, child2.height);
+    node.bounds = Union(child1.bounds, child2.bounds);
+    index = node.parent;
+  }
+}
+
+int SpatialTree::balance(int nodeID) {
+  auto& a = nodes[static_cast<size_t>(nodeID)];
+  if (a.isLeaf() || a.height < 2) {
+    return nodeID;
+  }
+  auto bID = a.child1;
+  auto cID = a.child2;
+  auto& b = nodes[static_cast<size_t>(bID)];
+  auto& c = nodes[static_cast<size_t>(cID)];
+  auto heightDiff = c.height - b.height;
+  if (heightDiff >= -1 && heightDiff <= 1) {
+    return nodeID;
+  }
+  // Rotate the higher child up, it takes the place of A and A becomes its first child.
+  auto upID = heightDiff > 1 ? cID : bID;
+  auto& up = nodes[static_cast<size_t>(upID)];
+  auto& other = heightDiff > 1 ? b : c;
+  auto fID = up.child1;
+  auto gID = up.child2;
+  auto& f = nodes[static_cast<size_t>(fID)];
+  auto& g = nodes[static_cast<size_t>(gID)];
+  up.child1 = nodeID;
+  up.parent = a.parent;
+  a.parent = upID;
+  if (up.parent == -1) {
+    rootID = upID;
+  } else {
+    auto& parent = nodes[static_cast<size_t>(up.parent)];
+    if (parent.child1 == nodeID) {
+      parent.child1 = upID;
+    } else {
+      parent.child2 = upID;
+    }
+  }
+  // The higher grandchild stays with the rotated node, the lower one moves to A.
+  auto keepID = f.height > g.height ? fID : gID;
+  auto moveID = f.height > g.height ? gID : fID;
+  auto& keep = nodes[static_cast<size_t>(keepID)];
+  auto& move = nodes[static_cast<size_t>(moveID)];
+  up.child2 = keepID;
+  if (heightDiff > 1) {
+    a.child2 = moveID;
+  } else {
+    a.child1 = moveID;
+  }
+  move.parent = nodeID;
+  a.bounds = Union(other.bounds, move.bounds);
+  a.height = 1 + std::max(other.height, move.height);
+  up.bounds = Union(a.bounds, keep.bounds);
+  up.height = 1 + std::max(a.height, keep.height);
+  return upID;
+}
+}  // namespace tgfx
@@ -0,0 +1,91 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "tgfx/core/Rect.h"
+
+namespace tgfx {
+class Layer;
+
+/**
+ * SpatialTree is a dynamic bounding volume hierarchy of layer bounds. Each leaf stores the bounds
+ * of a layer enlarged by a small margin, so that small movements can be applied without touching
+ * the tree. Insertions, removals and updates take O(log n) time, and the tree is kept balanced by
+ * tree rotations.
+ */
+class SpatialTree {
+ public:
+  /**
+   * Inserts a leaf for the layer with the given bounds, and returns the id of the new leaf.
+   */
+  int insert(Layer* layer, const Rect& bounds);
+
+  /**
+   * Removes the leaf with the given id from the tree.
+   */
+  void remove(int leafID);
+
+  /**
+   * Updates the bounds of the leaf with the given id. The tree is only restructured if the new
+   * bounds are not contained by the enlarged bounds of the leaf anymore.
+   */
+  void update(int leafID, const Rect& bounds);
+
+  /**
+   * Appends the layers of all leaves whose bounds contain the given point to the results.
+   */
+  void query(const Point& point, std::vector<Layer*>* results) const;
+
+  /**
+   * Returns the number of leaves in the tree.
+   */
+  size_t leafCount() const {
+    return _leafCount;
+  }
+
+ private:
+  struct Node {
+    Rect bounds = {};
+    Layer* layer = nullptr;
+    // The parent of the node, or the next free node if the node is in the free list.
+    int parent = -1;
+    int child1 = -1;
+    int child2 = -1;
+    // Leaves have a height of 0, free nodes have a height of -1.
+    int height = -1;
+
+    bool isLeaf() const {
+      return child1 == -1;
+    }
+  };
+
+  std::vector<Node> nodes = {};
+  int rootID = -1;
+  int freeList = -1;
+  size_t _leafCount = 0;
+
+  int allocateNode();
+  void freeNode(int nodeID);
+  void insertLeaf(int leafID);
+  void removeLeaf(int leafID);
+  void refit(int nodeID);
+  int balance(int nodeID);
+};
+}  // namespace tgfx
@@ -21,6 +21,7 @@
 namespace tgfx {
 
 std::shared_ptr<ImageFilter> LayerFilter::getImageFilter(float scale) {
+  std::lock_guard<std::mutex> autoLock(locker);
   if (lastScale != scale || dirty) {
     lastFilter = onCreateImageFilter(scale);
     lastScale = scale;
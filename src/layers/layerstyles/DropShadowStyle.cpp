@@ -124,6 +124,7 @@ void DropShadowStyle::onDraw(Canvas* canvas, std::shared_ptr<Image> content, flo
 }
 
 std::shared_ptr<ImageFilter> DropShadowStyle::getShadowFilter(float scale) {
+  std::lock_guard<std::mutex> autoLock(locker);
   if (shadowFilter && scale == currentScale) {
     return shadowFilter;
   }
@@ -101,6 +101,7 @@ void InnerShadowStyle::onDraw(Canvas* canvas, std::shared_ptr<Image> content, fl
 }
 
 std::shared_ptr<ImageFilter> InnerShadowStyle::getShadowFilter(float scale) {
+  std::lock_guard<std::mutex> autoLock(locker);
   if (shadowFilter && scale == currentScale) {
     return shadowFilter;
   }
@@ -16,6 +16,7 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <set>
 #include "core/PathRef.h"
 #include "core/Records.h"
 #include "core/images/ResourceImage.h"
@@ -23,6 +24,7 @@
 #include "core/images/TransformImage.h"
 #include "core/shapes/AppendShape.h"
 #include "gpu/DrawingManager.h"
+#include "gpu/GlobalCache.h"
 #include "gpu/RenderContext.h"
 #include "gpu/Texture.h"
 #include "gpu/opengl/GLCaps.h"
@@ -2623,4 +2625,161 @@ TGFX_TEST(CanvasTest, RotateImageRect) {
   context->flush();
   EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/RotateImageRect"));
 }
+TGFX_TEST(CanvasTest, AlternatingClipMasks) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  auto canvas = surface->getCanvas();
+  Path clipA = {};
+  clipA.moveTo(10, 10);
+  clipA.lineTo(60, 10);
+  clipA.lineTo(60, 30);
+  clipA.lineTo(30, 30);
+  clipA.lineTo(30, 60);
+  clipA.lineTo(10, 60);
+  clipA.close();
+  auto clipB = clipA;
+  clipB.transform(Matrix::MakeTrans(10, 10));
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  canvas->save();
+  canvas->clipPath(clipA);
+  canvas->drawRect(Rect::MakeWH(100, 100), paint);
+  canvas->save();
+  canvas->clipPath(clipB);
+  paint.setColor(Color::Blue());
+  canvas->drawRect(Rect::MakeWH(100, 100), paint);
+  canvas->restore();
+  // The restored clip is the same path as before, so its mask is reused.
+  paint.setColor(Color::Green());
+  canvas->drawRect(Rect::MakeWH(100, 100), paint);
+  canvas->restore();
+  // Flushes the last clipped draw.
+  canvas->drawRect(Rect::MakeWH(1, 1), paint);
+  auto compositor = surface->renderContext->opsCompositor;
+  ASSERT_TRUE(compositor != nullptr);
+  EXPECT_EQ(compositor->clipMasks.size(), 2u);
+  context->flush();
+}
+
+TGFX_TEST(CanvasTest, AnalyticClips) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  auto canvas = surface->getCanvas();
+  canvas->clear();
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  Path rRect = {};
+  rRect.addRoundRect(Rect::MakeXYWH(10, 10, 30, 30), 8, 8);
+  canvas->save();
+  canvas->clipPath(rRect);
+  canvas->drawRect(Rect::MakeWH(100, 100), paint);
+  canvas->restore();
+  Path oval = {};
+  oval.addOval(Rect::MakeXYWH(60, 10, 30, 20));
+  canvas->save();
+  canvas->clipPath(oval);
+  canvas->drawRect(Rect::MakeWH(100, 100), paint);
+  canvas->restore();
+  canvas->save();
+  canvas->translate(50, 70);
+  canvas->rotate(30);
+  canvas->clipRect(Rect::MakeXYWH(-15, -15, 30, 30));
+  canvas->drawRect(Rect::MakeXYWH(-50, -50, 100, 100), paint);
+  canvas->restore();
+  // Flushes the last clipped draw.
+  canvas->drawRect(Rect::MakeWH(1, 1), paint);
+  auto compositor = surface->renderContext->opsCompositor;
+  ASSERT_TRUE(compositor != nullptr);
+  EXPECT_TRUE(compositor->clipMasks.empty());
+  context->flush();
+  auto info = ImageInfo::Make(1, 1, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  uint32_t pixel = 0;
+  EXPECT_TRUE(surface->readPixels(info, &pixel, 25, 25));
+  EXPECT_EQ(pixel, 0xFF0000FFu);
+  EXPECT_TRUE(surface->readPixels(info, &pixel, 11, 11));
+  EXPECT_EQ(pixel, 0u);
+  EXPECT_TRUE(surface->readPixels(info, &pixel, 75, 20));
+  EXPECT_EQ(pixel, 0xFF0000FFu);
+  EXPECT_TRUE(surface->readPixels(info, &pixel, 61, 11));
+  EXPECT_EQ(pixel, 0u);
+}
+
+TGFX_TEST(CanvasTest, SharedClipMasks) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto makeClip = []() {
+    Path clip = {};
+    clip.moveTo(10, 10);
+    clip.lineTo(60, 10);
+    clip.lineTo(60, 30);
+    clip.lineTo(30, 30);
+    clip.lineTo(30, 60);
+    clip.lineTo(10, 60);
+    clip.close();
+    return clip;
+  };
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  std::vector<std::shared_ptr<TextureProxy>> clipTextures = {};
+  for (int i = 0; i < 2; i++) {
+    // Each surface rebuilds the clip path, so only its content matches the previous one.
+    auto surface = Surface::Make(context, 100, 100);
+    auto canvas = surface->getCanvas();
+    canvas->save();
+    canvas->clipPath(makeClip());
+    canvas->drawRect(Rect::MakeWH(100, 100), paint);
+    canvas->restore();
+    canvas->drawRect(Rect::MakeWH(1, 1), paint);
+    auto compositor = surface->renderContext->opsCompositor;
+    ASSERT_TRUE(compositor != nullptr);
+    ASSERT_EQ(compositor->clipMasks.size(), 1u);
+    clipTextures.push_back(compositor->clipMasks.front().second);
+    context->flush();
+  }
+  EXPECT_TRUE(clipTextures[0] != nullptr);
+  EXPECT_EQ(clipTextures[0], clipTextures[1]);
+  // The masks live in the ResourceCache, so they are purged like any other unused texture.
+  clipTextures.clear();
+  EXPECT_GT(context->purgeableBytes(), 0u);
+  context->purgeResourcesUntilMemoryTo(0);
+  EXPECT_EQ(context->purgeableBytes(), 0u);
+}
+
+TGFX_TEST(CanvasTest, GradientAtlas) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  context->flushAndSubmit();
+  auto globalCache = context->globalCache();
+  float positions[] = {0.0f, 0.3f, 0.6f, 1.0f};
+  auto getGradient = [&](float value, int* row) {
+    Color colors[] = {Color::Red(), Color::Green(), Color::Blue(), {value, value, value, 1.0f}};
+    return globalCache->getGradient(colors, positions, 4, row);
+  };
+  int row = -1;
+  auto atlas = getGradient(0.0f, &row);
+  ASSERT_TRUE(atlas != nullptr);
+  auto rowCount = atlas->height();
+  std::set<int> rows = {row};
+  for (int i = 1; i < rowCount; ++i) {
+    auto gradient = getGradient(static_cast<float>(i) / static_cast<float>(rowCount), &row);
+    // Distinct gradients share the atlas texture, each with its own row.
+    EXPECT_EQ(gradient, atlas);
+    rows.insert(row);
+  }
+  EXPECT_EQ(rows.size(), static_cast<size_t>(rowCount));
+  // Every row is used by the pending flush, so a new gradient can't evict any of them.
+  auto gradient = getGradient(2.0f, &row);
+  ASSERT_TRUE(gradient != nullptr);
+  EXPECT_NE(gradient, atlas);
+  EXPECT_EQ(row, 0);
+  context->flushAndSubmit();
+  gradient = getGradient(2.0f, &row);
+  EXPECT_EQ(gradient, atlas);
+}
 }  // namespace tgfx
@@ -25,6 +25,7 @@
 #include "gpu/RenderContext.h"
 #include "gpu/Texture.h"
 #include "gpu/opengl/GLCaps.h"
+#include "gpu/ops/DstTextureCopyOp.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/Surface.h"
@@ -96,4 +97,61 @@ TGFX_TEST(DstTextureTest, OutOfRenderTarget) {
   EXPECT_TRUE(Baseline::Compare(surface, "DstTextureTest/OutOfRenderTarget"));
 }
 
+TGFX_TEST(DstTextureTest, SharedDstCopy) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  if (context->caps()->frameBufferFetchSupport) {
+    return;
+  }
+  auto renderTarget = RenderTarget::Make(context, 400, 300);
+  auto backendRenderTarget = renderTarget->getBackendRenderTarget();
+  auto surface = Surface::MakeFrom(context, backendRenderTarget, ImageOrigin::BottomLeft);
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  auto paint = Paint();
+  paint.setColor(Color::FromRGBA(255, 0, 0));
+  paint.setBlendMode(BlendMode::Multiply);
+  auto path = Path();
+  path.addOval(Rect::MakeXYWH(20, 20, 100, 100));
+  canvas->drawPath(path, paint);
+  path.reset();
+  path.addOval(Rect::MakeXYWH(200, 20, 100, 100));
+  canvas->drawPath(path, paint);
+  auto compositor = surface->renderContext->opsCompositor;
+  ASSERT_TRUE(compositor != nullptr);
+  auto countCopyOps = [&]() {
+    compositor->flushPendingOps();
+    size_t count = 0;
+    for (auto& op : compositor->ops) {
+      if (dynamic_cast<DstTextureCopyOp*>(op.get()) != nullptr) {
+        count++;
+      }
+    }
+    return count;
+  };
+  // Draws reading back from areas that haven't changed share the same copy.
+  EXPECT_EQ(countCopyOps(), 1u);
+  path.reset();
+  path.addOval(Rect::MakeXYWH(60, 60, 100, 100));
+  canvas->drawPath(path, paint);
+  // The area read by this draw has changed since the last copy, so it needs a new one.
+  EXPECT_EQ(countCopyOps(), 2u);
+  auto rectPaint = Paint();
+  rectPaint.setColor(Color::Blue());
+  canvas->drawRect(Rect::MakeXYWH(320, 200, 40, 40), rectPaint);
+  path.reset();
+  path.addOval(Rect::MakeXYWH(200, 150, 80, 80));
+  canvas->drawPath(path, paint);
+  // Draws that don't read back from the render target only dirty the area they cover.
+  EXPECT_EQ(countCopyOps(), 2u);
+  auto copyBounds = Rect::MakeEmpty();
+  for (auto& copyOp : compositor->dstCopyOps) {
+    copyBounds.join(copyOp->srcRect());
+  }
+  // The copy texture only covers the areas read by the draws.
+  EXPECT_EQ(copyBounds, Rect::MakeLTRB(19, 69, 301, 281));
+  context->flushAndSubmit();
+}
+
 }  // namespace tgfx
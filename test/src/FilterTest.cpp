@@ -16,15 +16,25 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include "CornerPinEffect.h"
 #include "core/filters/ColorImageFilter.h"
+#include "core/filters/ComposeImageFilter.h"
 #include "core/filters/DropShadowImageFilter.h"
 #include "core/filters/GaussianBlurImageFilter.h"
 #include "core/filters/InnerShadowImageFilter.h"
+#include "core/filters/MatrixColorFilter.h"
+#include "core/filters/RuntimeImageFilter.h"
+#include "core/images/TextureImage.h"
 #include "core/shaders/GradientShader.h"
 #include "core/shaders/ImageShader.h"
+#include "core/utils/Types.h"
+#include "gpu/DrawingManager.h"
+#include "gpu/Resource.h"
+#include "gpu/TPArgs.h"
+#include "gpu/Texture.h"
 #include "gtest/gtest.h"
 #include "tgfx/core/BlendMode.h"
 #include "tgfx/core/Color.h"
@@ -341,6 +351,69 @@ TGFX_TEST(FilterTest, RuntimeEffect) {
   EXPECT_TRUE(Baseline::Compare(surface, "FilterTest/RuntimeEffect"));
 }
 
+TGFX_TEST(FilterTest, RuntimeEffectBatch) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto image = MakeImage("resources/assets/bridge.jpg");
+  ASSERT_TRUE(image != nullptr);
+  auto firstFilter = std::static_pointer_cast<RuntimeImageFilter>(ImageFilter::Runtime(
+      CornerPinEffect::Make({484, 54}, {764, 80}, {764, 504}, {482, 512})));
+  auto secondFilter = std::static_pointer_cast<RuntimeImageFilter>(
+      ImageFilter::Runtime(CornerPinEffect::Make({0, 0}, {400, 20}, {420, 300}, {10, 280})));
+  auto imageBounds = Rect::MakeWH(image->width(), image->height());
+  TPArgs args(context, 0, false);
+  auto clipBounds = firstFilter->filterBounds(imageBounds);
+  clipBounds.roundOut();
+  EXPECT_TRUE(firstFilter->lockTextureProxy(image, clipBounds, args) != nullptr);
+  clipBounds = secondFilter->filterBounds(imageBounds);
+  clipBounds.roundOut();
+  EXPECT_TRUE(secondFilter->lockTextureProxy(image, clipBounds, args) != nullptr);
+  auto drawingManager = context->drawingManager();
+  auto runtimeTask = drawingManager->lastRuntimeTask;
+  ASSERT_TRUE(runtimeTask != nullptr);
+  EXPECT_EQ(drawingManager->renderTasks.size(), 1u);
+  EXPECT_EQ(runtimeTask->runs.size(), 2u);
+  // Both runs share the same source texture.
+  EXPECT_EQ(runtimeTask->inputTextures.size(), 1u);
+  EXPECT_TRUE(context->flush());
+  EXPECT_TRUE(drawingManager->lastRuntimeTask == nullptr);
+}
+
+TGFX_TEST(FilterTest, RuntimeEffectChain) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto image = MakeImage("resources/assets/bridge.jpg");
+  ASSERT_TRUE(image != nullptr);
+  auto firstFilter = std::static_pointer_cast<RuntimeImageFilter>(ImageFilter::Runtime(
+      CornerPinEffect::Make({484, 54}, {764, 80}, {764, 504}, {482, 512})));
+  auto secondFilter = std::static_pointer_cast<RuntimeImageFilter>(
+      ImageFilter::Runtime(CornerPinEffect::Make({20, 10}, {260, 40}, {270, 430}, {0, 400})));
+  TPArgs args(context, 0, false);
+  auto clipBounds = firstFilter->filterBounds(Rect::MakeWH(image->width(), image->height()));
+  clipBounds.roundOut();
+  auto firstProxy = firstFilter->lockTextureProxy(image, clipBounds, args);
+  ASSERT_TRUE(firstProxy != nullptr);
+  auto firstImage = TextureImage::Wrap(firstProxy);
+  ASSERT_TRUE(firstImage != nullptr);
+  clipBounds = secondFilter->filterBounds(Rect::MakeWH(firstImage->width(), firstImage->height()));
+  clipBounds.roundOut();
+  auto secondProxy = secondFilter->lockTextureProxy(firstImage, clipBounds, args);
+  ASSERT_TRUE(secondProxy != nullptr);
+  auto runtimeTask = context->drawingManager()->lastRuntimeTask;
+  ASSERT_TRUE(runtimeTask != nullptr);
+  EXPECT_EQ(runtimeTask->runs.size(), 2u);
+  // The second run reads the target of the first run in the same task.
+  auto& inputTextures = runtimeTask->inputTextures;
+  EXPECT_TRUE(std::find(inputTextures.begin(), inputTextures.end(), firstProxy) !=
+              inputTextures.end());
+  auto surface = Surface::Make(context, 400, 500);
+  auto canvas = surface->getCanvas();
+  canvas->drawImage(TextureImage::Wrap(secondProxy), 50, 30);
+  EXPECT_TRUE(Baseline::Compare(surface, "FilterTest/RuntimeEffectChain"));
+}
+
 TGFX_TEST(FilterTest, InnerShadow) {
   ContextScope scope;
   auto context = scope.getContext();
@@ -736,4 +809,148 @@ TGFX_TEST(FilterTest, GaussianBlurImageFilter) {
   context->flush();
   EXPECT_TRUE(Baseline::Compare(surface, "FilterTest/GaussianBlurImageFilter"));
 }
+
+TGFX_TEST(FilterTest, LargeSigmaGaussianBlur) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto sourceSurface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(sourceSurface != nullptr);
+  sourceSurface->getCanvas()->clear(Color::White());
+  auto image = sourceSurface->makeImageSnapshot();
+  auto surface = Surface::Make(context, 400, 400);
+  ASSERT_TRUE(surface != nullptr);
+  // A sigma this large takes the downsample chain before the separable passes.
+  auto gaussianBlurFilter = std::make_shared<GaussianBlurImageFilter>(50, 50, TileMode::Decal);
+  auto offset = Point::Make(0, 0);
+  image = image->makeWithFilter(gaussianBlurFilter, &offset);
+  ASSERT_TRUE(image != nullptr);
+  auto canvas = surface->getCanvas();
+  canvas->drawImage(image, 150 + offset.x, 150 + offset.y);
+  auto info = ImageInfo::Make(1, 1, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  uint8_t center[4] = {};
+  EXPECT_TRUE(surface->readPixels(info, center, 200, 200));
+  EXPECT_GT(center[3], 0);
+  uint8_t left[4] = {};
+  uint8_t right[4] = {};
+  EXPECT_TRUE(surface->readPixels(info, left, 120, 200));
+  EXPECT_TRUE(surface->readPixels(info, right, 279, 200));
+  EXPECT_GT(left[3], 0);
+  EXPECT_LT(left[3], center[3]);
+  EXPECT_NEAR(left[3], right[3], 8);
+}
+
+TGFX_TEST(FilterTest, GaussianBlurNonUnitScale) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto image = MakeImage("resources/apitest/rotation.jpg");
+  ASSERT_TRUE(image != nullptr);
+  image = image->makeRasterized(0.1f);
+  ASSERT_TRUE(image != nullptr);
+  auto surface = Surface::Make(context, image->width() + 100, image->height() + 100);
+  ASSERT_TRUE(surface != nullptr);
+  // A sigma of 1.5 times MAX_BLUR_SIGMA scales the source down by less than half, so every
+  // horizontal step covers one and a half source texels and the taps must not be merged.
+  auto gaussianBlurFilter = std::make_shared<GaussianBlurImageFilter>(15, 15, TileMode::Decal);
+  auto offset = Point::Make(0, 0);
+  image = image->makeWithFilter(gaussianBlurFilter, &offset);
+  ASSERT_TRUE(image != nullptr);
+  auto canvas = surface->getCanvas();
+  canvas->drawImage(image, 50 + offset.x, 50 + offset.y);
+  context->flush();
+  EXPECT_TRUE(Baseline::Compare(surface, "FilterTest/GaussianBlurNonUnitScale"));
+}
+
+TGFX_TEST(FilterTest, CachedFilterOutput) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto image = MakeImage("resources/apitest/image_as_mask.png");
+  ASSERT_TRUE(image != nullptr);
+  auto filter = ImageFilter::DropShadow(5, 5, 10, 10, Color::Black());
+  auto filterImage = image->makeWithFilter(filter);
+  ASSERT_TRUE(filterImage != nullptr);
+  auto surface = Surface::Make(context, filterImage->width(), filterImage->height());
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  // The first draw applies the filter directly, outputs drawn only once are never cached.
+  canvas->drawImage(filterImage);
+  context->flush();
+  auto filterBounds = filter->filterBounds(Rect::MakeWH(image->width(), image->height()));
+  auto cacheKey = filter->getCacheKey(image.get(), filterBounds, false);
+  ASSERT_FALSE(cacheKey.empty());
+  EXPECT_TRUE(Resource::Find<Texture>(context, cacheKey) == nullptr);
+  // An equal filter recreated for the next draw of the same source finds the output drawn before.
+  filter = ImageFilter::DropShadow(5, 5, 10, 10, Color::Black());
+  filterImage = image->makeWithFilter(filter);
+  ASSERT_TRUE(filterImage != nullptr);
+  canvas->clear();
+  canvas->drawImage(filterImage);
+  context->flush();
+  EXPECT_TRUE(filter->getCacheKey(image.get(), filterBounds, false) == cacheKey);
+  auto texture = Resource::Find<Texture>(context, cacheKey);
+  ASSERT_TRUE(texture != nullptr);
+  // Drawing the same filtered image again samples the cached output instead of filtering again.
+  canvas->clear();
+  canvas->drawImage(filterImage);
+  context->flush();
+  EXPECT_EQ(Resource::Find<Texture>(context, cacheKey), texture);
+}
+
+TGFX_TEST(FilterTest, FuseColorFilters) {
+  auto scaleFilter = ColorFilter::Matrix({0.5f, 0, 0, 0, 0,  // red
+                                          0, 0.5f, 0, 0, 0,  // green
+                                          0, 0, 0.5f, 0, 0,  // blue
+                                          0, 0, 0, 1, 0});
+  auto offsetFilter = ColorFilter::Matrix({1, 0, 0, 0, 0.25f,  // red
+                                           0, 1, 0, 0, 0.25f,  // green
+                                           0, 0, 1, 0, 0.25f,  // blue
+                                           0, 0, 0, 1, 0});
+  auto fusedFilter = ColorFilter::Compose(scaleFilter, offsetFilter);
+  ASSERT_TRUE(fusedFilter != nullptr);
+  ASSERT_EQ(Types::Get(fusedFilter.get()), Types::ColorFilterType::Matrix);
+  auto& matrix = static_cast<MatrixColorFilter*>(fusedFilter.get())->matrix;
+  EXPECT_FLOAT_EQ(matrix[0], 0.5f);
+  EXPECT_FLOAT_EQ(matrix[4], 0.25f);
+  EXPECT_FLOAT_EQ(matrix[18], 1.0f);
+  // The offset matrix may exceed 1, so its output is clamped and can't be folded.
+  auto composeFilter = ColorFilter::Compose(offsetFilter, scaleFilter);
+  EXPECT_EQ(Types::Get(composeFilter.get()), Types::ColorFilterType::Compose);
+
+  auto imageFilter = ImageFilter::Compose({ImageFilter::ColorFilter(scaleFilter),
+                                           ImageFilter::ColorFilter(ColorFilter::Luma()),
+                                           ImageFilter::Blur(5, 5),
+                                           ImageFilter::ColorFilter(offsetFilter)});
+  ASSERT_TRUE(imageFilter != nullptr);
+  ASSERT_EQ(Types::Get(imageFilter.get()), Types::ImageFilterType::Compose);
+  auto& filters = static_cast<ComposeImageFilter*>(imageFilter.get())->filters;
+  ASSERT_EQ(filters.size(), 3u);
+  EXPECT_EQ(Types::Get(filters[0].get()), Types::ImageFilterType::Color);
+  EXPECT_EQ(Types::Get(filters[1].get()), Types::ImageFilterType::Blur);
+  EXPECT_EQ(Types::Get(filters[2].get()), Types::ImageFilterType::Color);
+
+  // A matrix whose alpha depends on more than the input alpha can't be folded, since the colors of
+  // a transparent inner output are lost between the stages.
+  auto clearAlphaFilter = ColorFilter::Matrix({1, 0, 0, 0, 0,  // red
+                                               0, 1, 0, 0, 0,  // green
+                                               0, 0, 1, 0, 0,  // blue
+                                               0, 0, 0, 0, 0});
+  auto restoreAlphaFilter = ColorFilter::Matrix({1, 0, 0, 0, 0,  // red
+                                                 0, 1, 0, 0, 0,  // green
+                                                 0, 0, 1, 0, 0,  // blue
+                                                 0, 0, 0, 0, 1});
+  composeFilter = ColorFilter::Compose(clearAlphaFilter, restoreAlphaFilter);
+  ASSERT_TRUE(composeFilter != nullptr);
+  EXPECT_EQ(Types::Get(composeFilter.get()), Types::ColorFilterType::Compose);
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 10, 10);
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  paint.setColorFilter(composeFilter);
+  surface->getCanvas()->drawRect(Rect::MakeWH(10, 10), paint);
+  EXPECT_EQ(surface->getColor(5, 5), Color::Black());
+}
 }  // namespace tgfx
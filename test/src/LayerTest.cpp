@@ -20,7 +20,9 @@
 #include <vector>
 #include "core/filters/BlurImageFilter.h"
 #include "core/shaders/GradientShader.h"
+#include "core/utils/Types.h"
 #include "gpu/proxies/RenderTargetProxy.h"
+#include "layers/DrawArgs.h"
 #include "layers/RootLayer.h"
 #include "layers/contents/RasterizedContent.h"
 #include "tgfx/core/PathEffect.h"
@@ -2955,4 +2957,552 @@ TGFX_TEST(LayerTest, PartialInnerShadow) {
   displayList.render(surface.get());
   EXPECT_TRUE(Baseline::Compare(surface, "LayerTest/PartialInnerShadow"));
 }
+
+TGFX_TEST(LayerTest, HitTestWithSpatialTree) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 200);
+  DisplayList displayList;
+  auto group = Layer::Make();
+  displayList.root()->addChild(group);
+  std::vector<std::shared_ptr<SolidLayer>> layers = {};
+  for (int i = 0; i < 400; i++) {
+    auto layer = SolidLayer::Make();
+    layer->setName("solid_" + std::to_string(i));
+    layer->setWidth(15);
+    layer->setHeight(15);
+    layer->setColor(Color::Red());
+    layer->setMatrix(Matrix::MakeTrans(static_cast<float>(i % 20) * 10.0f,
+                                       static_cast<float>(i / 20) * 10.0f));
+    group->addChild(layer);
+    layers.push_back(layer);
+  }
+  layers[42]->setAlpha(0.0f);
+  layers[43]->setVisible(false);
+  layers[44]->setScrollRect(Rect::MakeXYWH(0, 0, 5, 5));
+  auto hiddenChild = SolidLayer::Make();
+  hiddenChild->setWidth(10);
+  hiddenChild->setHeight(10);
+  layers[42]->addChild(hiddenChild);
+  std::vector<Point> points = {{25, 25}, {32, 22}, {44, 21}, {120, 55}, {195, 195}, {250, 10}};
+  // Before the first render, the spatial tree is not ready yet and all layers are traversed.
+  std::vector<std::vector<std::shared_ptr<Layer>>> expectedLayers = {};
+  std::vector<bool> expectedHits = {};
+  for (auto& point : points) {
+    expectedLayers.push_back(displayList.root()->getLayersUnderPoint(point.x, point.y));
+    expectedHits.push_back(displayList.root()->hitTestPoint(point.x, point.y));
+  }
+  displayList.render(surface.get());
+  for (size_t i = 0; i < points.size(); i++) {
+    EXPECT_EQ(displayList.root()->getLayersUnderPoint(points[i].x, points[i].y),
+              expectedLayers[i]);
+    EXPECT_EQ(displayList.root()->hitTestPoint(points[i].x, points[i].y), expectedHits[i]);
+  }
+  EXPECT_FALSE(displayList.root()->hitTestPoint(250, 10));
+  EXPECT_TRUE(displayList.root()->getLayersUnderPoint(250, 10).empty());
+
+  layers[0]->setMatrix(Matrix::MakeTrans(250, 0));
+  layers[1]->removeFromParent();
+  displayList.render(surface.get());
+  auto result = displayList.root()->getLayersUnderPoint(250, 10);
+  ASSERT_EQ(result.size(), 3u);
+  EXPECT_EQ(result[0], layers[0]);
+  EXPECT_EQ(result[1], group);
+  EXPECT_TRUE(displayList.root()->getLayersUnderPoint(12, 2).empty());
+}
+
+TGFX_TEST(LayerTest, GlobalMatrixCache) {
+  auto parent = Layer::Make();
+  auto child = Layer::Make();
+  auto grandChild = Layer::Make();
+  parent->addChild(child);
+  child->addChild(grandChild);
+  child->setMatrix(Matrix::MakeTrans(10, 20));
+  grandChild->setMatrix(Matrix::MakeScale(2, 2));
+  auto expected = Matrix::MakeTrans(10, 20);
+  expected.preScale(2, 2);
+  EXPECT_EQ(grandChild->getGlobalMatrix(), expected);
+  EXPECT_EQ(grandChild->globalToLocal(Point::Make(30, 40)), Point::Make(10, 10));
+  // Changes that don't affect the transform keep the cached matrices.
+  child->setAlpha(0.5f);
+  parent->addChild(Layer::Make());
+  EXPECT_TRUE(grandChild->globalMatrixValid);
+  EXPECT_TRUE(grandChild->globalInverseValid);
+  // Changing an ancestor must invalidate the cached matrices of the descendants.
+  child->setMatrix(Matrix::MakeTrans(5, 5));
+  expected = Matrix::MakeTrans(5, 5);
+  expected.preScale(2, 2);
+  EXPECT_EQ(grandChild->getGlobalMatrix(), expected);
+  EXPECT_EQ(grandChild->localToGlobal(Point::Make(10, 10)), Point::Make(25, 25));
+  child->setScrollRect(Rect::MakeXYWH(5, 5, 100, 100));
+  EXPECT_EQ(grandChild->localToGlobal(Point::Make(10, 10)), Point::Make(20, 20));
+  // Removing a layer makes it the top-level layer of its subtree.
+  child->removeFromParent();
+  EXPECT_EQ(child->getGlobalMatrix(), Matrix::I());
+  EXPECT_EQ(grandChild->getGlobalMatrix(), Matrix::MakeScale(2, 2));
+  grandChild->setMatrix(Matrix::MakeScale(0, 0));
+  EXPECT_EQ(grandChild->globalToLocal(Point::Make(10, 10)), Point::Make(0, 0));
+}
+
+TGFX_TEST(LayerTest, ParallelContentUpdate) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 200);
+  DisplayList displayList;
+  displayList.setAllowParallelContentUpdate(true);
+  std::vector<std::shared_ptr<ShapeLayer>> layers = {};
+  for (int i = 0; i < 100; i++) {
+    auto layer = ShapeLayer::Make();
+    Path path = {};
+    path.addOval(Rect::MakeWH(10, 10));
+    layer->setPath(path);
+    layer->setFillStyle(SolidColor::Make(Color::Blue()));
+    layer->setStrokeStyle(SolidColor::Make(Color::Red()));
+    layer->setLineWidth(2);
+    layer->setLineDashPattern({3, 2});
+    layer->setMatrix(Matrix::MakeTrans(static_cast<float>(i % 10) * 20.0f,
+                                       static_cast<float>(i / 10) * 20.0f));
+    displayList.root()->addChild(layer);
+    layers.push_back(layer);
+  }
+  layers[7]->setVisible(false);
+  displayList.render(surface.get());
+  for (size_t i = 0; i < layers.size(); i++) {
+    auto& layer = layers[i];
+    // Hidden layers are not updated until they become visible.
+    EXPECT_EQ(layer->bitFields.dirtyContent, i == 7);
+    if (i != 7) {
+      ASSERT_TRUE(layer->layerContent != nullptr);
+      auto bounds = layer->getGlobalMatrix().mapRect(layer->layerContent->getBounds());
+      EXPECT_TRUE(layer->renderBounds.contains(bounds));
+    }
+  }
+}
+
+TGFX_TEST(LayerTest, MaxDirtyRegions) {
+  DisplayList displayList;
+  EXPECT_EQ(displayList.maxDirtyRegions(), 3);
+  auto root = static_cast<RootLayer*>(displayList.root());
+  std::vector<Rect> rects = {Rect::MakeXYWH(0, 0, 10, 10), Rect::MakeXYWH(990, 0, 10, 10),
+                             Rect::MakeXYWH(0, 990, 10, 10), Rect::MakeXYWH(990, 990, 10, 10),
+                             Rect::MakeXYWH(500, 500, 10, 10)};
+  for (auto& rect : rects) {
+    root->invalidateRect(rect);
+  }
+  auto dirtyRegions = root->updateDirtyRegions();
+  EXPECT_EQ(dirtyRegions.size(), 3u);
+  float totalArea = 0;
+  for (auto& region : dirtyRegions) {
+    totalArea += region.area();
+  }
+  EXPECT_GT(totalArea, 5000.0f);
+
+  displayList.setMaxDirtyRegions(8);
+  EXPECT_EQ(displayList.maxDirtyRegions(), 8);
+  for (auto& rect : rects) {
+    root->invalidateRect(rect);
+    // Invalidating an area that is already dirty adds no region.
+    root->invalidateRect(Rect::MakeXYWH(rect.left + 2, rect.top + 2, 5, 5));
+  }
+  dirtyRegions = root->updateDirtyRegions();
+  ASSERT_EQ(dirtyRegions.size(), rects.size());
+  for (size_t i = 0; i < rects.size(); i++) {
+    EXPECT_EQ(dirtyRegions[i], rects[i]);
+  }
+
+  for (auto& rect : rects) {
+    root->invalidateRect(rect);
+  }
+  displayList.setMaxDirtyRegions(2);
+  EXPECT_EQ(root->updateDirtyRegions().size(), 2u);
+  displayList.setMaxDirtyRegions(1000);
+  EXPECT_EQ(displayList.maxDirtyRegions(), 64);
+}
+
+TGFX_TEST(LayerTest, ParallelTileRecording) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto makeDisplayList = [](bool parallel) {
+    auto displayList = std::make_unique<DisplayList>();
+    displayList->setRenderMode(RenderMode::Tiled);
+    displayList->setTileSize(64);
+    displayList->setAllowParallelRecording(parallel);
+    for (int i = 0; i < 36; i++) {
+      auto layer = ShapeLayer::Make();
+      Path path = {};
+      path.addRoundRect(Rect::MakeWH(30, 30), 6, 6);
+      layer->setPath(path);
+      layer->setFillStyle(SolidColor::Make(Color::FromRGBA(0, 128, 255, 255)));
+      layer->setStrokeStyle(SolidColor::Make(Color::Black()));
+      layer->setLineWidth(2);
+      layer->setMatrix(Matrix::MakeTrans(static_cast<float>(i % 6) * 40.0f + 5.0f,
+                                         static_cast<float>(i / 6) * 40.0f + 5.0f));
+      if (i % 3 == 0) {
+        layer->setLayerStyles({DropShadowStyle::Make(3, 3, 2, 2, Color::Black())});
+      }
+      if (i % 5 == 0) {
+        layer->setFilters({BlurFilter::Make(2, 2)});
+      }
+      displayList->root()->addChild(layer);
+    }
+    return displayList;
+  };
+  auto info = ImageInfo::Make(250, 250, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  std::vector<uint8_t> expected(info.byteSize());
+  std::vector<uint8_t> actual(info.byteSize());
+  auto sequentialSurface = Surface::Make(context, info.width(), info.height());
+  auto sequentialList = makeDisplayList(false);
+  auto parallelSurface = Surface::Make(context, info.width(), info.height());
+  auto parallelList = makeDisplayList(true);
+  EXPECT_TRUE(parallelList->allowParallelRecording());
+  for (auto zoomScale : {1.0f, 1.5f}) {
+    sequentialList->setZoomScale(zoomScale);
+    sequentialList->render(sequentialSurface.get());
+    parallelList->setZoomScale(zoomScale);
+    parallelList->render(parallelSurface.get());
+    ASSERT_TRUE(sequentialSurface->readPixels(info, expected.data()));
+    ASSERT_TRUE(parallelSurface->readPixels(info, actual.data()));
+    EXPECT_TRUE(expected == actual);
+  }
+}
+
+TGFX_TEST(LayerTest, TilePrefetch) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 128, 128);
+  DisplayList displayList;
+  displayList.setRenderMode(RenderMode::Tiled);
+  displayList.setTileSize(64);
+  displayList.setMaxTileCount(100);
+  displayList.setPrefetchMargin(1);
+  displayList.setMaxTilesPrefetchedPerFrame(8);
+  auto layer = SolidLayer::Make();
+  layer->setWidth(1000);
+  layer->setHeight(1000);
+  layer->setColor(Color::Green());
+  displayList.root()->addChild(layer);
+  displayList.render(surface.get());
+  auto tileCache = displayList.tileCaches[displayList._zoomScaleInt];
+  ASSERT_TRUE(tileCache != nullptr);
+  // The visible area takes one task, the ring around it is filled within the budget.
+  EXPECT_TRUE(displayList.hasContentChanged());
+  displayList.render(surface.get());
+  EXPECT_FALSE(displayList.hasContentChanged());
+  for (int tileY = -1; tileY < 3; tileY++) {
+    for (int tileX = -1; tileX < 3; tileX++) {
+      EXPECT_TRUE(tileCache->getTile(tileX, tileY) != nullptr);
+    }
+  }
+  // While panning, only the tiles ahead of the viewport are prefetched.
+  displayList.setContentOffset(-128, 0);
+  displayList.render(surface.get());
+  EXPECT_TRUE(tileCache->getTile(4, 0) != nullptr);
+  EXPECT_TRUE(tileCache->getTile(4, 1) != nullptr);
+  EXPECT_TRUE(tileCache->getTile(4, -1) == nullptr);
+  EXPECT_TRUE(tileCache->getTile(4, 2) == nullptr);
+  displayList.setZoomScale(2.0f);
+  displayList.render(surface.get());
+  EXPECT_EQ(displayList.tileCaches[displayList._zoomScaleInt]->tileMap.size(), 4u);
+  // Without a budget, prefetching never keeps the display list busy.
+  displayList.setMaxTilesPrefetchedPerFrame(-1);
+  EXPECT_EQ(displayList.maxTilesPrefetchedPerFrame(), 0);
+  displayList.setContentOffset(0, 0);
+  for (int i = 0; i < 4 && displayList.hasContentChanged(); i++) {
+    displayList.render(surface.get());
+  }
+  EXPECT_FALSE(displayList.hasContentChanged());
+}
+
+TGFX_TEST(LayerTest, ScaledRasterizedCache) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 200);
+  DisplayList displayList;
+  auto layer = ShapeLayer::Make();
+  Path path = {};
+  path.addOval(Rect::MakeWH(40, 40));
+  layer->setPath(path);
+  layer->setFillStyle(SolidColor::Make(Color::Blue()));
+  layer->setShouldRasterize(true);
+  displayList.root()->addChild(layer);
+  displayList.render(surface.get());
+  ASSERT_TRUE(layer->rasterizedContent != nullptr);
+  EXPECT_EQ(layer->rasterizedContent->contentScale(), 1.0f);
+
+  // The first frames of a zoom reuse the closest version and request another frame.
+  displayList.setZoomScale(1.2f);
+  displayList.render(surface.get());
+  EXPECT_EQ(layer->rasterizedContent->contentScale(), 1.0f);
+  EXPECT_TRUE(layer->scaledRasterizedContents.empty());
+  EXPECT_FALSE(displayList.root()->bitFields.dirtyDescendents);
+  EXPECT_TRUE(displayList.hasContentChanged());
+  displayList.setZoomScale(3.0f);
+  displayList.render(surface.get());
+  ASSERT_EQ(layer->scaledRasterizedContents.size(), 1u);
+  EXPECT_EQ(layer->scaledRasterizedContents[0]->contentScale(), 4.0f);
+  displayList.setZoomScale(3.5f);
+  displayList.render(surface.get());
+  EXPECT_EQ(layer->scaledRasterizedContents.size(), 1u);
+  EXPECT_EQ(layer->rasterizedContent->contentScale(), 1.0f);
+
+  // Once the scale settles, the layer is rasterized at the exact scale.
+  displayList.render(surface.get());
+  EXPECT_EQ(layer->rasterizedContent->contentScale(), 3.5f);
+  EXPECT_EQ(layer->scaledRasterizedContents.size(), 1u);
+  displayList.render(surface.get());
+  EXPECT_FALSE(displayList.hasContentChanged());
+
+  layer->setFillStyle(SolidColor::Make(Color::Red()));
+  displayList.render(surface.get());
+  EXPECT_TRUE(layer->scaledRasterizedContents.empty());
+
+  // A layer drawn several times in one frame, e.g. once per tile, sees the same scale change in
+  // every draw and reports its bounds only once.
+  std::vector<Rect> scaledCacheBounds = {};
+  DrawArgs args(context);
+  args.scaledCacheBounds = &scaledCacheBounds;
+  args.renderFrame = 1000;
+  auto contentScale = layer->rasterizedContent->contentScale();
+  auto zoomMatrix = Matrix::MakeScale(contentScale * 1.5f);
+  EXPECT_NE(layer->getRasterizedCache(args, zoomMatrix), layer->rasterizedContent.get());
+  EXPECT_NE(layer->getRasterizedCache(args, zoomMatrix), layer->rasterizedContent.get());
+  EXPECT_EQ(layer->rasterizedContent->contentScale(), contentScale);
+  EXPECT_EQ(scaledCacheBounds.size(), 1u);
+  args.renderFrame = 1001;
+  EXPECT_EQ(layer->getRasterizedCache(args, zoomMatrix), layer->rasterizedContent.get());
+  EXPECT_EQ(layer->rasterizedContent->contentScale(), contentScale * 1.5f);
+  EXPECT_EQ(scaledCacheBounds.size(), 1u);
+}
+
+TGFX_TEST(LayerTest, LayerStyleSourceCache) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 300, 300);
+  DisplayList displayList;
+  displayList.setRenderMode(RenderMode::Direct);
+  auto background = SolidLayer::Make();
+  background->setWidth(100);
+  background->setHeight(100);
+  background->setColor(Color::Blue());
+  displayList.root()->addChild(background);
+  auto parent = Layer::Make();
+  parent->setLayerStyles({DropShadowStyle::Make(5, 5, 2, 2, Color::Black())});
+  displayList.root()->addChild(parent);
+  auto child = ShapeLayer::Make();
+  Path path = {};
+  path.addRect(Rect::MakeXYWH(10, 10, 40, 40));
+  child->setPath(path);
+  child->setFillStyle(SolidColor::Make(Color::FromRGBA(255, 0, 0, 128)));
+  child->setLayerStyles({BackgroundBlurStyle::Make(5, 5)});
+  parent->addChild(child);
+  displayList.render(surface.get());
+  ASSERT_TRUE(parent->sourceCache != nullptr);
+  ASSERT_TRUE(child->sourceCache != nullptr);
+  auto styleSource = parent->sourceCache->styleSource;
+  auto backgroundImage = child->sourceCache->background;
+  EXPECT_TRUE(styleSource != nullptr);
+  EXPECT_TRUE(backgroundImage != nullptr);
+
+  // Changes elsewhere keep the recorded sources.
+  auto other = SolidLayer::Make();
+  other->setWidth(10);
+  other->setHeight(10);
+  other->setMatrix(Matrix::MakeTrans(250, 250));
+  displayList.root()->addChild(other);
+  displayList.render(surface.get());
+  ASSERT_TRUE(parent->sourceCache != nullptr);
+  EXPECT_TRUE(parent->sourceCache->styleSource == styleSource);
+  // Reused sources are rasterized, so the style filters can cache their outputs by the image key.
+  EXPECT_EQ(Types::Get(styleSource->content.get()), Types::ImageType::Rasterized);
+
+  // Changing what lies below the blur invalidates the background and the sources containing it.
+  background->setColor(Color::Green());
+  EXPECT_TRUE(parent->sourceCache != nullptr);
+  displayList.render(surface.get());
+  ASSERT_TRUE(parent->sourceCache != nullptr);
+  EXPECT_TRUE(parent->sourceCache->styleSource != styleSource);
+  ASSERT_TRUE(child->sourceCache != nullptr);
+  EXPECT_TRUE(child->sourceCache->background != backgroundImage);
+}
+
+TGFX_TEST(LayerTest, ShapeLayerStrokeStages) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  DisplayList displayList;
+  auto layer = ShapeLayer::Make();
+  Path path = {};
+  path.addRoundRect(Rect::MakeXYWH(10, 10, 80, 80), 10, 10);
+  layer->setPath(path);
+  layer->setFillStyle(SolidColor::Make(Color::White()));
+  auto strokeColor = SolidColor::Make(Color::Red());
+  layer->setStrokeStyle(strokeColor);
+  layer->setLineWidth(4);
+  layer->setLineDashPattern({6, 3});
+  layer->setStrokeEnd(0.8f);
+  layer->setStrokeAlign(StrokeAlign::Outside);
+  displayList.root()->addChild(layer);
+  displayList.render(surface.get());
+  auto trimmedShape = layer->trimmedShape;
+  auto dashedShape = layer->dashedShape;
+  auto strokedShape = layer->strokedShape;
+  ASSERT_TRUE(strokedShape != nullptr);
+
+  // Changing the paints only reuses the whole stroke shape.
+  strokeColor->setColor(Color::Blue());
+  displayList.render(surface.get());
+  EXPECT_TRUE(layer->strokedShape == strokedShape);
+
+  // Later stages are rebuilt from the cached earlier ones.
+  layer->setLineWidth(6);
+  displayList.render(surface.get());
+  EXPECT_TRUE(layer->trimmedShape == trimmedShape);
+  EXPECT_TRUE(layer->dashedShape == dashedShape);
+  EXPECT_TRUE(layer->strokedShape != strokedShape);
+  strokedShape = layer->strokedShape;
+
+  layer->setLineDashPhase(2);
+  displayList.render(surface.get());
+  EXPECT_TRUE(layer->trimmedShape == trimmedShape);
+  EXPECT_TRUE(layer->dashedShape != dashedShape);
+  EXPECT_TRUE(layer->strokedShape != strokedShape);
+
+  layer->setStrokeEnd(0.5f);
+  displayList.render(surface.get());
+  EXPECT_TRUE(layer->trimmedShape != trimmedShape);
+}
+
+TGFX_TEST(LayerTest, OcclusionCulling) {
+  auto root = RootLayer::Make();
+  auto bottom = SolidLayer::Make();
+  bottom->setWidth(50);
+  bottom->setHeight(50);
+  bottom->setColor(Color::Blue());
+  bottom->setPosition(Point::Make(20, 20));
+  root->addChild(bottom);
+  auto top = SolidLayer::Make();
+  top->setWidth(100);
+  top->setHeight(100);
+  top->setColor(Color::Red());
+  root->addChild(top);
+  EXPECT_FALSE(root->updateDirtyRegions(1.0f).empty());
+  EXPECT_TRUE(root->isOccluded(bottom.get()));
+  EXPECT_FALSE(root->isOccluded(top.get()));
+
+  // Changes hidden behind an unchanged opaque layer need no redrawing.
+  bottom->setColor(Color::Green());
+  EXPECT_TRUE(root->updateDirtyRegions(1.0f).empty());
+  bottom->setPosition(Point::Make(30, 30));
+  EXPECT_TRUE(root->updateDirtyRegions(1.0f).empty());
+  // Without an occlusion scale the pass is disabled.
+  bottom->setPosition(Point::Make(20, 20));
+  EXPECT_FALSE(root->updateDirtyRegions().empty());
+  EXPECT_FALSE(root->isOccluded(bottom.get()));
+
+  top->setAlpha(0.5f);
+  EXPECT_FALSE(root->updateDirtyRegions(1.0f).empty());
+  EXPECT_FALSE(root->isOccluded(bottom.get()));
+  top->setAlpha(1.0f);
+  top->setRadiusX(50);
+  top->setRadiusY(50);
+  EXPECT_FALSE(root->updateDirtyRegions(1.0f).empty());
+  EXPECT_TRUE(root->isOccluded(bottom.get()));
+  bottom->setPosition(Point::Make(5, 5));
+  EXPECT_FALSE(root->updateDirtyRegions(1.0f).empty());
+  EXPECT_FALSE(root->isOccluded(bottom.get()));
+
+  // Layers drawn above an occluder are never hidden by it.
+  root->setChildIndex(bottom, 1);
+  bottom->setPosition(Point::Make(30, 30));
+  EXPECT_FALSE(root->updateDirtyRegions(1.0f).empty());
+  EXPECT_FALSE(root->isOccluded(bottom.get()));
+  EXPECT_FALSE(root->isOccluded(top.get()));
+  // Without any change the pass of the last frame is kept.
+  auto lastOcclusionFrame = root->occlusionFrame;
+  EXPECT_TRUE(root->updateDirtyRegions(1.0f).empty());
+  EXPECT_EQ(root->occlusionFrame, lastOcclusionFrame);
+
+  // Images known to be opaque occlude the layers below them, and so do rasterized layers.
+  auto imageInfo = ImageInfo::Make(100, 100, ColorType::RGBA_8888, AlphaType::Opaque);
+  std::vector<uint8_t> imagePixels(imageInfo.byteSize(), 255);
+  auto imageLayer = ImageLayer::Make();
+  imageLayer->setImage(Image::MakeFrom(
+      imageInfo, Data::MakeWithCopy(imagePixels.data(), imagePixels.size())));
+  root->addChild(imageLayer);
+  EXPECT_FALSE(root->updateDirtyRegions(1.0f).empty());
+  EXPECT_TRUE(root->isOccluded(bottom.get()));
+  imageLayer->removeFromParent();
+  top->setShouldRasterize(true);
+  root->setChildIndex(top, 1);
+  EXPECT_FALSE(root->updateDirtyRegions(1.0f).empty());
+  EXPECT_TRUE(root->isOccluded(bottom.get()));
+  top->setShouldRasterize(false);
+
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  root->removeChildren();
+  DisplayList displayList;
+  displayList.root()->addChild(bottom);
+  displayList.root()->addChild(top);
+  displayList.render(surface.get());
+  auto displayRoot = static_cast<RootLayer*>(displayList.root());
+  EXPECT_TRUE(displayRoot->isOccluded(bottom.get()));
+  uint32_t pixel = 0;
+  auto info = ImageInfo::Make(1, 1, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  EXPECT_TRUE(surface->readPixels(info, &pixel, 50, 50));
+  EXPECT_EQ(pixel, 0xFF0000FFu);
+}
+
+TGFX_TEST(LayerTest, OcclusionUnderFilteredParent) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 120, 120);
+  DisplayList displayList;
+  auto parent = Layer::Make();
+  parent->setFilters({DropShadowFilter::Make(30, 30, 0, 0, Color::Black())});
+  displayList.root()->addChild(parent);
+  auto child = SolidLayer::Make();
+  child->setWidth(50);
+  child->setHeight(50);
+  child->setColor(Color::Blue());
+  child->setPosition(Point::Make(20, 20));
+  parent->addChild(child);
+  auto top = SolidLayer::Make();
+  top->setWidth(70);
+  top->setHeight(70);
+  top->setColor(Color::Red());
+  top->setPosition(Point::Make(10, 10));
+  displayList.root()->addChild(top);
+  displayList.render(surface.get());
+  // The top layer covers the child, but not the shadow the parent casts from it.
+  auto displayRoot = static_cast<RootLayer*>(displayList.root());
+  EXPECT_FALSE(displayRoot->isOccluded(parent.get()));
+  EXPECT_FALSE(displayRoot->isOccluded(child.get()));
+  uint32_t pixel = 0;
+  auto info = ImageInfo::Make(1, 1, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  EXPECT_TRUE(surface->readPixels(info, &pixel, 90, 90));
+  EXPECT_EQ(pixel, 0xFF000000u);
+  EXPECT_TRUE(surface->readPixels(info, &pixel, 50, 50));
+  EXPECT_EQ(pixel, 0xFF0000FFu);
+
+  // Changes of the child below the top layer still show up in the shadow.
+  child->setColor(Color::Green());
+  displayList.render(surface.get());
+  EXPECT_TRUE(surface->readPixels(info, &pixel, 90, 90));
+  EXPECT_EQ(pixel, 0xFF000000u);
+  child->setPosition(Point::Make(25, 25));
+  displayList.render(surface.get());
+  EXPECT_TRUE(surface->readPixels(info, &pixel, 97, 97));
+  EXPECT_EQ(pixel, 0xFF000000u);
+}
 }  // namespace tgfx
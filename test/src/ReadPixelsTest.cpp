@@ -19,9 +19,12 @@
 #include <vector>
 #include "gpu/opengl/GLUtil.h"
 #include "tgfx/core/Buffer.h"
+#include "tgfx/core/Canvas.h"
+#include "tgfx/core/Image.h"
 #include "tgfx/core/ImageCodec.h"
 #include "tgfx/core/Pixmap.h"
 #include "tgfx/core/Surface.h"
+#include "tgfx/core/WriteStream.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 #include "utils/TestUtils.h"
 
@@ -257,6 +260,71 @@ TGFX_TEST(ReadPixelsTest, Surface) {
   bitmap.unlockPixels();
 }
 
+TGFX_TEST(ReadPixelsTest, SurfaceAsync) {
+  auto image = MakeImage("resources/apitest/test_timestretch.png");
+  ASSERT_TRUE(image != nullptr);
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto width = image->width();
+  auto height = image->height();
+  auto RGBAInfo = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer expected(RGBAInfo.byteSize());
+  Buffer actual(RGBAInfo.byteSize());
+
+  GLTextureInfo textureInfo = {};
+  auto result = CreateGLTexture(context, width, height, &textureInfo);
+  EXPECT_TRUE(result);
+  std::vector<std::shared_ptr<Surface>> surfaces = {};
+  surfaces.push_back(Surface::Make(context, width, height));
+  surfaces.push_back(
+      Surface::MakeFrom(context, {textureInfo, width, height}, ImageOrigin::BottomLeft));
+  for (auto& surface : surfaces) {
+    ASSERT_TRUE(surface != nullptr);
+    auto canvas = surface->getCanvas();
+    canvas->clear();
+    canvas->drawImage(image);
+    auto readback = surface->readPixelsAsync(0, 0, width, height);
+    if (readback == nullptr) {
+      EXPECT_FALSE(GLCaps::Get(context)->asyncReadbackSupport);
+      continue;
+    }
+    EXPECT_EQ(readback->width(), width);
+    EXPECT_EQ(readback->height(), height);
+    // Draws on the surface after the readback was issued must not affect the result.
+    canvas->clear(Color::Red());
+    context->flushAndSubmit();
+    result = readback->readPixels(RGBAInfo, actual.data());
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(readback->isReady());
+    canvas->clear();
+    canvas->drawImage(image);
+    result = surface->readPixels(RGBAInfo, expected.data());
+    EXPECT_TRUE(result);
+    EXPECT_EQ(memcmp(expected.data(), actual.data(), RGBAInfo.byteSize()), 0);
+
+    auto partial = surface->readPixelsAsync(-100, -100, 200, 200);
+    ASSERT_TRUE(partial != nullptr);
+    EXPECT_EQ(partial->width(), 100);
+    EXPECT_EQ(partial->height(), 100);
+    EXPECT_TRUE(surface->readPixelsAsync(width, height, 10, 10) == nullptr);
+
+    std::vector<std::shared_ptr<PixelReadback>> readbacks = {};
+    for (int i = 0; i < 5; i++) {
+      readbacks.push_back(surface->readPixelsAsync(0, 0, width, height));
+    }
+    for (auto& pending : readbacks) {
+      ASSERT_TRUE(pending != nullptr);
+      actual.clear();
+      result = pending->readPixels(RGBAInfo, actual.data());
+      EXPECT_TRUE(result);
+      EXPECT_EQ(memcmp(expected.data(), actual.data(), RGBAInfo.byteSize()), 0);
+    }
+  }
+  auto gl = GLFunctions::Get(context);
+  gl->deleteTextures(1, &textureInfo.id);
+}
+
 TGFX_TEST(ReadPixelsTest, PngCodec) {
   auto rgbaCodec = MakeImageCodec("resources/apitest/imageReplacement.png");
   ASSERT_TRUE(rgbaCodec != nullptr);
@@ -438,6 +506,127 @@ TGFX_TEST(ReadPixelsTest, JpegCodec) {
   CHECK_PIXELS(RGB565Info, pixels, "JpegCodec_Encode_RGB565");
 }
 
+TGFX_TEST(ReadPixelsTest, EncodeBatch) {
+  auto rgbaCodec = MakeImageCodec("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(rgbaCodec != nullptr);
+  auto RGBAInfo = ImageInfo::Make(rgbaCodec->width(), rgbaCodec->height(), ColorType::RGBA_8888,
+                                  AlphaType::Premultiplied);
+  Buffer buffer(RGBAInfo.byteSize());
+  ASSERT_TRUE(buffer.data());
+  EXPECT_TRUE(rgbaCodec->readPixels(RGBAInfo, buffer.data()));
+  auto A8Info = ImageInfo::Make(rgbaCodec->width(), rgbaCodec->height(), ColorType::ALPHA_8,
+                                AlphaType::Premultiplied);
+  Buffer alphaBuffer(A8Info.byteSize());
+  ASSERT_TRUE(alphaBuffer.data());
+  EXPECT_TRUE(rgbaCodec->readPixels(A8Info, alphaBuffer.data()));
+  std::vector<Pixmap> pixmaps = {Pixmap(RGBAInfo, buffer.data()),
+                                 Pixmap(A8Info, alphaBuffer.data()),
+                                 Pixmap(RGBAInfo, buffer.data())};
+  EncodeOptions options = {};
+  options.quality = 80;
+  options.webpMethod = 0;
+  options.pngCompressionLevel = 1;
+  options.pngFilter = PNGFilter::Sub;
+  options.jpegFastDCT = true;
+  for (auto format : {EncodedFormat::PNG, EncodedFormat::JPEG, EncodedFormat::WEBP}) {
+    auto results = ImageCodec::Encode(pixmaps, format, options);
+    ASSERT_EQ(results.size(), pixmaps.size());
+    for (size_t i = 0; i < pixmaps.size(); i++) {
+      auto expected = ImageCodec::Encode(pixmaps[i], format, options);
+      ASSERT_TRUE(expected != nullptr);
+      ASSERT_TRUE(results[i] != nullptr);
+      ASSERT_EQ(results[i]->size(), expected->size());
+      EXPECT_EQ(memcmp(results[i]->data(), expected->data(), expected->size()), 0);
+      auto codec = ImageCodec::MakeFrom(results[i]);
+      ASSERT_TRUE(codec != nullptr);
+      EXPECT_EQ(codec->width(), pixmaps[i].width());
+      EXPECT_EQ(codec->height(), pixmaps[i].height());
+    }
+    auto stream = MemoryWriteStream::Make();
+    EXPECT_TRUE(ImageCodec::Encode(pixmaps[0], format, options, stream.get()));
+    auto streamData = stream->readData();
+    ASSERT_EQ(streamData->size(), results[0]->size());
+    EXPECT_EQ(memcmp(streamData->data(), results[0]->data(), streamData->size()), 0);
+  }
+}
+
+TGFX_TEST(ReadPixelsTest, KTX2Codec) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto info = ImageInfo::Make(30, 18, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer buffer(info.byteSize());
+  ASSERT_TRUE(buffer.data());
+  auto pixels = static_cast<uint8_t*>(buffer.data());
+  for (size_t i = 0; i < buffer.size(); i += 4) {
+    pixels[i] = 200;
+    pixels[i + 1] = 100;
+    pixels[i + 2] = 50;
+    pixels[i + 3] = 255;
+  }
+  auto data = ImageCodec::Encode(Pixmap(info, pixels), EncodedFormat::KTX2, 100);
+  ASSERT_TRUE(data != nullptr);
+  auto image = Image::MakeFromEncoded(data);
+  ASSERT_TRUE(image != nullptr);
+  EXPECT_EQ(image->width(), 30);
+  EXPECT_EQ(image->height(), 18);
+  if (!context->caps()->isCompressedFormatSupported(PixelFormat::ETC2_RGB8)) {
+    return;
+  }
+  auto surface = Surface::Make(context, image->width(), image->height());
+  ASSERT_TRUE(surface != nullptr);
+  surface->getCanvas()->drawImage(image);
+  Buffer result(info.byteSize());
+  ASSERT_TRUE(result.data());
+  ASSERT_TRUE(surface->readPixels(info, result.data()));
+  auto resultPixels = static_cast<const uint8_t*>(result.data());
+  for (size_t i = 0; i < result.size(); i++) {
+    // A solid color is only affected by the 5-bit base color quantization of ETC2.
+    EXPECT_NEAR(resultPixels[i], pixels[i], 8);
+  }
+}
+
+TGFX_TEST(ReadPixelsTest, KTX2CodecAlpha) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto info = ImageInfo::Make(20, 12, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer buffer(info.byteSize());
+  ASSERT_TRUE(buffer.data());
+  auto pixels = static_cast<uint8_t*>(buffer.data());
+  for (size_t i = 0; i < buffer.size(); i += 4) {
+    pixels[i] = 100;
+    pixels[i + 1] = 50;
+    pixels[i + 2] = 25;
+    pixels[i + 3] = 128;
+  }
+  auto data = ImageCodec::Encode(Pixmap(info, pixels), EncodedFormat::KTX2, 100);
+  ASSERT_TRUE(data != nullptr);
+  auto image = Image::MakeFromEncoded(data);
+  ASSERT_TRUE(image != nullptr);
+  // A level count beyond the full mipmap chain is rejected.
+  Buffer corrupted(data->size());
+  ASSERT_TRUE(corrupted.data());
+  memcpy(corrupted.data(), data->data(), data->size());
+  uint32_t levelCount = 40;
+  memcpy(corrupted.bytes() + 40, &levelCount, sizeof(levelCount));
+  EXPECT_TRUE(Image::MakeFromEncoded(corrupted.release()) == nullptr);
+  if (!context->caps()->isCompressedFormatSupported(PixelFormat::ETC2_RGBA8)) {
+    return;
+  }
+  auto surface = Surface::Make(context, image->width(), image->height());
+  ASSERT_TRUE(surface != nullptr);
+  surface->getCanvas()->drawImage(image);
+  Buffer result(info.byteSize());
+  ASSERT_TRUE(result.data());
+  ASSERT_TRUE(surface->readPixels(info, result.data()));
+  auto resultPixels = static_cast<const uint8_t*>(result.data());
+  for (size_t i = 0; i < result.size(); i++) {
+    // The alpha channel is stored in an EAC block next to the color block.
+    EXPECT_NEAR(resultPixels[i], pixels[i], 8);
+  }
+}
+
 TGFX_TEST(ReadPixelsTest, NativeCodec) {
   auto rgbaCodec = MakeNativeCodec("resources/apitest/imageReplacement.png");
   ASSERT_TRUE(rgbaCodec != nullptr);
@@ -17,12 +17,18 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <array>
+#include <atomic>
 #include <utility>
+#include <vector>
+#include "core/ImageBufferCache.h"
 #include "core/utils/BlockBuffer.h"
 #include "core/utils/UniqueID.h"
 #include "gpu/RectsVertexProvider.h"
 #include "gpu/Resource.h"
+#include "gpu/Texture.h"
+#include "tgfx/core/Bitmap.h"
 #include "tgfx/core/Rect.h"
+#include "tgfx/core/Surface.h"
 #include "tgfx/core/Task.h"
 #include "utils/TestUtils.h"
 
@@ -65,7 +71,96 @@ TGFX_TEST(ResourceCacheTest, multiThreadRecycling) {
   });
 };
 
+TGFX_TEST(ResourceCacheTest, yuvTextureRecycling) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  constexpr int width = 64;
+  constexpr int height = 32;
+  std::vector<uint8_t> pixels(width * height * 3 / 2, 128);
+  const void* data[3] = {pixels.data(), pixels.data() + width * height,
+                         pixels.data() + width * height * 5 / 4};
+  size_t rowBytes[3] = {width, width / 2, width / 2};
+  auto yuvData = YUVData::MakeFrom(width, height, data, rowBytes, YUVData::I420_PLANE_COUNT);
+  ASSERT_TRUE(yuvData != nullptr);
+  auto texture = Texture::MakeI420(context, yuvData.get());
+  ASSERT_TRUE(texture != nullptr);
+  auto firstTexture = texture.get();
+  auto busyTexture = Texture::MakeI420(context, yuvData.get());
+  ASSERT_TRUE(busyTexture != nullptr);
+  EXPECT_NE(busyTexture.get(), firstTexture);
+  texture = nullptr;
+  texture = Texture::MakeI420(context, yuvData.get(), YUVColorSpace::BT709_FULL);
+  EXPECT_EQ(texture.get(), firstTexture);
+  EXPECT_TRUE(texture->isYUV());
+  size_t nv12RowBytes[2] = {width, width};
+  auto nv12Data =
+      YUVData::MakeFrom(width, height, data, nv12RowBytes, YUVData::NV12_PLANE_COUNT);
+  auto nv12Texture = Texture::MakeNV12(context, nv12Data.get());
+  ASSERT_TRUE(nv12Texture != nullptr);
+  EXPECT_NE(nv12Texture.get(), firstTexture);
+}
+
 #ifdef TGFX_USE_THREADS
+class CountingGenerator : public ImageGenerator {
+ public:
+  CountingGenerator(int width, int height) : ImageGenerator(width, height) {
+  }
+
+  bool isAlphaOnly() const override {
+    return false;
+  }
+
+  int decodeCount() const {
+    return _decodeCount;
+  }
+
+ protected:
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override {
+    _decodeCount++;
+    Bitmap bitmap(width(), height(), false, tryHardware);
+    bitmap.clear();
+    return bitmap.makeBuffer();
+  }
+
+ private:
+  mutable std::atomic_int _decodeCount = {0};
+};
+
+TGFX_TEST(ResourceCacheTest, decodedBufferCache) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 64, 64);
+  ASSERT_TRUE(surface != nullptr);
+  auto generator = std::make_shared<CountingGenerator>(64, 64);
+  auto image = Image::MakeFrom(generator);
+  ASSERT_TRUE(image != nullptr);
+  auto drawImage = [&] {
+    surface->getCanvas()->drawImage(image);
+    context->flushAndSubmit(true);
+    context->purgeResourcesUntilMemoryTo(0);
+  };
+  Image::SetDecodedCacheLimit(64 * 64 * 4);
+  drawImage();
+  EXPECT_EQ(generator->decodeCount(), 1);
+  EXPECT_EQ(ImageBufferCache::GetInstance()->getCacheBytes(), static_cast<size_t>(64 * 64 * 4));
+  drawImage();
+  EXPECT_EQ(generator->decodeCount(), 1);
+  Image::SetDecodedCacheLimit(0);
+  EXPECT_EQ(ImageBufferCache::GetInstance()->getCacheBytes(), 0u);
+  drawImage();
+  EXPECT_EQ(generator->decodeCount(), 2);
+  Image::SetDecodedCacheLimit(64 * 64 * 4);
+  drawImage();
+  EXPECT_EQ(generator->decodeCount(), 3);
+  EXPECT_EQ(ImageBufferCache::GetInstance()->getCacheBytes(), static_cast<size_t>(64 * 64 * 4));
+  // The cached buffer is released together with the last reference to the image's key.
+  image = nullptr;
+  EXPECT_EQ(ImageBufferCache::GetInstance()->getCacheBytes(), 0u);
+  Image::SetDecodedCacheLimit(0);
+}
+
 TGFX_TEST(ResourceCacheTest, blockBufferRefCount) {
   BlockBuffer blockBuffer;
   {
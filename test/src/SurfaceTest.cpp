@@ -19,6 +19,8 @@
 #include "gpu/RenderContext.h"
 #include "gpu/opengl/GLCaps.h"
 #include "gpu/opengl/GLUtil.h"
+#include "tgfx/core/Pixmap.h"
+#include "tgfx/core/RenderFlags.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 #include "utils/TestUtils.h"
 
@@ -76,4 +78,43 @@ TGFX_TEST(SurfaceTest, ImageSnapshot) {
   auto gl = GLFunctions::Get(context);
   gl->deleteTextures(1, &textureInfo.id);
 }
+
+TGFX_TEST(SurfaceTest, LinearColorSpace) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  if (!context->caps()->isFormatRenderable(PixelFormat::RGBA_16F)) {
+    return;
+  }
+  auto surface = Surface::Make(context, 100, 100, ColorType::RGBA_F16, 1, false,
+                               RenderFlags::LinearColorSpace);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::Black());
+  Paint paint = {};
+  paint.setColor(Color::FromRGBA(255, 255, 255, 128));
+  canvas->drawRect(Rect::MakeWH(50, 100), paint);
+  // Opaque colors come back unchanged after being linearized and encoded again.
+  paint.setColor(Color::FromRGBA(255, 0, 0));
+  canvas->drawRect(Rect::MakeXYWH(50, 0, 50, 100), paint);
+  auto color = surface->getColor(25, 50);
+  // Blending half white over black in the linear-light space results in about 188 in the sRGB
+  // space, instead of 128 when blending the encoded values.
+  EXPECT_NEAR(color.red, 188.0f / 255.0f, 2.0f / 255.0f);
+  EXPECT_NEAR(color.green, 188.0f / 255.0f, 2.0f / 255.0f);
+  EXPECT_NEAR(color.alpha, 1.0f, 1.0f / 255.0f);
+  color = surface->getColor(75, 50);
+  EXPECT_NEAR(color.red, 1.0f, 1.0f / 255.0f);
+  EXPECT_NEAR(color.green, 0.0f, 1.0f / 255.0f);
+  // Reading back half floats keeps the linear values.
+  uint16_t halfPixels[4] = {};
+  auto halfInfo = ImageInfo::Make(1, 1, ColorType::RGBA_F16);
+  ASSERT_TRUE(surface->readPixels(halfInfo, halfPixels, 25, 50));
+  uint8_t pixels[4] = {};
+  ASSERT_TRUE(Pixmap(halfInfo, halfPixels).readPixels(ImageInfo::Make(1, 1, ColorType::RGBA_8888),
+                                                      pixels));
+  EXPECT_NEAR(pixels[0], 128, 2);
+  // Snapshots would be linearized again when drawn, so they are not supported.
+  EXPECT_TRUE(surface->makeImageSnapshot() == nullptr);
+}
 }  // namespace tgfx